@@ -544,6 +544,7 @@ MainWindow::MainWindow(raco::application::RaCoApplication* racoApplication, raco
 		dialog->resize(500, 500);
 		dialog->exec();
 		racoApplication_->setApplicationFeatureLevel(raco::components::RaCoPreferences::instance().featureLevel);
+		convertEditorAnimation_->setKeyReduceTolerance(raco::components::RaCoPreferences::instance().animationKeyReduceTolerance);
 	});
 
     // init logic
@@ -807,6 +808,10 @@ void MainWindow::initLogic() {
     materialLogic_ = new raco::material_logic::MateralLogic(this);
 
     convertEditorAnimation_ = new ConvertEditorAnimation(racoApplication_->activeRaCoProject().commandInterface(), this);
+    convertEditorAnimation_->setKeyReduceTolerance(raco::components::RaCoPreferences::instance().animationKeyReduceTolerance);
+    QObject::connect(convertEditorAnimation_, &ConvertEditorAnimation::sigKeysReduced, this, [this](QString animation, qulonglong removedKeys, qulonglong importedKeys, double tolerance) {
+        ui->statusBar->showMessage(QString("Animation '%1': %2 of %3 keys removed within tolerance %4").arg(animation).arg(removedKeys).arg(importedKeys).arg(tolerance), 10000);
+    });
 }
 
 void MainWindow::updateApplicationTitle() {
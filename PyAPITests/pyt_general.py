@@ -10,6 +10,7 @@
 import unittest
 import raco
 import os
+import array
 
 class GeneralTests(unittest.TestCase):
     def setUp(self):
@@ -1200,3 +1201,57 @@ class GeneralTests(unittest.TestCase):
         # Ramses Logic rejects ByteCodeOnly
         with self.assertRaises(RuntimeError):
             self.export("lua_ByteCodeOnly_FL1", raco.ELuaSavingMode.ByteCodeOnly)
+
+    def test_batch(self):
+        with raco.batch("create nodes"):
+            nodes = [raco.create("Node", "node{}".format(index)) for index in range(10)]
+            for node in nodes:
+                node.translation.x = 1.0
+        self.assertEqual(len(raco.instances()), 11)
+        self.assertEqual(nodes[9].translation.x.value(), 1.0)
+
+    def test_batch_nested(self):
+        with raco.batch():
+            node = raco.create("Node", "my_node")
+            with raco.batch():
+                node.translation.x = 2.0
+            node.translation.y = 3.0
+        self.assertEqual(node.translation.x.value(), 2.0)
+        self.assertEqual(node.translation.y.value(), 3.0)
+
+    def test_batch_exception_reverts_changes(self):
+        node = raco.create("Node", "my_node")
+        with self.assertRaises(RuntimeError):
+            with raco.batch():
+                node.translation.x = 3.0
+                raco.create("Node", "other_node")
+                raise RuntimeError("abort batch")
+        self.assertEqual(node.translation.x.value(), 0.0)
+        self.assertEqual(len(raco.instances()), 2)
+
+    def test_batch_project_switch_fail(self):
+        with raco.batch():
+            with self.assertRaises(RuntimeError):
+                raco.reset()
+
+    def test_bulk_values(self):
+        nodes = [raco.create("Node", "node{}".format(index)) for index in range(3)]
+        raco.setValues(nodes, "translation", array.array('d', range(9)))
+        self.assertEqual(nodes[1].translation.y.value(), 4.0)
+
+        values = memoryview(raco.getValues(nodes, "translation"))
+        self.assertEqual(values.shape, (3, 3))
+        self.assertEqual(values.tolist()[2], [6.0, 7.0, 8.0])
+        self.assertEqual(memoryview(raco.getValues(nodes, "translation.z")).tolist(), [2.0, 5.0, 8.0])
+
+        nodes[0].scaling.setValues(array.array('i', [2, 3, 4]))
+        self.assertEqual(memoryview(nodes[0].scaling.values()).tolist(), [2.0, 3.0, 4.0])
+
+    def test_bulk_values_fail(self):
+        nodes = [raco.create("Node", "node{}".format(index)) for index in range(3)]
+        with self.assertRaises(RuntimeError):
+            raco.setValues(nodes, "translation", array.array('d', [1.0]))
+        with self.assertRaises(RuntimeError):
+            raco.getValues(nodes, "objectName")
+        with self.assertRaises(RuntimeError):
+            raco.getValues(nodes, "no_such_property")
@@ -109,6 +109,11 @@ public:
 	raco::core::ExternalProjectsStoreInterface* externalProjects();
 	raco::core::MeshCache* meshCache();
 
+	// Load mesh files in the background, the meshes are picked up by doOneLoop when they are ready.
+	// Enabled when running in the UI. Switching it off waits for the pending loads.
+	void setAsyncMeshLoading(bool async);
+	bool asyncMeshLoading() const;
+
 	const core::SceneBackendInterface* sceneBackend() const;
 
 	raco::ramses_adaptor::SceneBackend* sceneBackendImpl() const;
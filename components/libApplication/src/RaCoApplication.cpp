@@ -27,6 +27,8 @@
 #include "core/Handles.h"
 #include <ramses_base/LogicEngineFormatter.h>
 
+#include <algorithm>
+
 #ifdef OS_WINDOWS
 // see: https://doc.qt.io/qt-5/qfileinfo.html#ntfs-permissions
 extern Q_CORE_EXPORT int qt_ntfs_permission_lookup;
@@ -63,6 +65,12 @@ RaCoApplication::RaCoApplication(ramses_base::BaseEngineBackend& engine, const R
 	raco::components::RaCoPreferences::init();
 
 	runningInUI_ = settings.runningInUI;
+	// Keep the UI responsive while large mesh files are loaded. Headless runs need the meshes immediately.
+	meshCache_.setAsyncLoading(runningInUI_);
+	if (runningInUI_) {
+		auto sizeLimit = static_cast<uint64_t>(std::max(raco::components::RaCoPreferences::instance().meshCacheSize, 0)) * 1024 * 1024;
+		meshCache_.setDiskCacheDirectory(core::PathManager::meshCacheDirectory().string(), sizeLimit);
+	}
 
 	switchActiveRaCoProject(settings.initialProject, {}, settings.createDefaultScene, settings.featureLevel);
 }
@@ -169,6 +177,7 @@ bool RaCoApplication::saveAsWithNewIDs(const QString& newPath, std::string& outE
 
 core::ErrorLevel RaCoApplication::getExportSceneDescriptionAndStatus(std::vector<core::SceneBackendInterface::SceneItemDesc>& outDescription, std::string& outMessage) {
 //    setupScene(true);
+    meshCache_.waitForPendingLoads();
     logicEngineNeedsUpdate_ = true;
     doOneLoop();
 
@@ -190,6 +199,7 @@ core::ErrorLevel RaCoApplication::getExportSceneDescriptionAndStatus(std::vector
 
 bool RaCoApplication::exportProject(const std::string& ramsesExport, const std::string& logicExport, bool compress, std::string& outError, bool forceExportWithErrors, ELuaSavingMode luaSavingMode) {
 //	setupScene(true);
+	meshCache_.waitForPendingLoads();
 	logicEngineNeedsUpdate_ = true;
 	doOneLoop();
 
@@ -277,6 +287,9 @@ void RaCoApplication::doOneLoop() {
 
 	activeProject_->tracePlayer().refresh(elapsedMsec);
 
+	// Meshes loaded in the background update their objects here, the adaptors get the changes below.
+	meshCache_.publishLoadedMeshes();
+
 	auto dataChanges = activeProject_->recorder()->release();
 	dataChangeDispatcherEngine_->dispatch(dataChanges);
 	if (logicEngineNeedsUpdate_ || !dataChanges.getAllChangedObjects(true, true, true).empty()) {
@@ -384,4 +397,16 @@ raco::core::MeshCache* RaCoApplication::meshCache() {
 	return &meshCache_;
 }
 
+void RaCoApplication::setAsyncMeshLoading(bool async) {
+	meshCache_.setAsyncLoading(async);
+	if (!async) {
+		// Objects updated by the pending loads need to reach the adaptors as well.
+		doOneLoop();
+	}
+}
+
+bool RaCoApplication::asyncMeshLoading() const {
+	return meshCache_.asyncLoading();
+}
+
 }  // namespace raco::application
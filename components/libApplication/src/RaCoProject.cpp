@@ -52,6 +52,7 @@
 #include <QTextStream>
 
 #include <algorithm>
+#include <chrono>
 #include <functional>
 
 
@@ -72,6 +73,7 @@ RaCoProject::RaCoProject(const QString& file, Project& p, EngineInterface* engin
 	  meshCache_{app->meshCache()} {
 	context_->setMeshCache(meshCache_);
 	context_->setExternalProjectsStore(externalProjectsStore);
+	undoStack_.setMemoryBudget(static_cast<size_t>(std::max(components::RaCoPreferences::instance().undoMemoryBudget, 0)) * 1024 * 1024);
 
 	// Abort file loading if we encounter external reference RenderPasses or extref cameras outside a Prefab.
 	// A bug in V0.9.0 allowed to create such projects.
@@ -318,6 +320,15 @@ std::unique_ptr<RaCoProject> RaCoProject::loadFromFile(const QString& filename,
 		throw std::runtime_error(fmt::format("Project file could not be read {}", absPath.toLatin1()));
 	}
 
+	// Per-phase timing, logged when loading has finished.
+	auto phaseStart = std::chrono::steady_clock::now();
+	auto finishPhase = [&phaseStart]() {
+		auto now = std::chrono::steady_clock::now();
+		auto milliseconds = std::chrono::duration<double, std::milli>(now - phaseStart).count();
+		phaseStart = now;
+		return milliseconds;
+	};
+
 	QFile file{absPath};
 	if (!file.open(QIODevice::ReadOnly)) {
 		throw std::runtime_error(fmt::format("Error opening file {}", absPath.toLatin1()));
@@ -339,11 +350,13 @@ std::unique_ptr<RaCoProject> RaCoProject::loadFromFile(const QString& filename,
 			throw std::runtime_error(fmt::format("Can't read zipped file {}:\n{}", absPath.toLatin1(), unzippedProj.payload));
 		}
 	}
+	auto readTime = finishPhase();
 
 	auto document{QJsonDocument::fromJson(fileContents)};
 	if (document.isNull()) {
 		throw std::runtime_error("Loading JSON file resulted in a null document object");
 	}
+	auto parseTime = finishPhase();
 
 	auto fileVersion{raco::serialization::deserializeFileVersion(document)};
 	if (fileVersion > raco::serialization::RAMSES_PROJECT_FILE_VERSION) {
@@ -354,7 +367,9 @@ std::unique_ptr<RaCoProject> RaCoProject::loadFromFile(const QString& filename,
 	}
 
 	auto result{raco::serialization::deserializeProject(document, absPath.toStdString())};
+	auto deserializationTime = finishPhase();
 
+	// Not parallelized: the handlers update the back pointers of the referenced objects.
 	for (const auto& instance : result.objects) {
 		instance->onAfterDeserialization();
 	}
@@ -363,6 +378,7 @@ std::unique_ptr<RaCoProject> RaCoProject::loadFromFile(const QString& filename,
 	if (generateNewObjectIDs) {
 		BaseContext::generateNewObjectIDs(result.objects);
 	}
+	auto afterDeserializationTime = finishPhase();
 
 	Project p{result.objects};
 	p.setCurrentPath(absPath.toStdString());
@@ -391,6 +407,7 @@ std::unique_ptr<RaCoProject> RaCoProject::loadFromFile(const QString& filename,
 	}
 
 	Consistency::checkProjectSettings(p);
+	auto projectSetupTime = finishPhase();
 
 	auto newProject = new RaCoProject{
 		absPath,
@@ -400,6 +417,7 @@ std::unique_ptr<RaCoProject> RaCoProject::loadFromFile(const QString& filename,
 		app->externalProjects(),
 		app,
 		loadContext};
+	auto contextSetupTime = finishPhase();
 
 	for (const auto& [objectID, infoMessage] : result.migrationObjWarnings) {
 		if (const auto migratedObj = newProject->project()->getInstanceByID(objectID)) {
@@ -414,6 +432,8 @@ std::unique_ptr<RaCoProject> RaCoProject::loadFromFile(const QString& filename,
 		newProject->errors()->logAllErrors();
 	}
 
+	LOG_INFO(raco::log_system::PROJECT, "Load timing: read {:.1f} ms, parse {:.1f} ms, deserialize {:.1f} ms, after deserialization {:.1f} ms, project setup {:.1f} ms, context setup {:.1f} ms",
+		readTime, parseTime, deserializationTime, afterDeserializationTime, projectSetupTime, contextSetupTime);
 	LOG_INFO(raco::log_system::PROJECT, "Finished loading project from {}", absPath.toLatin1());
 
 	return std::unique_ptr<RaCoProject>(newProject);
@@ -11,6 +11,8 @@
 
 #include "core/Context.h"
 
+#include <array>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <vector>
@@ -78,6 +80,15 @@ public:
 	using BulkChangeCallback = std::function<void(const core::SEditorObjectSet&)>;
 	using LinkCallback = std::function<void(const core::LinkDescriptor&)>;
 
+	struct DispatchStatistics {
+		// Number of dispatch() calls by duration: bucket 0 counts calls taking less than a microsecond,
+		// bucket i calls taking [2^(i-1), 2^i) microseconds. The last bucket also counts all longer calls.
+		std::array<uint64_t, 24> durationHistogram{};
+		uint64_t dispatches = 0;
+		std::chrono::microseconds totalDuration{0};
+		std::chrono::microseconds maxDuration{0};
+	};
+
 	explicit DataChangeDispatcher();
 
 	Subscription registerOn(core::ValueHandle valueHandle, Callback callback) noexcept;
@@ -134,6 +145,9 @@ public:
 
 	void assertEmpty();
 
+	const DispatchStatistics& dispatchStatistics() const;
+	void resetDispatchStatistics();
+
 	void setUndoChanged() {
 		undoChanged_ = true;
 	}
@@ -159,8 +173,10 @@ private:
 	std::map<std::string, std::set<std::weak_ptr<LinkLifecycleListener>, std::owner_less<std::weak_ptr<LinkLifecycleListener>>>> linkLifecycleListenersForEnd_{};
 	std::map<std::string, std::set<std::weak_ptr<LinkLifecycleListener>, std::owner_less<std::weak_ptr<LinkLifecycleListener>>>> linkLifecycleListenersForStart_{};
 	std::set<std::weak_ptr<LinkListener>, std::owner_less<std::weak_ptr<LinkListener>>> linkValidityChangeListeners_{};
-	std::map<std::string, std::set<std::weak_ptr<ValueHandleListener>, std::owner_less<std::weak_ptr<ValueHandleListener>>>> listeners_{};
-	std::map<std::string, std::set<std::weak_ptr<ChildrenListener>, std::owner_less<std::weak_ptr<ChildrenListener>>>> childrenListeners_{};
+	// Listeners keyed by the handle they are registered on. Handles are ordered by object and index path, so the
+	// listeners for a changed value and all of its parents are found by one lookup per path prefix.
+	std::map<core::ValueHandle, std::set<std::weak_ptr<ValueHandleListener>, std::owner_less<std::weak_ptr<ValueHandleListener>>>> listeners_{};
+	std::map<core::ValueHandle, std::set<std::weak_ptr<ChildrenListener>, std::owner_less<std::weak_ptr<ChildrenListener>>>> childrenListeners_{};
 	std::set<std::weak_ptr<EditorObjectListener>, std::owner_less<std::weak_ptr<EditorObjectListener>>> previewDirtyListeners_{};
 	std::set<std::weak_ptr<ValueHandleListener>, std::owner_less<std::weak_ptr<ValueHandleListener>>> errorChangedListeners_{};
 	std::set<std::weak_ptr<UndoListener>, std::owner_less<std::weak_ptr<UndoListener>>> errorChangedInSceneListeners_{};
@@ -176,6 +192,8 @@ private:
 	std::set<std::weak_ptr<UndoListener>, std::owner_less<std::weak_ptr<UndoListener>>> onAfterDispatchListeners_{};
 
 	BulkChangeCallback bulkChangeCallback_;
+
+	DispatchStatistics dispatchStatistics_;
 };
 
 using SDataChangeDispatcher = std::shared_ptr<DataChangeDispatcher>;
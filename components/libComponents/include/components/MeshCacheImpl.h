@@ -12,22 +12,51 @@
 #include "components/FileChangeMonitorImpl.h"
 #include "core/MeshCacheInterface.h"
 
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_set>
+#include <vector>
 
 namespace raco::core {
 class BaseContext;
 }  // namespace raco::core
 
+namespace raco::mesh_loader {
+class MeshDiskCache;
+}  // namespace raco::mesh_loader
+
 namespace raco::components {
 
 class MeshCacheImpl : public GenericFileChangeMonitorImpl<core::MeshCache> {
 public:
 	MeshCacheImpl() {}
+	~MeshCacheImpl() override;
+
+	// In asynchronous mode files are parsed and converted on a pool of worker threads. loadMesh returns nullptr
+	// while the file is still loading; finished files are handed over by publishLoadedMeshes which then
+	// notifies the file change handlers of the path like a modified file would.
+	void setAsyncLoading(bool async);
+	bool asyncLoading() const;
+
+	// Keep converted meshes in the given directory and reuse them as long as the source files don't change.
+	// An empty directory disables the disk cache. With a size limit (in bytes, 0 is unlimited) the least recently
+	// used meshes are removed from the directory.
+	void setDiskCacheDirectory(const std::string& directory, uint64_t sizeLimit = 0);
+
+	// Hand finished loads over to the cache and notify their handlers. Must be called on the thread using the cache.
+	void publishLoadedMeshes();
+	// Block until all pending loads are finished and publish them.
+	void waitForPendingLoads();
 
 	core::SharedMeshData loadMesh(const raco::core::MeshDescriptor& descriptor) override;
+	bool isMeshLoading(const std::string& absPath) override;
 	const core::MeshScenegraph* getMeshScenegraph(const std::string& absPath) override;
 	std::string getMeshError(const std::string& absPath) override;
 	int getTotalMeshCount(const std::string& absPath) override;
@@ -45,10 +74,56 @@ private:
 
     core::MeshCacheEntry* getWriter(std::string absPath) override;
 
+	struct LoadJob {
+		std::string absPath;
+		// Fixed once a worker has started the job.
+		std::vector<core::MeshDescriptor> descriptors;
+		core::UniqueMeshCacheEntry loader;
+		std::vector<core::SharedMeshData> meshes;
+		std::shared_ptr<const mesh_loader::MeshDiskCache> diskCache;
+		std::string sourceHash;
+		int totalMeshCount{-1};
+		std::chrono::steady_clock::time_point requestTime;
+		std::chrono::steady_clock::duration loadTime{};
+		bool started{false};
+		bool finished{false};
+	};
+
 	void forceReloadCachedMesh(const std::string& absPath);
 	void onAfterMeshFileUpdate(const std::string& meshFileAbsPath);
 
+	core::SharedMeshData findLoadedMesh(const core::MeshDescriptor& descriptor) const;
+	const std::string& sourceHash(const std::string& absPath);
+	void forgetFile(const std::string& absPath);
+	void requestLoad(const core::MeshDescriptor& descriptor);
+	void finishLoad(const std::string& absPath);
+	void cancelLoad(const std::string& absPath);
+	void publishLoad(LoadJob& job);
+	static void runLoad(LoadJob& job);
+	void workerLoop();
+	void stopWorkers();
+
     std::unordered_map<std::string, core::UniqueMeshCacheEntry> meshCacheEntries_;
+	// Meshes converted by the workers, kept until the file changes or is not used anymore.
+	std::unordered_map<std::string, std::vector<std::pair<core::MeshDescriptor, core::SharedMeshData>>> loadedMeshes_;
+
+	std::shared_ptr<const mesh_loader::MeshDiskCache> diskCache_;
+	std::unordered_map<std::string, std::string> sourceHashes_;
+	// Mesh counts of files whose meshes came from the disk cache, so that the file doesn't need to be parsed for them.
+	std::unordered_map<std::string, int> meshCounts_;
+
+	bool asyncLoading_{false};
+	// Pending loads by path, only accessed by the thread using the cache. The job state itself is guarded by mutex_.
+	std::unordered_map<std::string, std::shared_ptr<LoadJob>> loadJobs_;
+	// Paths published outside of publishLoadedMeshes whose handlers still have to be notified.
+	std::unordered_set<std::string> publishedPaths_;
+
+	std::mutex mutex_;
+	std::condition_variable queueCondition_;
+	std::condition_variable doneCondition_;
+	std::deque<std::shared_ptr<LoadJob>> queue_;
+	std::vector<std::thread> workers_;
+	bool stopWorkers_{false};
 };
 
 }  // namespace raco::components
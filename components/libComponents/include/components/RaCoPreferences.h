@@ -39,6 +39,15 @@ public:
 	QString shaderSubdirectory;
 
 	int featureLevel;
+
+	// Memory budget of the undo stack of a project in MiB, 0 means unlimited
+	int undoMemoryBudget;
+
+	// Size limit of the converted mesh cache on disk in MiB, 0 means unlimited
+	int meshCacheSize;
+
+	// Keys of imported glTF animations are reduced within this tolerance in value units, 0 keeps every key
+	double animationKeyReduceTolerance;
 };
 
 }  // namespace raco
@@ -166,6 +166,8 @@ Subscription::~Subscription() {
 DataChangeDispatcher::DataChangeDispatcher() {}
 
 void DataChangeDispatcher::dispatch(const DataChangeRecorder& dataChanges) {
+	auto startTime = std::chrono::steady_clock::now();
+
 	// Sync with and reset change recorder:
 
 	emitLinksValidityChanged(dataChanges.getValidityChangedLinks());
@@ -234,18 +236,35 @@ void DataChangeDispatcher::dispatch(const DataChangeRecorder& dataChanges) {
 			listener.lock()->call();
 		}
 	}
+
+	auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+	size_t bucket = 0;
+	for (auto count = duration.count(); count > 0 && bucket + 1 < dispatchStatistics_.durationHistogram.size(); count >>= 1) {
+		++bucket;
+	}
+	++dispatchStatistics_.durationHistogram[bucket];
+	++dispatchStatistics_.dispatches;
+	dispatchStatistics_.totalDuration += duration;
+	dispatchStatistics_.maxDuration = std::max(dispatchStatistics_.maxDuration, duration);
+}
+
+const DataChangeDispatcher::DispatchStatistics& DataChangeDispatcher::dispatchStatistics() const {
+	return dispatchStatistics_;
+}
+
+void DataChangeDispatcher::resetDispatchStatistics() {
+	dispatchStatistics_ = DispatchStatistics{};
 }
 
 Subscription DataChangeDispatcher::registerOn(ValueHandle valueHandle, Callback callback) noexcept {
 	auto listener{std::make_shared<ValueHandleListener>(std::move(valueHandle), std::move(callback))};
-	listeners_[listener->valueHandle().rootObject()->objectID()].insert(listener);
+	listeners_[listener->valueHandle()].insert(listener);
 	return Subscription{
 		this, listener, [this, listener]() {
-			const auto& objectID = listener->valueHandle().rootObject()->objectID();
-			auto it = listeners_.find(objectID);
+			auto it = listeners_.find(listener->valueHandle());
 			it->second.erase(listener);
 			if (it->second.empty()) {
-				listeners_.erase(objectID);
+				listeners_.erase(it);
 			}
 		}};
 }
@@ -274,14 +293,13 @@ Subscription DataChangeDispatcher::registerOnPropertyChange(const std::string& p
 
 Subscription DataChangeDispatcher::registerOnChildren(ValueHandle valueHandle, ValueHandleCallback callback) noexcept {
 	auto listener{std::make_shared<ChildrenListener>(std::move(valueHandle), std::move(callback))};
-	childrenListeners_[listener->valueHandle().rootObject()->objectID()].insert(listener);
+	childrenListeners_[listener->valueHandle()].insert(listener);
 	return Subscription{
 		this, listener, [this, listener]() {
-			const auto& objectID = listener->valueHandle().rootObject()->objectID();
-			auto it = childrenListeners_.find(objectID);
+			auto it = childrenListeners_.find(listener->valueHandle());
 			it->second.erase(listener);
 			if (it->second.empty()) {
-				childrenListeners_.erase(objectID);
+				childrenListeners_.erase(it);
 			}
 		}};
 }
@@ -409,30 +427,31 @@ void DataChangeDispatcher::resetBulkChangeCallback() {
 
 void DataChangeDispatcher::emitUpdateFor(const std::map<std::string, std::set<core::ValueHandle>>& valueHandles) const {
 	decltype(listeners_)::mapped_type dirtyListeners;
+	// Callbacks may register or deregister listeners: call them from copies.
+	std::vector<std::weak_ptr<ChildrenListener>> dirtyChildrenListeners;
+	std::vector<std::weak_ptr<PropertyChangeListener>> dirtyPropertyListeners;
 
 	for (const auto& [objectID, cont] : valueHandles) {
 		for (const auto& valueHandle : cont) {
-			auto listenerIt = listeners_.find(objectID);
+			auto listenerIt = listeners_.find(valueHandle);
 			if (listenerIt != listeners_.end()) {
 				for (const auto& ptr : listenerIt->second) {
 					if (!ptr.expired()) {
-						auto listener{ptr.lock()};
-						if (listener->valueHandle() == valueHandle) {
-							dirtyListeners.insert(ptr);
-						}
+						dirtyListeners.insert(ptr);
 					}
 				}
 			}
 
-			decltype(childrenListeners_)::mapped_type dirtyChildrenListeners;
-			auto childListenerIt = childrenListeners_.find(objectID);
-			if (childListenerIt != childrenListeners_.end()) {
-				for (const auto& ptr : childListenerIt->second) {
-					if (!ptr.expired()) {
-						auto listener{ptr.lock()};
-						if (listener->valueHandle() == valueHandle || listener->valueHandle().contains(valueHandle)) {
-							dirtyChildrenListeners.insert(ptr);
-						}
+			// Children listeners registered on the changed value itself or on any of its parents up to the object.
+			dirtyChildrenListeners.clear();
+			if (!childrenListeners_.empty()) {
+				for (auto handle = valueHandle;; handle = handle.parent()) {
+					auto childListenerIt = childrenListeners_.find(handle);
+					if (childListenerIt != childrenListeners_.end()) {
+						dirtyChildrenListeners.insert(dirtyChildrenListeners.end(), childListenerIt->second.begin(), childListenerIt->second.end());
+					}
+					if (handle.depth() == 0) {
+						break;
 					}
 				}
 			}
@@ -443,16 +462,10 @@ void DataChangeDispatcher::emitUpdateFor(const std::map<std::string, std::set<co
 			}
 
 			if (valueHandle.depth() > 0) {
-				auto propName = valueHandle.getPropName();
-
-				decltype(propertyChangeListeners_)::mapped_type dirtyPropertyListeners;
-				auto it = propertyChangeListeners_.find(propName);
+				dirtyPropertyListeners.clear();
+				auto it = propertyChangeListeners_.find(valueHandle.getPropName());
 				if (it != propertyChangeListeners_.end()) {
-					for (const auto& ptr : it->second) {
-						if (!ptr.expired()) {
-							dirtyPropertyListeners.insert(ptr);
-						}
-					}
+					dirtyPropertyListeners.assign(it->second.begin(), it->second.end());
 				}
 				for (const auto& ptr : dirtyPropertyListeners) {
 					if (!ptr.expired()) {
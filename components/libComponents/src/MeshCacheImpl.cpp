@@ -14,16 +14,120 @@
 #include "components/FileChangeMonitorImpl.h"
 
 #include "mesh_loader/CTMFileLoader.h"
+#include "mesh_loader/MeshDiskCache.h"
 #include "mesh_loader/glTFFileLoader.h"
 
+#include <log_system/log.h>
+
+#include <algorithm>
 #include <filesystem>
 #include <memory>
 
+namespace {
+
+bool endsWith(std::string const &text, std::string const &ending) {
+	if (text.length() < ending.length()) return false;
+	const auto startPos = text.length() - ending.length();
+
+	return 0 == text.compare(startPos, ending.length(), ending);
+}
+
+raco::core::UniqueMeshCacheEntry createLoader(const std::string &absPath) {
+	if (endsWith(absPath, ".gltf") || endsWith(absPath, ".glb")) {
+		return std::unique_ptr<raco::core::MeshCacheEntry>(new raco::mesh_loader::glTFFileLoader(absPath));
+	}
+	return std::unique_ptr<raco::core::MeshCacheEntry>(new raco::mesh_loader::CTMFileLoader(absPath));
+}
+
+bool sameDescriptor(const raco::core::MeshDescriptor &left, const raco::core::MeshDescriptor &right) {
+	return left.absPath == right.absPath && left.submeshIndex == right.submeshIndex && left.bakeAllSubmeshes == right.bakeAllSubmeshes;
+}
+
+// Convert with the loader unless the disk cache already has the mesh, new conversions are added to the disk cache.
+raco::core::SharedMeshData loadMeshCached(const raco::mesh_loader::MeshDiskCache* diskCache, const std::string& sourceHash, raco::core::MeshCacheEntry& loader, const raco::core::MeshDescriptor& descriptor, int& outTotalMeshCount) {
+	if (!diskCache || sourceHash.empty()) {
+		return loader.loadMesh(descriptor);
+	}
+	auto key = raco::mesh_loader::MeshDiskCache::key(sourceHash, descriptor);
+	if (auto mesh = diskCache->load(key, outTotalMeshCount)) {
+		return mesh;
+	}
+	auto mesh = loader.loadMesh(descriptor);
+	if (mesh) {
+		outTotalMeshCount = loader.getTotalMeshCount();
+		if (!diskCache->store(key, *mesh, outTotalMeshCount)) {
+			LOG_WARNING(raco::log_system::MESH_LOADER, "Could not add mesh of '{}' to the mesh cache in '{}'", descriptor.absPath, diskCache->directory());
+		}
+	}
+	return mesh;
+}
+
+double toMilliseconds(std::chrono::steady_clock::duration duration) {
+	return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+}  // namespace
+
 namespace raco::components {
 
+MeshCacheImpl::~MeshCacheImpl() {
+	stopWorkers();
+}
+
+void MeshCacheImpl::setAsyncLoading(bool async) {
+	if (asyncLoading_ && !async) {
+		waitForPendingLoads();
+	}
+	asyncLoading_ = async;
+}
+
+bool MeshCacheImpl::asyncLoading() const {
+	return asyncLoading_;
+}
+
+void MeshCacheImpl::setDiskCacheDirectory(const std::string &directory, uint64_t sizeLimit) {
+	// Running loads keep using the cache they have been started with.
+	if (directory.empty()) {
+		diskCache_.reset();
+	} else {
+		diskCache_ = std::make_shared<mesh_loader::MeshDiskCache>(directory, sizeLimit);
+	}
+}
+
+void MeshCacheImpl::publishLoadedMeshes() {
+	std::vector<std::shared_ptr<LoadJob>> finishedJobs;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (const auto &[absPath, job] : loadJobs_) {
+			if (job->finished) {
+				finishedJobs.emplace_back(job);
+			}
+		}
+	}
+	for (const auto &job : finishedJobs) {
+		loadJobs_.erase(job->absPath);
+		publishLoad(*job);
+	}
+
+	// The handlers may request further meshes, collect the paths first.
+	std::unordered_set<std::string> paths;
+	std::swap(paths, publishedPaths_);
+	for (const auto &absPath : paths) {
+		onAfterMeshFileUpdate(absPath);
+	}
+}
+
+void MeshCacheImpl::waitForPendingLoads() {
+	while (!loadJobs_.empty()) {
+		finishLoad(loadJobs_.begin()->first);
+	}
+	publishLoadedMeshes();
+}
+
 void MeshCacheImpl::unregister(std::string absPath, typename core::MeshCache::Callback *listener) {
 	GenericFileChangeMonitorImpl<core::MeshCache>::unregister(absPath, listener);
 	if (callbacks_.find(absPath) == callbacks_.end()) {
+		forgetFile(absPath);
 		meshCacheEntries_.erase(absPath);
 	}
 }
@@ -34,10 +138,33 @@ void MeshCacheImpl::notify(const std::string &absPath) {
 }
 
 raco::core::SharedMeshData MeshCacheImpl::loadMesh(const raco::core::MeshDescriptor &descriptor) {
+	if (auto mesh = findLoadedMesh(descriptor)) {
+		return mesh;
+	}
+	if (asyncLoading_ && meshCacheEntries_.count(descriptor.absPath) == 0) {
+		requestLoad(descriptor);
+		return raco::core::SharedMeshData();
+	}
+	if (diskCache_) {
+		const auto &hash = sourceHash(descriptor.absPath);
+		auto totalMeshCount = -1;
+		auto mesh = loadMeshCached(diskCache_.get(), hash, *getLoader(descriptor.absPath), descriptor, totalMeshCount);
+		if (mesh) {
+			loadedMeshes_[descriptor.absPath].emplace_back(descriptor, mesh);
+		}
+		if (totalMeshCount >= 0) {
+			meshCounts_[descriptor.absPath] = totalMeshCount;
+		}
+		return mesh;
+	}
 	auto *loader = getLoader(descriptor.absPath);
 	return loader->loadMesh(descriptor);
 }
 
+bool MeshCacheImpl::isMeshLoading(const std::string &absPath) {
+	return loadJobs_.find(absPath) != loadJobs_.end();
+}
+
 const raco::core::MeshScenegraph *raco::components::MeshCacheImpl::getMeshScenegraph(const std::string &absPath) {
 	auto *loader = getLoader(absPath);
 	return loader->getScenegraph(absPath);
@@ -49,6 +176,10 @@ std::string raco::components::MeshCacheImpl::getMeshError(const std::string &abs
 }
 
 int raco::components::MeshCacheImpl::getTotalMeshCount(const std::string &absPath) {
+	auto it = meshCounts_.find(absPath);
+	if (it != meshCounts_.end()) {
+		return it->second;
+	}
 	auto *loader = getLoader(absPath);
     return loader->getTotalMeshCount();
 }
@@ -69,8 +200,14 @@ core::SharedSkinData MeshCacheImpl::loadSkin(const std::string &absPath, int ski
 }
 
 void MeshCacheImpl::forceReloadCachedMesh(const std::string &absPath) {
-	auto *loader = getLoader(absPath);
-	loader->reset();
+	forgetFile(absPath);
+	if (asyncLoading_) {
+		// Dropping the loader makes the next loadMesh load the file in the background again.
+		meshCacheEntries_.erase(absPath);
+	} else {
+		auto *loader = getLoader(absPath);
+		loader->reset();
+	}
 }
 
 void MeshCacheImpl::onAfterMeshFileUpdate(const std::string &meshFileAbsPath) {
@@ -82,32 +219,206 @@ void MeshCacheImpl::onAfterMeshFileUpdate(const std::string &meshFileAbsPath) {
 	}
 }
 
-bool endsWith(std::string const &text, std::string const &ending) {
-	if (text.length() < ending.length()) return false;
-	const auto startPos = text.length() - ending.length();
-
-	return 0 == text.compare(startPos, ending.length(), ending);
-}
-
 raco::core::MeshCacheEntry *MeshCacheImpl::getLoader(std::string absPath) {
 	// To prevent cache corpses which are not updated by file change listeners we require to call registerFileChangeHandler
 	// before attempting to load a file:
 	assert(listeners_.find(absPath) != listeners_.end());
+	if (loadJobs_.find(absPath) != loadJobs_.end()) {
+		// Synchronous access to a file which is loading in the background: take over the loader of the background load.
+		finishLoad(absPath);
+	}
 	if (meshCacheEntries_.count(absPath) == 0) {
-		if (endsWith(absPath, ".gltf") || endsWith(absPath, ".glb")) {
-			meshCacheEntries_[absPath] = std::unique_ptr<raco::core::MeshCacheEntry>(new mesh_loader::glTFFileLoader(absPath));
-
-		} else {
-			meshCacheEntries_[absPath] = std::unique_ptr<raco::core::MeshCacheEntry>(new mesh_loader::CTMFileLoader(absPath));
-		}
+		meshCacheEntries_[absPath] = createLoader(absPath);
 	}
     return meshCacheEntries_[absPath].get();
 }
 
 core::MeshCacheEntry *MeshCacheImpl::getWriter(std::string absPath) {
     static core::UniqueMeshCacheEntry entry = std::unique_ptr<raco::core::MeshCacheEntry>(new mesh_loader::glTFFileLoader(absPath));
+    if (meshCacheEntries_.empty() && !loadJobs_.empty()) {
+        // The loaders of background loads are handed over when the load is finished.
+        finishLoad(loadJobs_.begin()->first);
+    }
+    if (meshCacheEntries_.empty()) {
+        return entry.get();
+    }
+    // A loader whose meshes came from the disk cache has not parsed its file yet, it does so when writing.
     return meshCacheEntries_.begin()->second.get();
-    return entry.get();
+}
+
+core::SharedMeshData MeshCacheImpl::findLoadedMesh(const core::MeshDescriptor &descriptor) const {
+	auto it = loadedMeshes_.find(descriptor.absPath);
+	if (it != loadedMeshes_.end()) {
+		for (const auto &[loadedDescriptor, mesh] : it->second) {
+			if (sameDescriptor(loadedDescriptor, descriptor)) {
+				return mesh;
+			}
+		}
+	}
+	return core::SharedMeshData();
+}
+
+const std::string &MeshCacheImpl::sourceHash(const std::string &absPath) {
+	auto it = sourceHashes_.find(absPath);
+	if (it == sourceHashes_.end()) {
+		it = sourceHashes_.emplace(absPath, mesh_loader::MeshDiskCache::sourceHash(absPath)).first;
+	}
+	return it->second;
+}
+
+void MeshCacheImpl::forgetFile(const std::string &absPath) {
+	cancelLoad(absPath);
+	loadedMeshes_.erase(absPath);
+	publishedPaths_.erase(absPath);
+	sourceHashes_.erase(absPath);
+	meshCounts_.erase(absPath);
+}
+
+void MeshCacheImpl::requestLoad(const core::MeshDescriptor &descriptor) {
+	assert(listeners_.find(descriptor.absPath) != listeners_.end());
+	std::lock_guard<std::mutex> lock(mutex_);
+	auto it = loadJobs_.find(descriptor.absPath);
+	if (it != loadJobs_.end()) {
+		// Coalesce with the pending load of the file. Meshes requested after the worker has started are converted
+		// from the already parsed file once the load has been published.
+		auto &job = *it->second;
+		if (!job.started && std::none_of(job.descriptors.begin(), job.descriptors.end(), [&descriptor](const auto &other) { return sameDescriptor(other, descriptor); })) {
+			job.descriptors.emplace_back(descriptor);
+		}
+		return;
+	}
+
+	auto job = std::make_shared<LoadJob>();
+	job->absPath = descriptor.absPath;
+	job->descriptors.emplace_back(descriptor);
+	job->requestTime = std::chrono::steady_clock::now();
+	job->diskCache = diskCache_;
+	auto hashIt = sourceHashes_.find(descriptor.absPath);
+	if (hashIt != sourceHashes_.end()) {
+		job->sourceHash = hashIt->second;
+	}
+	loadJobs_[descriptor.absPath] = job;
+	queue_.emplace_back(job);
+
+	if (workers_.empty()) {
+		// The thread using the cache keeps running the application, leave one core to it.
+		auto threadCount = std::max(2u, std::thread::hardware_concurrency()) - 1;
+		stopWorkers_ = false;
+		for (unsigned i = 0; i < threadCount; ++i) {
+			workers_.emplace_back(&MeshCacheImpl::workerLoop, this);
+		}
+	}
+	queueCondition_.notify_one();
+}
+
+void MeshCacheImpl::finishLoad(const std::string &absPath) {
+	auto it = loadJobs_.find(absPath);
+	if (it == loadJobs_.end()) {
+		return;
+	}
+	auto job = it->second;
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		if (!job->started) {
+			queue_.erase(std::find(queue_.begin(), queue_.end(), job));
+			job->started = true;
+			lock.unlock();
+			runLoad(*job);
+			lock.lock();
+			job->finished = true;
+		}
+		doneCondition_.wait(lock, [&job]() { return job->finished; });
+	}
+	loadJobs_.erase(absPath);
+	publishLoad(*job);
+}
+
+void MeshCacheImpl::cancelLoad(const std::string &absPath) {
+	auto it = loadJobs_.find(absPath);
+	if (it == loadJobs_.end()) {
+		return;
+	}
+	{
+		// A running load can't be interrupted, its result is dropped when it finishes.
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto queueIt = std::find(queue_.begin(), queue_.end(), it->second);
+		if (queueIt != queue_.end()) {
+			queue_.erase(queueIt);
+		}
+	}
+	loadJobs_.erase(it);
+}
+
+void MeshCacheImpl::publishLoad(LoadJob &job) {
+	auto &loadedMeshes = loadedMeshes_[job.absPath];
+	for (size_t index = 0; index < job.descriptors.size(); ++index) {
+		if (job.meshes[index]) {
+			loadedMeshes.emplace_back(job.descriptors[index], job.meshes[index]);
+		}
+	}
+	// Failed meshes are loaded again through the loader so that its error message matches the mesh.
+	meshCacheEntries_[job.absPath] = job.loader ? std::move(job.loader) : createLoader(job.absPath);
+	if (!job.sourceHash.empty()) {
+		sourceHashes_[job.absPath] = job.sourceHash;
+	}
+	if (job.totalMeshCount >= 0) {
+		meshCounts_[job.absPath] = job.totalMeshCount;
+	}
+	publishedPaths_.insert(job.absPath);
+
+	LOG_INFO(log_system::MESH_LOADER, "Loaded mesh file '{}' in {:.1f} ms, available {:.1f} ms after the request", job.absPath,
+		toMilliseconds(job.loadTime), toMilliseconds(std::chrono::steady_clock::now() - job.requestTime));
+}
+
+void MeshCacheImpl::runLoad(LoadJob &job) {
+	auto start = std::chrono::steady_clock::now();
+	job.meshes.resize(job.descriptors.size());
+	try {
+		if (job.diskCache && job.sourceHash.empty()) {
+			job.sourceHash = mesh_loader::MeshDiskCache::sourceHash(job.absPath);
+		}
+		job.loader = createLoader(job.absPath);
+		for (size_t index = 0; index < job.descriptors.size(); ++index) {
+			job.meshes[index] = loadMeshCached(job.diskCache.get(), job.sourceHash, *job.loader, job.descriptors[index], job.totalMeshCount);
+		}
+	} catch (const std::exception &error) {
+		// Leave the failure to the synchronous load on the thread using the cache.
+		LOG_WARNING(log_system::MESH_LOADER, "Loading mesh file '{}' in the background failed: {}", job.absPath, error.what());
+		job.loader.reset();
+		std::fill(job.meshes.begin(), job.meshes.end(), core::SharedMeshData());
+	}
+	job.loadTime = std::chrono::steady_clock::now() - start;
+}
+
+void MeshCacheImpl::workerLoop() {
+	std::unique_lock<std::mutex> lock(mutex_);
+	while (true) {
+		queueCondition_.wait(lock, [this]() { return stopWorkers_ || !queue_.empty(); });
+		if (stopWorkers_) {
+			return;
+		}
+		auto job = queue_.front();
+		queue_.pop_front();
+		job->started = true;
+		lock.unlock();
+		runLoad(*job);
+		lock.lock();
+		job->finished = true;
+		doneCondition_.notify_all();
+	}
+}
+
+void MeshCacheImpl::stopWorkers() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stopWorkers_ = true;
+		queue_.clear();
+	}
+	queueCondition_.notify_all();
+	for (auto &worker : workers_) {
+		worker.join();
+	}
+	workers_.clear();
 }
 
 }  // namespace raco::components
@@ -34,6 +34,9 @@ bool RaCoPreferences::save() {
 	settings.setValue("interfaceSubdirectory", interfaceSubdirectory);
 	settings.setValue("shaderSubdirectory", shaderSubdirectory);
 	settings.setValue("featureLevel", featureLevel);
+	settings.setValue("undoMemoryBudget", undoMemoryBudget);
+	settings.setValue("meshCacheSize", meshCacheSize);
+	settings.setValue("animationKeyReduceTolerance", animationKeyReduceTolerance);
 
 	settings.sync();
 	return settings.status() == QSettings::NoError;
@@ -55,6 +58,9 @@ void RaCoPreferences::load() {
 	shaderSubdirectory = settings.value("shaderSubdirectory", "shaders").toString();
 
 	featureLevel = settings.value("featureLevel", 1).toInt();
+	undoMemoryBudget = settings.value("undoMemoryBudget", 1024).toInt();
+	meshCacheSize = settings.value("meshCacheSize", 2048).toInt();
+	animationKeyReduceTolerance = settings.value("animationKeyReduceTolerance", 0.0).toDouble();
 }
 
 RaCoPreferences& RaCoPreferences::instance() noexcept {
@@ -21,6 +21,7 @@
 #include <ramses_base/HeadlessEngineBackend.h>
 
 #include <memory>
+#include <numeric>
 
 using namespace raco::user_types;
 using namespace raco::components;
@@ -133,6 +134,49 @@ TEST_F(DataChangeDispatcherTest, registerOnChildren_dispatchEmitUpdated) {
 	testing::Mock::VerifyAndClearExpectations(&callback2);
 }
 
+TEST_F(DataChangeDispatcherTest, registerOnChildren_dispatchEmitsForAllParents) {
+	SEditorObject node = std::make_shared<Node>();
+	ValueHandle translation{node, {"translation"}};
+	ValueHandle x{translation.get("x")};
+
+	testing::MockFunction<void(ValueHandle)> objectCallback{};
+	EXPECT_CALL(objectCallback, Call(x)).Times(1);
+	testing::MockFunction<void(ValueHandle)> translationCallback{};
+	EXPECT_CALL(translationCallback, Call(x)).Times(1);
+	testing::MockFunction<void(ValueHandle)> xCallback{};
+	EXPECT_CALL(xCallback, Call(x)).Times(1);
+	testing::MockFunction<void(ValueHandle)> rotationCallback{};
+	EXPECT_CALL(rotationCallback, Call(testing::_)).Times(0);
+
+	auto objectSubscription = underTest.registerOnChildren(ValueHandle{node}, objectCallback.AsStdFunction());
+	auto translationSubscription = underTest.registerOnChildren(translation, translationCallback.AsStdFunction());
+	auto xSubscription = underTest.registerOnChildren(x, xCallback.AsStdFunction());
+	auto rotationSubscription = underTest.registerOnChildren(ValueHandle{node, {"rotation"}}, rotationCallback.AsStdFunction());
+
+	// TEST
+	context.set(x, 1.0);
+	underTest.dispatch(recorder.release());
+
+	testing::Mock::VerifyAndClearExpectations(&objectCallback);
+	testing::Mock::VerifyAndClearExpectations(&translationCallback);
+	testing::Mock::VerifyAndClearExpectations(&xCallback);
+	testing::Mock::VerifyAndClearExpectations(&rotationCallback);
+}
+
+TEST_F(DataChangeDispatcherTest, dispatchStatistics) {
+	EXPECT_EQ(underTest.dispatchStatistics().dispatches, 0u);
+
+	underTest.dispatch(recorder.release());
+	underTest.dispatch(recorder.release());
+
+	const auto& statistics = underTest.dispatchStatistics();
+	EXPECT_EQ(statistics.dispatches, 2u);
+	EXPECT_EQ(std::accumulate(statistics.durationHistogram.begin(), statistics.durationHistogram.end(), uint64_t{0}), 2u);
+
+	underTest.resetDispatchStatistics();
+	EXPECT_EQ(underTest.dispatchStatistics().dispatches, 0u);
+}
+
 class LifeCycleListenertest : public DataChangeDispatcherTest {
 public:
 	LifeCycleListenertest() {
@@ -0,0 +1,205 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "gtest/gtest.h"
+
+#include "components/MeshCacheImpl.h"
+#include "testing/TestEnvironmentCore.h"
+#include "user_types/Mesh.h"
+
+#include <cstring>
+#include <filesystem>
+
+using namespace raco::core;
+
+class MeshCacheImplTest : public TestEnvironmentCore {
+protected:
+	MeshDescriptor descriptor(const std::string& relpath, int submeshIndex = 0, bool bakeAllSubmeshes = false) {
+		MeshDescriptor desc;
+		desc.absPath = (test_path() / relpath).string();
+		desc.submeshIndex = submeshIndex;
+		desc.bakeAllSubmeshes = bakeAllSubmeshes;
+		return desc;
+	}
+
+	FileChangeMonitor::UniqueListener registerHandler(const std::string& absPath) {
+		return meshCache.registerFileChangedHandler(absPath, {nullptr, nullptr, [this]() { ++callbackCount_; }});
+	}
+
+	int callbackCount_{0};
+};
+
+TEST_F(MeshCacheImplTest, sync_load_returns_mesh_immediately) {
+	auto desc = descriptor("meshes/Duck.glb");
+	auto listener = registerHandler(desc.absPath);
+
+	auto mesh = meshCache.loadMesh(desc);
+	ASSERT_NE(mesh, nullptr);
+	EXPECT_FALSE(meshCache.isMeshLoading(desc.absPath));
+	EXPECT_EQ(callbackCount_, 0);
+}
+
+TEST_F(MeshCacheImplTest, async_load_is_published_with_callback) {
+	meshCache.setAsyncLoading(true);
+	auto desc = descriptor("meshes/Duck.glb");
+	auto listener = registerHandler(desc.absPath);
+
+	EXPECT_EQ(meshCache.loadMesh(desc), nullptr);
+	EXPECT_TRUE(meshCache.isMeshLoading(desc.absPath));
+
+	meshCache.waitForPendingLoads();
+	EXPECT_FALSE(meshCache.isMeshLoading(desc.absPath));
+	EXPECT_EQ(callbackCount_, 1);
+
+	auto mesh = meshCache.loadMesh(desc);
+	ASSERT_NE(mesh, nullptr);
+	EXPECT_EQ(meshCache.loadMesh(desc), mesh);
+
+	meshCache.setAsyncLoading(false);
+	auto syncMesh = meshCache.loadMesh(descriptor("meshes/Duck.glb", 0, true));
+	ASSERT_NE(syncMesh, nullptr);
+	EXPECT_EQ(mesh->numVertices(), syncMesh->numVertices());
+	EXPECT_EQ(mesh->numTriangles(), syncMesh->numTriangles());
+}
+
+TEST_F(MeshCacheImplTest, async_load_coalesces_requests_of_same_file) {
+	meshCache.setAsyncLoading(true);
+	auto first = descriptor("meshes/ToyCar/ToyCar.gltf", 0);
+	auto second = descriptor("meshes/ToyCar/ToyCar.gltf", 1);
+	auto listener = registerHandler(first.absPath);
+
+	EXPECT_EQ(meshCache.loadMesh(first), nullptr);
+	EXPECT_EQ(meshCache.loadMesh(second), nullptr);
+	EXPECT_EQ(meshCache.loadMesh(first), nullptr);
+
+	meshCache.waitForPendingLoads();
+	EXPECT_EQ(callbackCount_, 1);
+	EXPECT_NE(meshCache.loadMesh(first), nullptr);
+	EXPECT_NE(meshCache.loadMesh(second), nullptr);
+}
+
+TEST_F(MeshCacheImplTest, async_load_of_invalid_submesh_reports_loader_error) {
+	meshCache.setAsyncLoading(true);
+	auto desc = descriptor("meshes/Duck.glb", 42);
+	auto listener = registerHandler(desc.absPath);
+
+	EXPECT_EQ(meshCache.loadMesh(desc), nullptr);
+	meshCache.waitForPendingLoads();
+
+	EXPECT_EQ(meshCache.loadMesh(desc), nullptr);
+	EXPECT_FALSE(meshCache.isMeshLoading(desc.absPath));
+	EXPECT_FALSE(meshCache.getMeshError(desc.absPath).empty());
+}
+
+TEST_F(MeshCacheImplTest, async_load_synchronous_access_takes_over_pending_load) {
+	meshCache.setAsyncLoading(true);
+	auto desc = descriptor("meshes/CesiumMilkTruck/CesiumMilkTruck.gltf");
+	auto listener = registerHandler(desc.absPath);
+
+	EXPECT_EQ(meshCache.loadMesh(desc), nullptr);
+	EXPECT_NE(meshCache.getMeshScenegraph(desc.absPath), nullptr);
+	EXPECT_FALSE(meshCache.isMeshLoading(desc.absPath));
+	EXPECT_NE(meshCache.loadMesh(desc), nullptr);
+
+	// The handlers still get notified about the finished load.
+	meshCache.publishLoadedMeshes();
+	EXPECT_EQ(callbackCount_, 1);
+}
+
+TEST_F(MeshCacheImplTest, async_load_is_dropped_when_last_handler_unregisters) {
+	meshCache.setAsyncLoading(true);
+	auto desc = descriptor("meshes/Duck.glb");
+	{
+		auto listener = registerHandler(desc.absPath);
+		EXPECT_EQ(meshCache.loadMesh(desc), nullptr);
+	}
+	EXPECT_FALSE(meshCache.isMeshLoading(desc.absPath));
+	meshCache.waitForPendingLoads();
+	EXPECT_EQ(callbackCount_, 0);
+}
+
+TEST_F(MeshCacheImplTest, async_load_updates_mesh_object) {
+	meshCache.setAsyncLoading(true);
+	auto mesh = create_mesh("mesh", "meshes/Duck.glb");
+
+	EXPECT_EQ(mesh->meshData(), nullptr);
+	ASSERT_TRUE(commandInterface.errors().hasError({mesh}));
+	EXPECT_EQ(commandInterface.errors().getError({mesh}).level(), ErrorLevel::INFORMATION);
+
+	meshCache.waitForPendingLoads();
+	ASSERT_NE(mesh->meshData(), nullptr);
+	EXPECT_FALSE(commandInterface.errors().hasError(ErrorLevel::ERROR));
+}
+
+TEST_F(MeshCacheImplTest, disk_cache_is_reused_by_new_cache) {
+	auto cacheDirectory = (test_path() / "meshcache").string();
+	auto desc = descriptor("meshes/ToyCar/ToyCar.gltf");
+	raco::core::SharedMeshData mesh;
+	int totalMeshCount;
+	{
+		raco::components::MeshCacheImpl cache;
+		cache.setDiskCacheDirectory(cacheDirectory);
+		auto listener = cache.registerFileChangedHandler(desc.absPath, {nullptr, nullptr, []() {}});
+		mesh = cache.loadMesh(desc);
+		ASSERT_NE(mesh, nullptr);
+		totalMeshCount = cache.getTotalMeshCount(desc.absPath);
+	}
+	ASSERT_FALSE(std::filesystem::is_empty(cacheDirectory));
+
+	raco::components::MeshCacheImpl cache;
+	cache.setDiskCacheDirectory(cacheDirectory);
+	cache.setAsyncLoading(true);
+	auto listener = cache.registerFileChangedHandler(desc.absPath, {nullptr, nullptr, []() {}});
+	EXPECT_EQ(cache.loadMesh(desc), nullptr);
+	cache.waitForPendingLoads();
+
+	auto cachedMesh = cache.loadMesh(desc);
+	ASSERT_NE(cachedMesh, nullptr);
+	EXPECT_EQ(cache.getTotalMeshCount(desc.absPath), totalMeshCount);
+	EXPECT_EQ(cachedMesh->numVertices(), mesh->numVertices());
+	EXPECT_EQ(cachedMesh->getIndices(), mesh->getIndices());
+	ASSERT_EQ(cachedMesh->numAttributes(), mesh->numAttributes());
+	for (uint32_t index = 0; index < mesh->numAttributes(); ++index) {
+		ASSERT_EQ(cachedMesh->attribDataSize(index), mesh->attribDataSize(index));
+		EXPECT_EQ(std::memcmp(cachedMesh->attribBuffer(index), mesh->attribBuffer(index), mesh->attribDataSize(index)), 0);
+	}
+}
+
+TEST_F(MeshCacheImplTest, disk_cache_hit_exports_parsed_file) {
+	auto cacheDirectory = (test_path() / "meshcache").string();
+	auto desc = descriptor("meshes/CesiumMilkTruck/CesiumMilkTruck.gltf", 0, true);
+	{
+		raco::components::MeshCacheImpl cache;
+		cache.setDiskCacheDirectory(cacheDirectory);
+		auto listener = cache.registerFileChangedHandler(desc.absPath, {nullptr, nullptr, []() {}});
+		ASSERT_NE(cache.loadMesh(desc), nullptr);
+	}
+
+	// The mesh comes from the disk cache, the glTF file itself has not been parsed before the export.
+	auto outPath = (test_path() / "meshes/CesiumMilkTruck/CesiumMilkTruck_exported.gltf").string();
+	{
+		raco::components::MeshCacheImpl cache;
+		cache.setDiskCacheDirectory(cacheDirectory);
+		auto listener = cache.registerFileChangedHandler(desc.absPath, {nullptr, nullptr, []() {}});
+		ASSERT_NE(cache.loadMesh(desc), nullptr);
+		ASSERT_TRUE(cache.writeMeshScenegraph(MeshScenegraph{}, outPath));
+	}
+
+	raco::components::MeshCacheImpl cache;
+	auto sourceListener = cache.registerFileChangedHandler(desc.absPath, {nullptr, nullptr, []() {}});
+	auto exportedListener = cache.registerFileChangedHandler(outPath, {nullptr, nullptr, []() {}});
+	auto source = cache.getMeshScenegraph(desc.absPath);
+	auto exported = cache.getMeshScenegraph(outPath);
+	ASSERT_NE(source, nullptr);
+	ASSERT_NE(exported, nullptr);
+	EXPECT_FALSE(exported->meshes.empty());
+	EXPECT_FALSE(exported->nodes.empty());
+	EXPECT_EQ(exported->meshes.size(), source->meshes.size());
+	EXPECT_EQ(exported->nodes.size(), source->nodes.size());
+}
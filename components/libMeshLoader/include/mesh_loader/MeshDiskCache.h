@@ -0,0 +1,60 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#pragma once
+
+#include "core/MeshCacheInterface.h"
+
+#include <cstdint>
+#include <string>
+
+namespace raco::mesh_loader {
+
+// Converted meshes stored on disk, addressed by the content of the source files and the MeshDescriptor flags.
+// Cached meshes are memory mapped: the attribute buffers of loaded meshes point directly into the mapped file.
+// All functions may be called concurrently, entries are written atomically.
+// With a size limit the least recently used entries are removed when the cache is opened and after
+// new entries are stored. Loading an entry marks it as used by updating its modification time.
+class MeshDiskCache {
+public:
+	static constexpr const char* FILE_EXTENSION = ".rcmesh";
+
+	// A size limit of 0 means unlimited.
+	explicit MeshDiskCache(std::string directory, uint64_t sizeLimit = 0);
+
+	const std::string& directory() const;
+	uint64_t sizeLimit() const;
+
+	// Hash over the content of the mesh file and the external buffers it references.
+	// Returns an empty string if one of the files can't be read.
+	static std::string sourceHash(const std::string& absPath);
+
+	// Key of the mesh converted from the given sources with the flags of the descriptor.
+	static std::string key(const std::string& sourceHash, const core::MeshDescriptor& descriptor);
+
+	// Returns nullptr if there is no valid entry for the key. totalMeshCount is the
+	// number of meshes in the source file as reported by the loader when the entry was stored.
+	core::SharedMeshData load(const std::string& key, int& outTotalMeshCount) const;
+
+	bool store(const std::string& key, const core::MeshData& mesh, int totalMeshCount) const;
+
+	// Remove least recently used entries until the cache fits into the size limit.
+	void prune() const;
+
+	// Remove all entries.
+	void clear() const;
+
+private:
+	std::string filePath(const std::string& key) const;
+
+	std::string directory_;
+	uint64_t sizeLimit_;
+};
+
+}  // namespace raco::mesh_loader
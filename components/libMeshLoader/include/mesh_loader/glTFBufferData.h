@@ -10,8 +10,12 @@
 #pragma once
 
 #include <log_system/log.h>
+#include <algorithm>
+#include <cassert>
+#include <limits>
 #include <set>
 #include <tiny_gltf.h>
+#include <type_traits>
 
 struct glTFBufferData {
 	glTFBufferData(const tinygltf::Model &scene, int accessorIndex, const std::set<int> &allowedComponentTypes, const std::set<int> &allowedTypes)
@@ -139,6 +143,82 @@ struct glTFBufferData {
 		return {};
 	}
 
+	// Bulk conversion of all elements: appends accessor_.count * numComponents() floats to dest.
+	// Integer components are normalized to [-1, 1] if normalize is set, otherwise just converted.
+	void appendConvertedData(std::vector<float> &dest, bool normalize) const {
+		auto offset = dest.size();
+		dest.resize(offset + accessor_.count * numComponents());
+		convertDataTo(dest.data() + offset, normalize);
+	}
+
+	// Writes accessor_.count * numComponents() floats to dest, see appendConvertedData.
+	void convertDataTo(float *dest, bool normalize) const {
+		switch (accessor_.componentType) {
+			case TINYGLTF_PARAMETER_TYPE_FLOAT:
+				convertComponents<float, false>(dest);
+				break;
+
+			case TINYGLTF_PARAMETER_TYPE_BYTE:
+				normalize ? convertComponents<int8_t, true>(dest) : convertComponents<int8_t, false>(dest);
+				break;
+
+			case TINYGLTF_PARAMETER_TYPE_UNSIGNED_BYTE:
+				normalize ? convertComponents<uint8_t, true>(dest) : convertComponents<uint8_t, false>(dest);
+				break;
+
+			case TINYGLTF_PARAMETER_TYPE_SHORT:
+				normalize ? convertComponents<int16_t, true>(dest) : convertComponents<int16_t, false>(dest);
+				break;
+
+			case TINYGLTF_PARAMETER_TYPE_UNSIGNED_SHORT:
+				normalize ? convertComponents<uint16_t, true>(dest) : convertComponents<uint16_t, false>(dest);
+				break;
+
+			case TINYGLTF_PARAMETER_TYPE_INT:
+				normalize ? convertComponents<int32_t, true>(dest) : convertComponents<int32_t, false>(dest);
+				break;
+
+			case TINYGLTF_PARAMETER_TYPE_UNSIGNED_INT:
+				normalize ? convertComponents<uint32_t, true>(dest) : convertComponents<uint32_t, false>(dest);
+				break;
+		}
+	}
+
+	// Appends all scalar elements of an index accessor to dest, each increased by offset.
+	void appendIndexData(std::vector<uint32_t> &dest, uint32_t offset) const {
+		auto first = dest.size();
+		dest.resize(first + accessor_.count);
+		switch (accessor_.componentType) {
+			case TINYGLTF_PARAMETER_TYPE_UNSIGNED_BYTE:
+				convertIndices<uint8_t>(dest.data() + first, offset);
+				break;
+
+			case TINYGLTF_PARAMETER_TYPE_UNSIGNED_SHORT:
+				convertIndices<uint16_t>(dest.data() + first, offset);
+				break;
+
+			case TINYGLTF_PARAMETER_TYPE_UNSIGNED_INT:
+				convertIndices<uint32_t>(dest.data() + first, offset);
+				break;
+
+			case TINYGLTF_PARAMETER_TYPE_BYTE:
+				convertIndices<int8_t>(dest.data() + first, offset);
+				break;
+
+			case TINYGLTF_PARAMETER_TYPE_SHORT:
+				convertIndices<int16_t>(dest.data() + first, offset);
+				break;
+
+			case TINYGLTF_PARAMETER_TYPE_INT:
+				convertIndices<int32_t>(dest.data() + first, offset);
+				break;
+
+			case TINYGLTF_PARAMETER_TYPE_FLOAT:
+				convertIndices<float>(dest.data() + first, offset);
+				break;
+		}
+	}
+
 	template<typename T>
 	std::vector<float> normalize(const std::vector<T> &data){
 		std::vector<float> result(data.size());
@@ -148,6 +228,42 @@ struct glTFBufferData {
 		return result;
 	}
 
+	template <typename U, bool Normalize>
+	void convertComponents(float *dest) const {
+		const size_t components = numComponents();
+		const size_t stride = accessor_.ByteStride(view_) / sizeof(U);
+		assert(stride >= components);
+		auto source = reinterpret_cast<const U *>(&bufferBytes[(accessor_.byteOffset + view_.byteOffset)]);
+
+		// Tightly packed accessors are converted as one flat array, which the compiler turns into vector instructions.
+		const size_t count = (stride == components) ? accessor_.count * components : components;
+		const size_t rows = (stride == components) ? 1 : accessor_.count;
+		for (size_t row = 0; row < rows; ++row) {
+			const U *in = source + row * stride;
+			float *out = dest + row * components;
+			if constexpr (std::is_same_v<U, float>) {
+				std::copy(in, in + count, out);
+			} else if constexpr (Normalize) {
+				const float maxValue = static_cast<float>(std::numeric_limits<U>::max());
+				for (size_t i = 0; i < count; ++i) {
+					out[i] = std::max(-1.0F, in[i] / maxValue);
+				}
+			} else {
+				for (size_t i = 0; i < count; ++i) {
+					out[i] = static_cast<float>(in[i]);
+				}
+			}
+		}
+	}
+
+	template <typename U>
+	void convertIndices(uint32_t *dest, uint32_t offset) const {
+		auto source = reinterpret_cast<const U *>(&bufferBytes[(accessor_.byteOffset + view_.byteOffset)]);
+		for (size_t i = 0; i < accessor_.count; ++i) {
+			dest[i] = static_cast<uint32_t>(source[i]) + offset;
+		}
+	}
+
 	const tinygltf::Model &scene_;
 	const tinygltf::Accessor &accessor_;
 	const tinygltf::BufferView &view_;
@@ -42,9 +42,11 @@ private:
 	std::unique_ptr<raco::core::MeshScenegraph> sceneGraph_;
 	std::string error_;
 	std::string warning_;
+	bool imagesLoaded_{false};
 
 	bool buildglTFScenegraph();
-	bool importglTFScene(const std::string& absPath);
+	// Image pixel data is only decoded if requested.
+	bool importglTFScene(const std::string& absPath, bool withImages = false);
 	void importAnimations();
 	void importSkins();
 
@@ -0,0 +1,448 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include "mesh_loader/MeshDiskCache.h"
+
+#include <log_system/log.h>
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QUrl>
+
+#include <cstring>
+
+namespace {
+
+using raco::core::MeshData;
+
+constexpr char FILE_MAGIC[8] = {'R', 'A', 'C', 'O', 'M', 'E', 'S', 'H'};
+// Increase whenever the file layout or the mesh conversion changes, old entries are ignored then.
+constexpr uint32_t FILE_VERSION = 1;
+constexpr size_t DATA_ALIGNMENT = 16;
+
+class Writer {
+public:
+	void append(const void* data, size_t size) {
+		auto bytes = static_cast<const char*>(data);
+		buffer_.insert(buffer_.end(), bytes, bytes + size);
+	}
+
+	void writeUInt32(uint32_t value) {
+		append(&value, sizeof(value));
+	}
+
+	size_t writeUInt64(uint64_t value) {
+		auto position = buffer_.size();
+		append(&value, sizeof(value));
+		return position;
+	}
+
+	void patchUInt64(size_t position, uint64_t value) {
+		std::memcpy(buffer_.data() + position, &value, sizeof(value));
+	}
+
+	void writeString(const std::string& value) {
+		writeUInt32(static_cast<uint32_t>(value.size()));
+		append(value.data(), value.size());
+	}
+
+	void align() {
+		buffer_.resize((buffer_.size() + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT, 0);
+	}
+
+	const std::vector<char>& buffer() const {
+		return buffer_;
+	}
+
+private:
+	std::vector<char> buffer_;
+};
+
+class Reader {
+public:
+	Reader(const char* data, size_t size) : data_(data), size_(size) {}
+
+	bool read(void* value, size_t size) {
+		if (size_ - position_ < size) {
+			return false;
+		}
+		std::memcpy(value, data_ + position_, size);
+		position_ += size;
+		return true;
+	}
+
+	bool readUInt32(uint32_t& value) {
+		return read(&value, sizeof(value));
+	}
+
+	bool readUInt64(uint64_t& value) {
+		return read(&value, sizeof(value));
+	}
+
+	bool readString(std::string& value) {
+		uint32_t size;
+		if (!readUInt32(size) || size_ - position_ < size) {
+			return false;
+		}
+		value.assign(data_ + position_, size);
+		position_ += size;
+		return true;
+	}
+
+	// Pointer to a block of the file, nullptr if the block is not completely inside of the file.
+	const char* block(uint64_t offset, uint64_t size) const {
+		if (offset > size_ || size_ - offset < size) {
+			return nullptr;
+		}
+		return data_ + offset;
+	}
+
+private:
+	const char* data_;
+	size_t size_;
+	size_t position_{0};
+};
+
+// Mesh whose attribute buffers point into a memory mapped cache file.
+class MappedMesh : public MeshData {
+public:
+	struct Attribute {
+		std::string name;
+		VertexAttribDataType type;
+		uint32_t elementCount;
+		uint32_t dataSize;
+		const char* data;
+	};
+
+	uint32_t numSubmeshes() const override {
+		return numSubmeshes_;
+	}
+
+	uint32_t numTriangles() const override {
+		return numTriangles_;
+	}
+
+	uint32_t numVertices() const override {
+		return numVertices_;
+	}
+
+	std::vector<std::string> getMaterialNames() const override {
+		return materials_;
+	}
+
+	const std::vector<uint32_t>& getIndices() const override {
+		return indices_;
+	}
+
+	std::map<std::string, std::string> getMetadata() const override {
+		return metadata_;
+	}
+
+	const std::vector<IndexBufferRangeInfo>& submeshIndexBufferRanges() const override {
+		return submeshIndexBufferRanges_;
+	}
+
+	uint32_t numAttributes() const override {
+		return static_cast<uint32_t>(attributes_.size());
+	}
+
+	std::string attribName(int attribIndex) const override {
+		return attributes_.at(attribIndex).name;
+	}
+
+	uint32_t attribDataSize(int attribIndex) const override {
+		return attributes_.at(attribIndex).dataSize;
+	}
+
+	uint32_t attribElementCount(int attribIndex) const override {
+		return attributes_.at(attribIndex).elementCount;
+	}
+
+	VertexAttribDataType attribDataType(int attribIndex) const override {
+		return attributes_.at(attribIndex).type;
+	}
+
+	const char* attribBuffer(int attribIndex) const override {
+		return attributes_.at(attribIndex).data;
+	}
+
+	// Keeps the mapping alive as long as the mesh is used.
+	std::unique_ptr<QFile> file_;
+
+	uint32_t numSubmeshes_{0};
+	uint32_t numTriangles_{0};
+	uint32_t numVertices_{0};
+	std::vector<std::string> materials_;
+	std::map<std::string, std::string> metadata_;
+	std::vector<IndexBufferRangeInfo> submeshIndexBufferRanges_;
+	// The index buffer is part of the MeshData interface as vector and has to be copied.
+	std::vector<uint32_t> indices_;
+	std::vector<Attribute> attributes_;
+};
+
+uint32_t componentCount(MeshData::VertexAttribDataType type) {
+	return static_cast<uint32_t>(type) + 1;
+}
+
+bool addFileToHash(QCryptographicHash& hash, const QString& path) {
+	QFile file(path);
+	if (!file.open(QIODevice::ReadOnly)) {
+		return false;
+	}
+	return hash.addData(&file);
+}
+
+QByteArray readglTFJson(const QString& path) {
+	QFile file(path);
+	if (!file.open(QIODevice::ReadOnly)) {
+		return {};
+	}
+	if (path.endsWith(".glb", Qt::CaseInsensitive)) {
+		// GLB header (magic, version, length) followed by the JSON chunk (length, type, data).
+		auto header = file.read(20);
+		if (header.size() != 20 || !header.startsWith("glTF")) {
+			return {};
+		}
+		uint32_t jsonLength;
+		std::memcpy(&jsonLength, header.constData() + 12, sizeof(jsonLength));
+		return file.read(jsonLength);
+	}
+	return file.readAll();
+}
+
+// Buffers which are not embedded into the glTF file itself, the mesh data depends on their content as well.
+std::vector<QString> externalBufferPaths(const QString& path) {
+	std::vector<QString> result;
+	if (!path.endsWith(".gltf", Qt::CaseInsensitive) && !path.endsWith(".glb", Qt::CaseInsensitive)) {
+		return result;
+	}
+	auto document = QJsonDocument::fromJson(readglTFJson(path));
+	auto directory = QFileInfo(path).dir();
+	for (const auto& buffer : document.object().value("buffers").toArray()) {
+		auto uri = buffer.toObject().value("uri").toString();
+		if (!uri.isEmpty() && !uri.startsWith("data:")) {
+			result.emplace_back(directory.filePath(QUrl::fromPercentEncoding(uri.toUtf8())));
+		}
+	}
+	return result;
+}
+
+}  // namespace
+
+namespace raco::mesh_loader {
+
+MeshDiskCache::MeshDiskCache(std::string directory, uint64_t sizeLimit) : directory_(std::move(directory)), sizeLimit_(sizeLimit) {
+	prune();
+}
+
+const std::string& MeshDiskCache::directory() const {
+	return directory_;
+}
+
+uint64_t MeshDiskCache::sizeLimit() const {
+	return sizeLimit_;
+}
+
+std::string MeshDiskCache::sourceHash(const std::string& absPath) {
+	auto path = QString::fromStdString(absPath);
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	if (!addFileToHash(hash, path)) {
+		return {};
+	}
+	for (const auto& bufferPath : externalBufferPaths(path)) {
+		if (!addFileToHash(hash, bufferPath)) {
+			return {};
+		}
+	}
+	return hash.result().toHex().toStdString();
+}
+
+std::string MeshDiskCache::key(const std::string& sourceHash, const core::MeshDescriptor& descriptor) {
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	hash.addData(sourceHash.data(), static_cast<int>(sourceHash.size()));
+	auto flags = fmt::format(";{};{};{}", FILE_VERSION, descriptor.bakeAllSubmeshes, descriptor.submeshIndex);
+	hash.addData(flags.data(), static_cast<int>(flags.size()));
+	return hash.result().toHex().toStdString();
+}
+
+core::SharedMeshData MeshDiskCache::load(const std::string& key, int& outTotalMeshCount) const {
+	auto file = std::make_unique<QFile>(QString::fromStdString(filePath(key)));
+	if (!file->open(QIODevice::ReadOnly)) {
+		return {};
+	}
+	auto size = static_cast<size_t>(file->size());
+	auto data = reinterpret_cast<const char*>(file->map(0, file->size()));
+	if (!data) {
+		return {};
+	}
+
+	auto mesh = std::make_shared<MappedMesh>();
+	Reader reader(data, size);
+	char magic[sizeof(FILE_MAGIC)];
+	uint32_t version;
+	uint32_t totalMeshCount;
+	uint32_t count;
+	auto valid = reader.read(magic, sizeof(magic)) && std::memcmp(magic, FILE_MAGIC, sizeof(magic)) == 0 &&
+				 reader.readUInt32(version) && version == FILE_VERSION &&
+				 reader.readUInt32(totalMeshCount) &&
+				 reader.readUInt32(mesh->numSubmeshes_) &&
+				 reader.readUInt32(mesh->numTriangles_) &&
+				 reader.readUInt32(mesh->numVertices_) &&
+				 reader.readUInt32(count);
+	for (uint32_t index = 0; valid && index < count; ++index) {
+		valid = reader.readString(mesh->materials_.emplace_back());
+	}
+	valid = valid && reader.readUInt32(count);
+	for (uint32_t index = 0; valid && index < count; ++index) {
+		std::string name;
+		std::string value;
+		valid = reader.readString(name) && reader.readString(value);
+		mesh->metadata_[name] = value;
+	}
+	valid = valid && reader.readUInt32(count);
+	for (uint32_t index = 0; valid && index < count; ++index) {
+		auto& range = mesh->submeshIndexBufferRanges_.emplace_back();
+		valid = reader.readUInt32(range.start) && reader.readUInt32(range.count);
+	}
+	valid = valid && reader.readUInt32(count) && count <= size / sizeof(uint32_t);
+	if (valid) {
+		mesh->indices_.resize(count);
+		valid = reader.read(mesh->indices_.data(), count * sizeof(uint32_t));
+	}
+	valid = valid && reader.readUInt32(count);
+	for (uint32_t index = 0; valid && index < count; ++index) {
+		auto& attribute = mesh->attributes_.emplace_back();
+		uint32_t type;
+		uint64_t offset;
+		valid = reader.readString(attribute.name) &&
+				reader.readUInt32(type) && type <= static_cast<uint32_t>(MeshData::VertexAttribDataType::VAT_Float4) &&
+				reader.readUInt32(attribute.elementCount) &&
+				reader.readUInt32(attribute.dataSize) &&
+				reader.readUInt64(offset);
+		if (valid) {
+			attribute.type = static_cast<MeshData::VertexAttribDataType>(type);
+			attribute.data = reader.block(offset, attribute.dataSize);
+			valid = attribute.data && static_cast<uint64_t>(attribute.elementCount) * componentCount(attribute.type) * sizeof(float) == attribute.dataSize;
+		}
+	}
+
+	if (!valid) {
+		LOG_WARNING(log_system::MESH_LOADER, "Ignoring invalid mesh cache file '{}'", filePath(key));
+		return {};
+	}
+	// The modification time orders the entries for pruning.
+	mesh->file_ = std::move(file);
+	mesh->file_->setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+	outTotalMeshCount = static_cast<int>(totalMeshCount);
+	return mesh;
+}
+
+bool MeshDiskCache::store(const std::string& key, const core::MeshData& mesh, int totalMeshCount) const {
+	Writer writer;
+	writer.append(FILE_MAGIC, sizeof(FILE_MAGIC));
+	writer.writeUInt32(FILE_VERSION);
+	writer.writeUInt32(static_cast<uint32_t>(totalMeshCount));
+	writer.writeUInt32(mesh.numSubmeshes());
+	writer.writeUInt32(mesh.numTriangles());
+	writer.writeUInt32(mesh.numVertices());
+
+	auto materials = mesh.getMaterialNames();
+	writer.writeUInt32(static_cast<uint32_t>(materials.size()));
+	for (const auto& material : materials) {
+		writer.writeString(material);
+	}
+	auto metadata = mesh.getMetadata();
+	writer.writeUInt32(static_cast<uint32_t>(metadata.size()));
+	for (const auto& [name, value] : metadata) {
+		writer.writeString(name);
+		writer.writeString(value);
+	}
+	const auto& ranges = mesh.submeshIndexBufferRanges();
+	writer.writeUInt32(static_cast<uint32_t>(ranges.size()));
+	for (const auto& range : ranges) {
+		writer.writeUInt32(range.start);
+		writer.writeUInt32(range.count);
+	}
+	const auto& indices = mesh.getIndices();
+	writer.writeUInt32(static_cast<uint32_t>(indices.size()));
+	writer.append(indices.data(), indices.size() * sizeof(uint32_t));
+
+	std::vector<size_t> offsetPositions;
+	writer.writeUInt32(mesh.numAttributes());
+	for (uint32_t index = 0; index < mesh.numAttributes(); ++index) {
+		writer.writeString(mesh.attribName(index));
+		writer.writeUInt32(static_cast<uint32_t>(mesh.attribDataType(index)));
+		writer.writeUInt32(mesh.attribElementCount(index));
+		writer.writeUInt32(mesh.attribDataSize(index));
+		offsetPositions.emplace_back(writer.writeUInt64(0));
+	}
+	// Aligned attribute data, so that the mapped buffers can be handed out as they are.
+	for (uint32_t index = 0; index < mesh.numAttributes(); ++index) {
+		writer.align();
+		writer.patchUInt64(offsetPositions[index], writer.buffer().size());
+		writer.append(mesh.attribBuffer(index), mesh.attribDataSize(index));
+	}
+
+	if (!QDir().mkpath(QString::fromStdString(directory_))) {
+		return false;
+	}
+	QSaveFile file(QString::fromStdString(filePath(key)));
+	if (!file.open(QIODevice::WriteOnly)) {
+		return false;
+	}
+	const auto& buffer = writer.buffer();
+	if (file.write(buffer.data(), static_cast<qint64>(buffer.size())) != static_cast<qint64>(buffer.size())) {
+		file.cancelWriting();
+		return false;
+	}
+	if (!file.commit()) {
+		return false;
+	}
+	prune();
+	return true;
+}
+
+void MeshDiskCache::prune() const {
+	if (sizeLimit_ == 0) {
+		return;
+	}
+	QDir directory(QString::fromStdString(directory_));
+	// Most recently used first.
+	auto entries = directory.entryInfoList({QString("*") + FILE_EXTENSION}, QDir::Files, QDir::Time);
+	uint64_t totalSize = 0;
+	for (const auto& entry : entries) {
+		totalSize += static_cast<uint64_t>(entry.size());
+	}
+	for (auto it = entries.rbegin(); it != entries.rend() && totalSize > sizeLimit_; ++it) {
+		// Entries in use stay mapped on all platforms but Windows, where removing them fails; they are retried later.
+		if (directory.remove(it->fileName())) {
+			totalSize -= static_cast<uint64_t>(it->size());
+		}
+	}
+}
+
+void MeshDiskCache::clear() const {
+	QDir directory(QString::fromStdString(directory_));
+	for (const auto& fileName : directory.entryList({QString("*") + FILE_EXTENSION}, QDir::Files)) {
+		directory.remove(fileName);
+	}
+}
+
+std::string MeshDiskCache::filePath(const std::string& key) const {
+	return QDir(QString::fromStdString(directory_)).filePath(QString::fromStdString(key + FILE_EXTENSION)).toStdString();
+}
+
+}  // namespace raco::mesh_loader
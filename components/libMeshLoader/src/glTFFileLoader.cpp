@@ -27,8 +27,42 @@
 #include <glm/mat4x4.hpp>
 #include <log_system/log.h>
 
+#include <QFile>
+
+#include <limits>
+
 namespace {
 
+// Meshes, scenegraphs, animations and skins don't use the textures of the file: keep the image descriptions
+// but don't decode the pixel data.
+bool skipImageData(tinygltf::Image*, const int, std::string*, std::string*, int, int, const unsigned char*, int, void*) {
+	return true;
+}
+
+// Parse the file from a read-only memory mapping instead of reading it into a temporary buffer first.
+// Buffers embedded into GLB files are copied directly from the mapping into the model.
+bool loadglTFFile(tinygltf::TinyGLTF& importer, tinygltf::Model& model, const std::string& absPath, std::string& err, std::string& warn) {
+	auto path = raco::utils::u8path(absPath);
+	auto binary = path.extension() == ".glb";
+
+	QFile file(QString::fromStdString(absPath));
+	const unsigned char* data = nullptr;
+	if (file.open(QIODevice::ReadOnly) && file.size() > 0 && file.size() <= std::numeric_limits<unsigned int>::max()) {
+		data = file.map(0, file.size());
+	}
+	if (!data) {
+		// Let tinygltf report missing, empty or unreadable files.
+		return binary ? importer.LoadBinaryFromFile(&model, &err, &warn, absPath) : importer.LoadASCIIFromFile(&model, &err, &warn, absPath);
+	}
+
+	auto baseDir = path.parent_path().string();
+	auto size = static_cast<unsigned int>(file.size());
+	if (binary) {
+		return importer.LoadBinaryFromMemory(&model, &err, &warn, data, size, baseDir);
+	}
+	return importer.LoadASCIIFromString(&model, &err, &warn, reinterpret_cast<const char*>(data), size, baseDir);
+}
+
 std::array<std::array<double, 3>, 3> tinyglTFtrafoMatrixToXYZTrafos(const std::vector<double>& tinyMatrix) {
 	assert(tinyMatrix.size() == 16);
 
@@ -149,20 +183,23 @@ bool glTFFileLoader::buildglTFScenegraph() {
 	return true;
 }
 
-bool glTFFileLoader::importglTFScene(const std::string& absPath) {
+bool glTFFileLoader::importglTFScene(const std::string& absPath, bool withImages) {
+	if (importer_ && withImages && !imagesLoaded_) {
+		reset();
+	}
 	error_.clear();
 
 	if (!importer_) {
 		LOG_DEBUG(log_system::MESH_LOADER, "Create importer for: {}", absPath);
 		importer_ = std::make_unique<tinygltf::TinyGLTF>();
+		if (!withImages) {
+			importer_->SetImageLoader(&skipImageData, nullptr);
+		}
+		imagesLoaded_ = withImages;
 		std::string err;
 		std::string warn;
 
-		if (raco::utils::u8path(absPath).extension() == ".glb") {
-			importer_->LoadBinaryFromFile(&*scene_, &err, &warn, absPath);
-		} else {
-			importer_->LoadASCIIFromFile(&*scene_, &err, &warn, absPath);
-		}
+		loadglTFFile(*importer_, *scene_, absPath, err, warn);
 		if (!warn.empty()) {
 			LOG_WARNING(log_system::MESH_LOADER, "Encountered warnings while loading glTF mesh {}: {}", absPath, warn);
 		}
@@ -240,14 +277,11 @@ const raco::core::MeshScenegraph* glTFFileLoader::getScenegraph(const std::strin
 }
 
 bool glTFFileLoader::writeScenegraphGltf(const core::MeshScenegraph &sceneGraph, const std::string &absPath) {
-    if (!importer_) {
-        LOG_DEBUG(log_system::MESH_LOADER, "Create importer for: {}", absPath);
-        importer_ = std::make_unique<tinygltf::TinyGLTF>();
+    // The images are written as well, so they need to be decoded now. The file has not been parsed at all
+    // if its meshes were taken from the mesh disk cache.
+    if ((!importer_ || !imagesLoaded_) && !importglTFScene(path_, true)) {
+        return false;
     }
-    // fill TinyGLTF
-
-    int size = scene_.get()->bufferViews.size();
-    int size2 = scene_.get()->buffers.size();
     return importer_->WriteGltfSceneToFile(&*scene_, absPath);
 }
 
@@ -299,14 +333,16 @@ raco::core::SharedAnimationSamplerData glTFFileLoader::getAnimationSamplerData(c
 
 	auto inputData = glTFBufferData(*scene_, sampler.input, {TINYGLTF_COMPONENT_TYPE_FLOAT}, {TINYGLTF_TYPE_SCALAR});
 	std::vector<float> input;
-	for (auto count = 0; count < inputData.accessor_.count; ++count) {
-		input.emplace_back(inputData.getDataAt<float>(count).front());
-	}
+	inputData.appendConvertedData(input, false);
 
 	auto outputData = glTFBufferData(*scene_, sampler.output, {TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_COMPONENT_TYPE_BYTE, TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE, TINYGLTF_COMPONENT_TYPE_SHORT, TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT}, {TINYGLTF_TYPE_SCALAR, TINYGLTF_TYPE_VEC3, TINYGLTF_TYPE_VEC4});
+	std::vector<float> outputValues;
+	outputData.appendConvertedData(outputValues, true);
+	auto numComponents = outputData.numComponents();
 	std::vector<std::vector<float>> output;
-	for (auto count = 0; count < outputData.accessor_.count; ++count) {
-		output.emplace_back(outputData.getNormalizedData(count));
+	output.reserve(outputData.accessor_.count);
+	for (auto it = outputValues.begin(); it != outputValues.end(); it += numComponents) {
+		output.emplace_back(it, it + numComponents);
 	}
 
 	return std::make_shared<raco::core::AnimationSamplerData>(raco::core::AnimationSamplerData{interpolation, input, output});
@@ -15,6 +15,7 @@
 #include <glm/gtx/transform.hpp>
 #include <glm/vec3.hpp>
 #include <log_system/log.h>
+#include <numeric>
 #include <optional>
 #include <stdexcept>
 #include <vector>
@@ -259,18 +260,42 @@ const char *glTFMesh::attribBuffer(int attribute_index) const {
 	return reinterpret_cast<const char *>(attributes_.at(attribute_index).data.data());
 }
 
-void convertVectorWithTransformation(std::vector<float> vector, std::vector<float> &buffer, glm::dmat4 *trafoMatrix, double component_4) {
-	if (trafoMatrix) {
-		auto transformed = *trafoMatrix * glm::dvec4(vector[0], vector[1], vector[2], component_4);
-		buffer.insert(buffer.end(), {static_cast<float>(transformed.x), static_cast<float>(transformed.y), static_cast<float>(transformed.z)});
-	} else {
-		buffer.insert(buffer.end(), {vector[0], vector[1], vector[2]});
+// Transforms count tightly packed 3-component vectors in place, using component_4 as 4th component.
+void transformVectors(float *vectors, size_t count, const glm::dmat4 &trafoMatrix, double component_4) {
+	for (size_t index = 0; index < count; index++) {
+		float *vector = vectors + 3 * index;
+		auto transformed = trafoMatrix * glm::dvec4(vector[0], vector[1], vector[2], component_4);
+		vector[0] = static_cast<float>(transformed.x);
+		vector[1] = static_cast<float>(transformed.y);
+		vector[2] = static_cast<float>(transformed.z);
+	}
+}
+
+// Transforms count normals in place with the normal matrix and normalizes them again. The scaling factors are stored
+// in scalingFactors if it is empty, otherwise the given factors are used instead of normalizing.
+void transformNormals(float *normals, size_t count, const glm::dmat4 &normalMatrix, std::vector<float> &scalingFactors) {
+	bool computeFactors = scalingFactors.empty();
+	if (computeFactors) {
+		scalingFactors.resize(count);
+	}
+	for (size_t index = 0; index < count; index++) {
+		float *normal = normals + 3 * index;
+		auto transformed = glm::vec3(normalMatrix * glm::dvec4(normal[0], normal[1], normal[2], 0.0));
+		if (computeFactors) {
+			scalingFactors[index] = 1.0 / sqrt(glm::dot(transformed, transformed));
+		}
+		auto normalized = scalingFactors[index] * transformed;
+		normal[0] = normalized.x;
+		normal[1] = normalized.y;
+		normal[2] = normalized.z;
 	}
 }
 
 void convertPositionData(const glTFBufferData &data, std::vector<float> &buffer, glm::dmat4 *rootTrafoMatrix = nullptr) {
-	for (size_t vertexIndex = 0; vertexIndex < data.accessor_.count; vertexIndex++) {
-		convertVectorWithTransformation(data.getDataAt<float>(vertexIndex), buffer, rootTrafoMatrix, 1.0);
+	auto offset = buffer.size();
+	data.appendConvertedData(buffer, false);
+	if (rootTrafoMatrix) {
+		transformVectors(buffer.data() + offset, data.accessor_.count, *rootTrafoMatrix, 1.0);
 	}
 }
 
@@ -282,11 +307,7 @@ void convertAttributeSet(const tinygltf::Primitive &primitive, const tinygltf::M
 
 			if (bufferData.accessor_.count == numVertices) {
 				buffers.resize(channel + 1);
-				std::vector<float> &buffer{buffers[channel]};
-				for (size_t vertexIndex = 0; vertexIndex < bufferData.accessor_.count; vertexIndex++) {
-					auto elementData = normalize ? bufferData.getNormalizedData(vertexIndex) : bufferData.getConvertedData<float>(vertexIndex);
-					buffer.insert(buffer.end(), elementData.begin(), elementData.end());
-				}
+				bufferData.appendConvertedData(buffers[channel], normalize);
 			} else {
 				LOG_WARNING(log_system::MESH_LOADER, "Attribute '{}' has different size than vertex buffer, ignoring it.", attribName);
 			}
@@ -353,34 +374,44 @@ void glTFMesh::loadPrimitiveData(const tinygltf::Primitive &primitive, const tin
 	}
 
 	if (normalData) {
+		// The transformation of the normals changes the length so we have to normalize them again afterwards:
+		// The scaling factor calculated here also needs to be applied to the morph target normals with the same vertex index
+		// to assure that the direction of the weighted morphed normals do not change due to normalization.
 		std::vector<float> normalScalingFactors;
-		for (size_t vertexIndex = 0; vertexIndex < normalData->accessor_.count; vertexIndex++) {
-			auto normal = normalData->getDataAt<float>(vertexIndex);
-			if (globalNormalMatrix) {
-				// The transformation of the normals changes the length so we have to normalize them again afterwards:
-				// The scaling factor calculated here also needs to be applied to the morph target normals with the same vertex index
-				// to assure that the direction of the weighted morphed normals do not change due to normalization.
-				auto transformed = glm::vec3(*globalNormalMatrix * glm::dvec4(normal[0], normal[1], normal[2], 0.0));
-				float normalScalingFactor = 1.0 / sqrt(glm::dot(transformed, transformed));
-				//float normalScalingFactor = 1.0;
-				normalScalingFactors.emplace_back(normalScalingFactor);
-				auto normalized = normalScalingFactor * transformed;
-				normalBuffer.insert(normalBuffer.end(), {static_cast<float>(normalized.x), static_cast<float>(normalized.y), static_cast<float>(normalized.z)});
-			} else {
-				normalBuffer.insert(normalBuffer.end(), {normal[0], normal[1], normal[2]});
-			}
-
-			if (tangentData) {
-				auto tangent = tangentData->getDataAt<float>(vertexIndex);
-				// Even though the GLTF file contains VEC4 tangents we convert to VEC3 in ramses since the 4th component is only
-				// needed for the bitangent calculation below:
-				convertVectorWithTransformation(tangent, tangentBuffer, globalModelMatrix, 0.0);
-
+		auto normalOffset = normalBuffer.size();
+		normalData->appendConvertedData(normalBuffer, false);
+		const float *normals = normalBuffer.data() + normalOffset;
+
+		if (tangentData) {
+			// Even though the GLTF file contains VEC4 tangents we convert to VEC3 in ramses since the 4th component is only
+			// needed for the bitangent calculation below. The bitangents use the normals before transformation.
+			std::vector<float> tangents;
+			tangentData->appendConvertedData(tangents, false);
+
+			auto tangentOffset = tangentBuffer.size();
+			tangentBuffer.resize(tangentOffset + 3 * numVertices);
+			bitangentBuffer.resize(tangentOffset + 3 * numVertices);
+			float *tangentOut = tangentBuffer.data() + tangentOffset;
+			float *bitangentOut = bitangentBuffer.data() + tangentOffset;
+			for (size_t vertexIndex = 0; vertexIndex < numVertices; vertexIndex++) {
+				const float *normal = normals + 3 * vertexIndex;
+				const float *tangent = tangents.data() + 4 * vertexIndex;
 				auto bitangent = glm::cross(glm::vec3{normal[0], normal[1], normal[2]}, glm::vec3{tangent[0], tangent[1], tangent[2]}) * tangent[3];
-				convertVectorWithTransformation({bitangent.x, bitangent.y, bitangent.z}, bitangentBuffer, globalModelMatrix, 0.0);
+				std::copy(tangent, tangent + 3, tangentOut + 3 * vertexIndex);
+				bitangentOut[3 * vertexIndex] = bitangent.x;
+				bitangentOut[3 * vertexIndex + 1] = bitangent.y;
+				bitangentOut[3 * vertexIndex + 2] = bitangent.z;
+			}
+			if (globalModelMatrix) {
+				transformVectors(tangentOut, numVertices, *globalModelMatrix, 0.0);
+				transformVectors(bitangentOut, numVertices, *globalModelMatrix, 0.0);
 			}
 		}
 
+		if (globalNormalMatrix) {
+			transformNormals(normalBuffer.data() + normalOffset, numVertices, *globalNormalMatrix, normalScalingFactors);
+		}
+
 		morphNormalBuffers.resize(primitive.targets.size());
 		for (size_t targetIndex = 0; targetIndex < primitive.targets.size(); targetIndex++) {
 			auto it = primitive.targets[targetIndex].find("NORMAL");
@@ -388,19 +419,12 @@ void glTFMesh::loadPrimitiveData(const tinygltf::Primitive &primitive, const tin
 				glTFBufferData data(scene, it->second, std::set<int>{TINYGLTF_COMPONENT_TYPE_FLOAT}, std ::set<int>{TINYGLTF_TYPE_VEC3});
 
 				if (data.accessor_.count == numVertices) {
-					for (size_t index = 0; index < data.accessor_.count; index++) {
-						auto normal = data.getDataAt<float>(index);
-						if (globalNormalMatrix) {
-							auto transformed = glm::vec3(*globalNormalMatrix * glm::dvec4(normal[0], normal[1], normal[2], 0.0));
-							// Use the same scaling factor for the morph target normals as for the base normals to make sure the direction
-							// of the morphed normals is not changed by normalization.
-							auto normalized = normalScalingFactors[index] * transformed;
-							morphNormalBuffers[targetIndex].insert(morphNormalBuffers[targetIndex].end(), {static_cast<float>(normalized.x), static_cast<float>(normalized.y), static_cast<float>(normalized.z)});
-						} else {
-							morphNormalBuffers[targetIndex].insert(morphNormalBuffers[targetIndex].end(), {normal[0], normal[1], normal[2]});
-						}
-
-
+					auto morphOffset = morphNormalBuffers[targetIndex].size();
+					data.appendConvertedData(morphNormalBuffers[targetIndex], false);
+					if (globalNormalMatrix) {
+						// Use the same scaling factor for the morph target normals as for the base normals to make sure the direction
+						// of the morphed normals is not changed by normalization.
+						transformNormals(morphNormalBuffers[targetIndex].data() + morphOffset, numVertices, *globalNormalMatrix, normalScalingFactors);
 					}
 				} else {
 					LOG_WARNING(log_system::MESH_LOADER, "Morph normal attribute has different size than vertex buffer, ignoring it.");
@@ -433,19 +457,16 @@ void glTFMesh::loadPrimitiveData(const tinygltf::Primitive &primitive, const tin
 		glTFBufferData indexBufferData(scene, primitive.indices, {TINYGLTF_PARAMETER_TYPE_UNSIGNED_INT, TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT, TINYGLTF_TEXTURE_TYPE_UNSIGNED_BYTE}, std::set<int>{TINYGLTF_TYPE_SCALAR});
 		auto indexAccessorCount = indexBufferData.accessor_.count;
 
-		for (size_t index = 0; index < indexAccessorCount; index++) {
-			auto data = indexBufferData.getConvertedData<uint32_t>(index, false).front();
-			indexBuffer_.emplace_back(data + numVertices_);
-		}
+		indexBufferData.appendIndexData(indexBuffer_, numVertices_);
 
 		bufferRange.count += indexAccessorCount;
 		numTriangles_ += indexAccessorCount / 3;
 	} else {
 		auto indexCount = posData.accessor_.count;
 
-		for (auto index = 0; index < indexCount; ++index) {
-			indexBuffer_.emplace_back(index + numVertices_);
-		}
+		auto first = indexBuffer_.size();
+		indexBuffer_.resize(first + indexCount);
+		std::iota(indexBuffer_.begin() + first, indexBuffer_.end(), numVertices_);
 
 		bufferRange.count += indexCount;
 		numTriangles_ += indexCount / 3;
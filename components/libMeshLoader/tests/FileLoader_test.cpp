@@ -153,6 +153,49 @@ TEST_F(MeshLoaderTest, glTFLoadInvalidThenValid) {
 	ASSERT_NE(mesh, nullptr);
 }
 
+TEST_F(MeshLoaderTest, glbLoadFromMappedFile) {
+	core::MeshDescriptor desc;
+	desc.absPath = test_path().append("meshes/Duck.glb").string();
+	desc.bakeAllSubmeshes = false;
+	desc.submeshIndex = 0;
+
+	mesh_loader::glTFFileLoader fileloader(desc.absPath);
+	auto mesh = fileloader.loadMesh(desc);
+	ASSERT_NE(mesh, nullptr);
+	ASSERT_GT(mesh->numVertices(), 0);
+	ASSERT_NE(fileloader.getScenegraph(desc.absPath), nullptr);
+}
+
+TEST_F(MeshLoaderTest, glTFMissingFile) {
+	core::MeshDescriptor desc;
+	desc.absPath = test_path().append("meshes/doesNotExist.gltf").string();
+
+	mesh_loader::glTFFileLoader fileloader(desc.absPath);
+	ASSERT_EQ(fileloader.loadMesh(desc), nullptr);
+	ASSERT_FALSE(fileloader.getError().empty());
+}
+
+TEST_F(MeshLoaderTest, glTFWriteScenegraphAfterLoadWithoutImages) {
+	core::MeshDescriptor desc;
+	desc.absPath = test_path().append("meshes/CesiumMilkTruck/CesiumMilkTruck.gltf").string();
+	desc.bakeAllSubmeshes = true;
+
+	mesh_loader::glTFFileLoader fileloader(desc.absPath);
+	auto mesh = fileloader.loadMesh(desc);
+	ASSERT_NE(mesh, nullptr);
+
+	auto outPath = test_path().append("meshes/CesiumMilkTruck/CesiumMilkTruck_written.gltf").string();
+	ASSERT_TRUE(fileloader.writeScenegraphGltf(*fileloader.getScenegraph(desc.absPath), outPath));
+
+	core::MeshDescriptor writtenDesc = desc;
+	writtenDesc.absPath = outPath;
+	mesh_loader::glTFFileLoader writtenLoader(outPath);
+	auto writtenMesh = writtenLoader.loadMesh(writtenDesc);
+	ASSERT_NE(writtenMesh, nullptr);
+	ASSERT_EQ(writtenMesh->numVertices(), mesh->numVertices());
+	ASSERT_EQ(writtenMesh->getIndices(), mesh->getIndices());
+}
+
 TEST_F(MeshLoaderTest, glTFWithTangentsAndBitangents) {
 	auto mesh = loadMesh("meshes/AnimatedMorphCube/AnimatedMorphCube.gltf", false, 0);
 
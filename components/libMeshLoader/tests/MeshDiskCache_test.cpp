@@ -0,0 +1,190 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <gtest/gtest.h>
+
+#include "mesh_loader/MeshDiskCache.h"
+#include "mesh_loader/glTFFileLoader.h"
+#include "testing/TestEnvironmentCore.h"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+using namespace raco;
+
+class MeshDiskCacheTest : public TestEnvironmentCore {
+protected:
+	core::MeshDescriptor descriptor(const std::string& relPath, bool bake = true, int submeshIndex = 0) {
+		return core::MeshDescriptor{(test_path() / relPath).string(), submeshIndex, bake};
+	}
+
+	std::string cacheDirectory() {
+		return (test_path() / "meshcache").string();
+	}
+
+	std::vector<std::filesystem::path> cacheFiles() {
+		std::vector<std::filesystem::path> files;
+		if (std::filesystem::exists(cacheDirectory())) {
+			for (const auto& entry : std::filesystem::directory_iterator(cacheDirectory())) {
+				files.emplace_back(entry.path());
+			}
+		}
+		return files;
+	}
+
+	static void expectSameMesh(const core::MeshData& expected, const core::MeshData& actual) {
+		EXPECT_EQ(expected.numSubmeshes(), actual.numSubmeshes());
+		EXPECT_EQ(expected.numTriangles(), actual.numTriangles());
+		EXPECT_EQ(expected.numVertices(), actual.numVertices());
+		EXPECT_EQ(expected.getMaterialNames(), actual.getMaterialNames());
+		EXPECT_EQ(expected.getIndices(), actual.getIndices());
+		EXPECT_EQ(expected.getMetadata(), actual.getMetadata());
+		ASSERT_EQ(expected.submeshIndexBufferRanges().size(), actual.submeshIndexBufferRanges().size());
+		for (size_t index = 0; index < expected.submeshIndexBufferRanges().size(); ++index) {
+			EXPECT_EQ(expected.submeshIndexBufferRanges()[index].start, actual.submeshIndexBufferRanges()[index].start);
+			EXPECT_EQ(expected.submeshIndexBufferRanges()[index].count, actual.submeshIndexBufferRanges()[index].count);
+		}
+		ASSERT_EQ(expected.numAttributes(), actual.numAttributes());
+		for (uint32_t index = 0; index < expected.numAttributes(); ++index) {
+			EXPECT_EQ(expected.attribName(index), actual.attribName(index));
+			EXPECT_EQ(expected.attribDataType(index), actual.attribDataType(index));
+			EXPECT_EQ(expected.attribElementCount(index), actual.attribElementCount(index));
+			ASSERT_EQ(expected.attribDataSize(index), actual.attribDataSize(index));
+			EXPECT_EQ(std::memcmp(expected.attribBuffer(index), actual.attribBuffer(index), expected.attribDataSize(index)), 0);
+			EXPECT_EQ(reinterpret_cast<uintptr_t>(actual.attribBuffer(index)) % alignof(float), 0);
+		}
+	}
+};
+
+TEST_F(MeshDiskCacheTest, store_and_load_preserves_mesh) {
+	mesh_loader::MeshDiskCache cache(cacheDirectory());
+	for (auto [relPath, bake, submeshIndex] : std::vector<std::tuple<std::string, bool, int>>{
+			 {"meshes/CesiumMilkTruck/CesiumMilkTruck.gltf", true, 0},
+			 {"meshes/CesiumMilkTruck/CesiumMilkTruck.gltf", false, 1},
+			 {"meshes/AnimatedMorphCube/AnimatedMorphCube.gltf", false, 0},
+			 {"meshes/SimpleSkin/SimpleSkin.gltf", false, 0}}) {
+		auto desc = descriptor(relPath, bake, submeshIndex);
+		mesh_loader::glTFFileLoader loader(desc.absPath);
+		auto mesh = loader.loadMesh(desc);
+		ASSERT_NE(mesh, nullptr);
+
+		auto key = mesh_loader::MeshDiskCache::key(mesh_loader::MeshDiskCache::sourceHash(desc.absPath), desc);
+		ASSERT_TRUE(cache.store(key, *mesh, loader.getTotalMeshCount()));
+
+		int totalMeshCount = -1;
+		auto cachedMesh = cache.load(key, totalMeshCount);
+		ASSERT_NE(cachedMesh, nullptr);
+		EXPECT_EQ(totalMeshCount, loader.getTotalMeshCount());
+		expectSameMesh(*mesh, *cachedMesh);
+	}
+}
+
+TEST_F(MeshDiskCacheTest, key_depends_on_descriptor_flags) {
+	auto hash = mesh_loader::MeshDiskCache::sourceHash(descriptor("meshes/CesiumMilkTruck/CesiumMilkTruck.gltf").absPath);
+	ASSERT_FALSE(hash.empty());
+
+	auto baked = mesh_loader::MeshDiskCache::key(hash, descriptor("meshes/CesiumMilkTruck/CesiumMilkTruck.gltf", true, 0));
+	auto submesh0 = mesh_loader::MeshDiskCache::key(hash, descriptor("meshes/CesiumMilkTruck/CesiumMilkTruck.gltf", false, 0));
+	auto submesh1 = mesh_loader::MeshDiskCache::key(hash, descriptor("meshes/CesiumMilkTruck/CesiumMilkTruck.gltf", false, 1));
+	EXPECT_NE(baked, submesh0);
+	EXPECT_NE(submesh0, submesh1);
+
+	// The key only depends on the content, not on the location of the file.
+	auto moved = descriptor("somewhere/else.gltf", false, 1);
+	EXPECT_EQ(mesh_loader::MeshDiskCache::key(hash, moved), submesh1);
+}
+
+TEST_F(MeshDiskCacheTest, source_hash_covers_external_buffers) {
+	auto path = descriptor("meshes/AnimatedMorphCube/AnimatedMorphCube.gltf").absPath;
+	auto hash = mesh_loader::MeshDiskCache::sourceHash(path);
+	ASSERT_FALSE(hash.empty());
+	EXPECT_EQ(mesh_loader::MeshDiskCache::sourceHash(path), hash);
+
+	{
+		std::ofstream buffer((test_path() / "meshes/AnimatedMorphCube/AnimatedMorphCube.bin").string(), std::ios::binary | std::ios::app);
+		buffer.put(0);
+	}
+	EXPECT_NE(mesh_loader::MeshDiskCache::sourceHash(path), hash);
+
+	std::filesystem::remove(test_path() / "meshes/AnimatedMorphCube/AnimatedMorphCube.bin");
+	EXPECT_TRUE(mesh_loader::MeshDiskCache::sourceHash(path).empty());
+	EXPECT_TRUE(mesh_loader::MeshDiskCache::sourceHash(descriptor("meshes/does_not_exist.gltf").absPath).empty());
+}
+
+TEST_F(MeshDiskCacheTest, invalid_entries_are_ignored) {
+	mesh_loader::MeshDiskCache cache(cacheDirectory());
+	auto desc = descriptor("meshes/CesiumMilkTruck/CesiumMilkTruck.gltf");
+	mesh_loader::glTFFileLoader loader(desc.absPath);
+	auto mesh = loader.loadMesh(desc);
+	ASSERT_NE(mesh, nullptr);
+	auto key = mesh_loader::MeshDiskCache::key(mesh_loader::MeshDiskCache::sourceHash(desc.absPath), desc);
+
+	int totalMeshCount = -1;
+	EXPECT_EQ(cache.load(key, totalMeshCount), nullptr);
+
+	ASSERT_TRUE(cache.store(key, *mesh, loader.getTotalMeshCount()));
+	auto files = cacheFiles();
+	ASSERT_EQ(files.size(), 1u);
+	auto size = std::filesystem::file_size(files.front());
+	std::filesystem::resize_file(files.front(), size - 1);
+	EXPECT_EQ(cache.load(key, totalMeshCount), nullptr);
+
+	{
+		std::ofstream file(files.front(), std::ios::binary | std::ios::trunc);
+		file << "not a mesh";
+	}
+	EXPECT_EQ(cache.load(key, totalMeshCount), nullptr);
+	EXPECT_EQ(totalMeshCount, -1);
+}
+
+TEST_F(MeshDiskCacheTest, clear_removes_entries) {
+	mesh_loader::MeshDiskCache cache(cacheDirectory());
+	auto desc = descriptor("meshes/CesiumMilkTruck/CesiumMilkTruck.gltf");
+	mesh_loader::glTFFileLoader loader(desc.absPath);
+	auto mesh = loader.loadMesh(desc);
+	ASSERT_NE(mesh, nullptr);
+	auto key = mesh_loader::MeshDiskCache::key(mesh_loader::MeshDiskCache::sourceHash(desc.absPath), desc);
+	ASSERT_TRUE(cache.store(key, *mesh, loader.getTotalMeshCount()));
+	EXPECT_EQ(cacheFiles().size(), 1u);
+
+	cache.clear();
+	EXPECT_TRUE(cacheFiles().empty());
+	int totalMeshCount = -1;
+	EXPECT_EQ(cache.load(key, totalMeshCount), nullptr);
+}
+
+TEST_F(MeshDiskCacheTest, prune_removes_least_recently_used_entries) {
+	auto desc = descriptor("meshes/CesiumMilkTruck/CesiumMilkTruck.gltf");
+	mesh_loader::glTFFileLoader loader(desc.absPath);
+	auto mesh = loader.loadMesh(desc);
+	ASSERT_NE(mesh, nullptr);
+	auto hash = mesh_loader::MeshDiskCache::sourceHash(desc.absPath);
+	auto oldKey = mesh_loader::MeshDiskCache::key(hash, descriptor("meshes/CesiumMilkTruck/CesiumMilkTruck.gltf", true, 0));
+	auto newKey = mesh_loader::MeshDiskCache::key(hash, descriptor("meshes/CesiumMilkTruck/CesiumMilkTruck.gltf", false, 0));
+
+	mesh_loader::MeshDiskCache unlimited(cacheDirectory());
+	ASSERT_TRUE(unlimited.store(oldKey, *mesh, loader.getTotalMeshCount()));
+	ASSERT_EQ(cacheFiles().size(), 1u);
+	auto oldFile = cacheFiles().front();
+	std::filesystem::last_write_time(oldFile, std::filesystem::last_write_time(oldFile) - std::chrono::hours(1));
+	auto entrySize = std::filesystem::file_size(oldFile);
+
+	// Room for one entry only: storing the second one removes the older one.
+	mesh_loader::MeshDiskCache cache(cacheDirectory(), entrySize + entrySize / 2);
+	ASSERT_TRUE(cache.store(newKey, *mesh, loader.getTotalMeshCount()));
+	auto files = cacheFiles();
+	ASSERT_EQ(files.size(), 1u);
+	EXPECT_NE(files.front(), oldFile);
+
+	int totalMeshCount = -1;
+	EXPECT_EQ(cache.load(oldKey, totalMeshCount), nullptr);
+	EXPECT_NE(cache.load(newKey, totalMeshCount), nullptr);
+}
@@ -0,0 +1,99 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <gtest/gtest.h>
+
+#include "mesh_loader/glTFBufferData.h"
+
+#include <cstring>
+
+namespace {
+
+template <typename T>
+tinygltf::Model createModel(int componentType, int type, int numComponents, size_t count, size_t byteStride) {
+	tinygltf::Model model;
+	size_t elementSize = byteStride > 0 ? byteStride : numComponents * sizeof(T);
+
+	tinygltf::Buffer buffer;
+	buffer.data.resize(16 + count * elementSize);
+	for (size_t index = 0; index < count; index++) {
+		for (int component = 0; component < numComponents; component++) {
+			T value = static_cast<T>((index * 7 + component * 13) % 200);
+			if constexpr (std::is_signed_v<T>) {
+				value = static_cast<T>(value - 100);
+			}
+			std::memcpy(&buffer.data[16 + index * elementSize + component * sizeof(T)], &value, sizeof(T));
+		}
+	}
+	model.buffers.emplace_back(buffer);
+
+	tinygltf::BufferView view;
+	view.buffer = 0;
+	view.byteOffset = 8;
+	view.byteStride = byteStride;
+	view.byteLength = buffer.data.size() - 8;
+	model.bufferViews.emplace_back(view);
+
+	tinygltf::Accessor accessor;
+	accessor.bufferView = 0;
+	accessor.byteOffset = 8;
+	accessor.componentType = componentType;
+	accessor.type = type;
+	accessor.count = count;
+	model.accessors.emplace_back(accessor);
+	return model;
+}
+
+template <typename T>
+void checkBulkConversion(int componentType, int type, int numComponents, size_t byteStride, bool normalize) {
+	auto model = createModel<T>(componentType, type, numComponents, 100, byteStride);
+	glTFBufferData data(model, 0, {}, {});
+
+	std::vector<float> expected{-5.0F};
+	for (size_t index = 0; index < data.accessor_.count; index++) {
+		auto element = normalize ? data.getNormalizedData(index) : data.getConvertedData<float>(index);
+		expected.insert(expected.end(), element.begin(), element.end());
+	}
+
+	std::vector<float> converted{-5.0F};
+	data.appendConvertedData(converted, normalize);
+	EXPECT_EQ(converted, expected);
+}
+
+}  // namespace
+
+TEST(glTFBufferDataTest, bulk_conversion_float) {
+	checkBulkConversion<float>(TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_TYPE_VEC3, 3, 0, false);
+	checkBulkConversion<float>(TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_TYPE_VEC3, 3, 20, false);
+	checkBulkConversion<float>(TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_TYPE_VEC4, 4, 0, true);
+}
+
+TEST(glTFBufferDataTest, bulk_conversion_normalized) {
+	checkBulkConversion<uint8_t>(TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE, TINYGLTF_TYPE_VEC4, 4, 0, true);
+	checkBulkConversion<uint16_t>(TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT, TINYGLTF_TYPE_VEC2, 2, 8, true);
+	checkBulkConversion<int8_t>(TINYGLTF_COMPONENT_TYPE_BYTE, TINYGLTF_TYPE_VEC3, 3, 4, true);
+	checkBulkConversion<int16_t>(TINYGLTF_COMPONENT_TYPE_SHORT, TINYGLTF_TYPE_VEC3, 3, 0, true);
+}
+
+TEST(glTFBufferDataTest, bulk_conversion_unnormalized) {
+	checkBulkConversion<uint8_t>(TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE, TINYGLTF_TYPE_VEC4, 4, 0, false);
+	checkBulkConversion<uint16_t>(TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT, TINYGLTF_TYPE_VEC4, 4, 12, false);
+}
+
+TEST(glTFBufferDataTest, bulk_index_conversion) {
+	auto model = createModel<uint16_t>(TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT, TINYGLTF_TYPE_SCALAR, 1, 50, 0);
+	glTFBufferData data(model, 0, {}, {});
+
+	std::vector<uint32_t> indices{1, 2};
+	data.appendIndexData(indices, 10);
+	ASSERT_EQ(indices.size(), 52u);
+	for (size_t index = 0; index < data.accessor_.count; index++) {
+		EXPECT_EQ(indices[index + 2], data.getConvertedData<uint32_t>(index, false).front() + 10);
+	}
+}
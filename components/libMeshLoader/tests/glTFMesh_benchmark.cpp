@@ -0,0 +1,125 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+// Conversion benchmark on a synthetic glTF mesh, not run as part of the tests:
+//   libMeshLoader_benchmark [vertex count]
+
+#include "mesh_loader/glTFBufferData.h"
+#include "mesh_loader/glTFMesh.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+namespace {
+
+int addAccessor(tinygltf::Model &model, int componentType, int type, size_t count, size_t elementSize, bool normalized) {
+	auto &buffer = model.buffers.front().data;
+	size_t offset = buffer.size();
+	buffer.resize(offset + count * elementSize);
+	for (size_t byte = offset; byte < buffer.size(); byte++) {
+		buffer[byte] = static_cast<unsigned char>((byte * 31) % 251);
+	}
+
+	tinygltf::BufferView view;
+	view.buffer = 0;
+	view.byteOffset = offset;
+	view.byteLength = count * elementSize;
+	model.bufferViews.emplace_back(view);
+
+	tinygltf::Accessor accessor;
+	accessor.bufferView = static_cast<int>(model.bufferViews.size() - 1);
+	accessor.componentType = componentType;
+	accessor.type = type;
+	accessor.count = count;
+	accessor.normalized = normalized;
+	model.accessors.emplace_back(accessor);
+	return static_cast<int>(model.accessors.size() - 1);
+}
+
+void fillFloats(tinygltf::Model &model, int accessorIndex, float scale) {
+	const auto &accessor = model.accessors[accessorIndex];
+	const auto &view = model.bufferViews[accessor.bufferView];
+	auto floats = reinterpret_cast<float *>(&model.buffers.front().data[view.byteOffset]);
+	for (size_t index = 0; index < view.byteLength / sizeof(float); index++) {
+		floats[index] = scale * static_cast<float>((index * 17) % 1000) / 1000.0F + 0.1F;
+	}
+}
+
+tinygltf::Model createMesh(size_t numVertices) {
+	tinygltf::Model model;
+	model.buffers.resize(1);
+	tinygltf::Primitive primitive;
+	primitive.attributes["POSITION"] = addAccessor(model, TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_TYPE_VEC3, numVertices, 12, false);
+	primitive.attributes["NORMAL"] = addAccessor(model, TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_TYPE_VEC3, numVertices, 12, false);
+	primitive.attributes["TANGENT"] = addAccessor(model, TINYGLTF_COMPONENT_TYPE_FLOAT, TINYGLTF_TYPE_VEC4, numVertices, 16, false);
+	primitive.attributes["TEXCOORD_0"] = addAccessor(model, TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT, TINYGLTF_TYPE_VEC2, numVertices, 4, true);
+	primitive.attributes["COLOR_0"] = addAccessor(model, TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE, TINYGLTF_TYPE_VEC4, numVertices, 4, true);
+	primitive.attributes["JOINTS_0"] = addAccessor(model, TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT, TINYGLTF_TYPE_VEC4, numVertices, 8, false);
+	primitive.attributes["WEIGHTS_0"] = addAccessor(model, TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE, TINYGLTF_TYPE_VEC4, numVertices, 4, true);
+	primitive.indices = addAccessor(model, TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT, TINYGLTF_TYPE_SCALAR, numVertices, 4, false);
+	for (const auto &name : {"POSITION", "NORMAL", "TANGENT"}) {
+		fillFloats(model, primitive.attributes[name], 10.0F);
+	}
+	auto indices = reinterpret_cast<uint32_t *>(&model.buffers.front().data[model.bufferViews[model.accessors[primitive.indices].bufferView].byteOffset]);
+	for (size_t index = 0; index < numVertices; index++) {
+		indices[index] = static_cast<uint32_t>((index * 7) % numVertices);
+	}
+
+	tinygltf::Mesh mesh;
+	mesh.primitives.emplace_back(primitive);
+	model.meshes.emplace_back(mesh);
+	return model;
+}
+
+template <typename Function>
+double measure(Function function) {
+	auto start = std::chrono::steady_clock::now();
+	function();
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+	size_t numVertices = argc > 1 ? std::stoul(argv[1]) : 1000000;
+	auto model = createMesh(numVertices);
+	const auto &attributes = model.meshes.front().primitives.front().attributes;
+
+	std::cout << "glTF conversion benchmark, " << numVertices << " vertices" << std::endl;
+	for (const auto &[name, accessorIndex] : attributes) {
+		glTFBufferData data(model, accessorIndex, {}, {});
+		bool normalize = model.accessors[accessorIndex].normalized;
+		std::vector<float> elementWise;
+		auto elementTime = measure([&]() {
+			for (size_t index = 0; index < data.accessor_.count; index++) {
+				auto element = normalize ? data.getNormalizedData(index) : data.getConvertedData<float>(index);
+				elementWise.insert(elementWise.end(), element.begin(), element.end());
+			}
+		});
+		std::vector<float> bulk;
+		auto bulkTime = measure([&]() {
+			data.appendConvertedData(bulk, normalize);
+		});
+		std::cout << "  " << name << ": per element " << elementTime << " ms, bulk " << bulkTime << " ms"
+				  << (elementWise == bulk ? "" : " (MISMATCH)") << std::endl;
+	}
+
+	raco::core::MeshScenegraph sceneGraph;
+	raco::core::MeshDescriptor descriptor{"synthetic", 0, false};
+	size_t numIndices{0};
+	auto meshTime = measure([&]() {
+		raco::mesh_loader::glTFMesh mesh(model, sceneGraph, descriptor);
+		numIndices = mesh.getIndices().size();
+	});
+	std::cout << "  glTFMesh: " << meshTime << " ms, " << numIndices << " indices" << std::endl;
+	return 0;
+}
@@ -45,6 +45,43 @@ namespace py = pybind11;
 namespace {
 raco::application::RaCoApplication* app;
 raco::python_api::PythonRunStatus currentRunStatus;
+// Nesting depth of the raco.batch() blocks being executed.
+int batchDepth = 0;
+
+// Engine update and change dispatch are deferred to the end of the outermost batch.
+void doOneLoop() {
+	if (batchDepth == 0) {
+		app->doOneLoop();
+	}
+}
+
+void checkNotInBatch(std::string_view operation) {
+	if (batchDepth > 0) {
+		throw std::runtime_error(fmt::format("Can not {} project: project-switching Python functions are not allowed inside raco.batch().", operation));
+	}
+}
+
+// Context manager returned by raco.batch(): all changes made inside the with block are recorded as a single
+// undo entry. If the block is left with an exception all of its changes are reverted.
+class PythonBatch {
+public:
+	explicit PythonBatch(std::string description) : description_(std::move(description)) {
+	}
+
+	void enter() {
+		app->activeRaCoProject().undoStack()->beginCompositeCommand();
+		++batchDepth;
+	}
+
+	void exit(bool abort) {
+		--batchDepth;
+		app->activeRaCoProject().undoStack()->endCompositeCommand(description_, abort);
+		doOneLoop();
+	}
+
+private:
+	std::string description_;
+};
 
 py::object python_get_scalar_value(raco::core::ValueHandle handle) {
 	using namespace raco::user_types;
@@ -156,7 +193,7 @@ template <typename T>
 void set_scalar_value_typed(const raco::core::ValueHandle& handle, py::object value, std::string_view typeName) {
 	try {
 		app->activeRaCoProject().commandInterface()->set(handle, value.cast<T>());
-		app->doOneLoop();
+		doOneLoop();
 	} catch (py::cast_error& e) {
 		throw std::runtime_error(fmt::format("Set property '{}': can't convert value of type '{}' to property type '{}'.",
 			handle.getPropertyPath(), py::cast<std::string>(repr(py::type::of(value))), typeName));
@@ -196,6 +233,7 @@ void python_load_project(std::string& path, int featureLevel) {
 	if (app->isRunningInUI()) {
 		throw std::runtime_error(fmt::format("Can not load project: project-switching Python functions currently not allowed in UI."));
 	}
+	checkNotInBatch("load");
 
 	if (!path.empty()) {
 		try {
@@ -225,7 +263,7 @@ void python_import_gltf(const std::string path, const raco::core::SEditorObject
 		throw std::invalid_argument("Unable to import GLTF mesh at " + fileLocation.string());
 	}
 
-	app->doOneLoop();
+	doOneLoop();
 }
 
 raco::core::Project* python_add_external_project(const std::string& path) {
@@ -308,12 +346,139 @@ void setTags(raco::core::SEditorObject obj, std::vector<std::string> tags, std::
 	raco::core::ValueHandle handle(desc);
 	if (handle.query<raco::core::TagContainerAnnotation>() || handle.query<raco::core::UserTagContainerAnnotation>()) {
 		app->activeRaCoProject().commandInterface()->setTags(handle, tags);
-		app->doOneLoop();
+		doOneLoop();
 	} else {
 		throw std::runtime_error(fmt::format("Property '{}' is not a tag container.", desc.getPropertyPath()));
 	}
 }
 
+
+// Values of float properties exported through the buffer protocol, e.g. numpy.asarray(raco.getValues(nodes, "translation")).
+struct ValueBuffer {
+	std::vector<double> data;
+	std::vector<py::ssize_t> shape;
+};
+
+void collectFloatProperties(const raco::core::ValueHandle& handle, std::vector<raco::core::ValueHandle>& outHandles) {
+	if (handle.hasSubstructure()) {
+		for (size_t index = 0; index < handle.size(); index++) {
+			collectFloatProperties(handle[index], outHandles);
+		}
+	} else if (handle.type() == raco::data_storage::PrimitiveType::Double) {
+		outHandles.emplace_back(handle);
+	} else {
+		throw std::runtime_error(fmt::format("Property '{}' is not a float property: bulk access is only supported for float properties.", handle.getPropertyPath()));
+	}
+}
+
+// All float properties of the descriptors in order, every descriptor needs to have the same number of them.
+std::vector<raco::core::ValueHandle> bulkHandles(const std::vector<raco::core::PropertyDescriptor>& descriptors, size_t& outComponents) {
+	std::vector<raco::core::ValueHandle> handles;
+	outComponents = 0;
+	for (size_t index = 0; index < descriptors.size(); index++) {
+		checkProperty(descriptors[index]);
+		auto first = handles.size();
+		collectFloatProperties(raco::core::ValueHandle(descriptors[index]), handles);
+		auto count = handles.size() - first;
+		if (index == 0) {
+			outComponents = count;
+		} else if (count != outComponents) {
+			throw std::runtime_error(fmt::format("Property '{}' of object '{}' has {} values, expected {}.",
+				descriptors[index].getPropertyPath(), descriptors[index].object()->objectName(), count, outComponents));
+		}
+	}
+	return handles;
+}
+
+std::vector<raco::core::PropertyDescriptor> bulkDescriptors(const std::vector<raco::core::SEditorObject>& objects, const std::string& path) {
+	std::vector<std::string> names;
+	std::string::size_type begin = 0;
+	while (true) {
+		auto end = path.find('.', begin);
+		names.emplace_back(path.substr(begin, end - begin));
+		if (end == std::string::npos) {
+			break;
+		}
+		begin = end + 1;
+	}
+	std::vector<raco::core::PropertyDescriptor> descriptors;
+	descriptors.reserve(objects.size());
+	for (const auto& object : objects) {
+		descriptors.emplace_back(object, names);
+	}
+	return descriptors;
+}
+
+template <typename T>
+void appendBufferValues(const py::buffer_info& info, std::vector<double>& values) {
+	std::vector<py::ssize_t> index(info.ndim, 0);
+	for (py::ssize_t count = 0; count < info.size; count++) {
+		auto item = static_cast<const char*>(info.ptr);
+		for (py::ssize_t dim = 0; dim < info.ndim; dim++) {
+			item += index[dim] * info.strides[dim];
+		}
+		values.emplace_back(static_cast<double>(*reinterpret_cast<const T*>(item)));
+		for (auto dim = info.ndim - 1; dim >= 0 && ++index[dim] == info.shape[dim]; dim--) {
+			index[dim] = 0;
+		}
+	}
+}
+
+// Values of a float or integer buffer of any shape in row-major order.
+std::vector<double> bufferValues(py::buffer buffer) {
+	auto info = buffer.request();
+	std::vector<double> values;
+	values.reserve(static_cast<size_t>(info.size));
+	char type = info.format.empty() ? 0 : info.format.back();
+	auto itemSize = static_cast<size_t>(info.itemsize);
+	bool integer = type == 'i' || type == 'l' || type == 'q';
+	if (type == 'd' && itemSize == sizeof(double)) {
+		appendBufferValues<double>(info, values);
+	} else if (type == 'f' && itemSize == sizeof(float)) {
+		appendBufferValues<float>(info, values);
+	} else if (integer && itemSize == sizeof(int32_t)) {
+		appendBufferValues<int32_t>(info, values);
+	} else if (integer && itemSize == sizeof(int64_t)) {
+		appendBufferValues<int64_t>(info, values);
+	} else {
+		throw std::runtime_error(fmt::format("Unsupported buffer format '{}': expected float or integer values.", info.format));
+	}
+	return values;
+}
+
+ValueBuffer python_get_values(const std::vector<raco::core::PropertyDescriptor>& descriptors, bool perObject) {
+	size_t components;
+	auto handles = bulkHandles(descriptors, components);
+	ValueBuffer buffer;
+	buffer.data.reserve(handles.size());
+	for (const auto& handle : handles) {
+		buffer.data.emplace_back(handle.asDouble());
+	}
+	if (!perObject) {
+		buffer.shape = {static_cast<py::ssize_t>(components)};
+	} else if (components == 1) {
+		buffer.shape = {static_cast<py::ssize_t>(descriptors.size())};
+	} else {
+		buffer.shape = {static_cast<py::ssize_t>(descriptors.size()), static_cast<py::ssize_t>(components)};
+	}
+	return buffer;
+}
+
+void python_set_values(const std::vector<raco::core::PropertyDescriptor>& descriptors, py::buffer buffer) {
+	size_t components;
+	auto handles = bulkHandles(descriptors, components);
+	auto values = bufferValues(buffer);
+	if (values.size() != handles.size()) {
+		throw std::runtime_error(fmt::format("Set values: buffer contains {} values, expected {}.", values.size(), handles.size()));
+	}
+	std::vector<std::pair<raco::core::ValueHandle, double>> handleValues;
+	handleValues.reserve(handles.size());
+	for (size_t index = 0; index < handles.size(); index++) {
+		handleValues.emplace_back(handles[index], values[index]);
+	}
+	app->activeRaCoProject().commandInterface()->setValues(handleValues);
+	doOneLoop();
+}
 }  // namespace
 
 PYBIND11_EMBEDDED_MODULE(raco_py_io, m) {
@@ -484,6 +649,7 @@ PYBIND11_EMBEDDED_MODULE(raco, m) {
 		if (app->isRunningInUI()) {
 			throw std::runtime_error(fmt::format("Can not reset project: project-switching Python functions currently not allowed in UI."));
 		}
+		checkNotInBatch("reset");
 
 		app->switchActiveRaCoProject(QString(), {}, false);
 	});
@@ -492,6 +658,7 @@ PYBIND11_EMBEDDED_MODULE(raco, m) {
 		if (app->isRunningInUI()) {
 			throw std::runtime_error(fmt::format("Can not reset project: project-switching Python functions currently not allowed in UI."));
 		}
+		checkNotInBatch("reset");
 
 		app->switchActiveRaCoProject(QString(), {}, false, featureLevel);
 	});
@@ -655,6 +822,12 @@ PYBIND11_EMBEDDED_MODULE(raco, m) {
 			} else {
 				throw std::runtime_error(fmt::format("Can't read property value: '{}' is not a scalar property.", desc.getPropertyPath()));
 			}
+		})
+		.def("values", [](const raco::core::PropertyDescriptor& desc) {
+			return python_get_values({desc}, false);
+		})
+		.def("setValues", [](const raco::core::PropertyDescriptor& desc, py::buffer buffer) {
+			python_set_values({desc}, buffer);
 		});
 
 	py::class_<raco::core::EditorObject, raco::core::SEditorObject>(m, "EditorObject")
@@ -765,10 +938,30 @@ PYBIND11_EMBEDDED_MODULE(raco, m) {
 			raco::core::ValueHandle handle(obj, &raco::user_types::RenderLayer::renderableTags_);
 			if (handle) {
 				app->activeRaCoProject().commandInterface()->setRenderableTags(handle, renderables);
-				app->doOneLoop();
+				doOneLoop();
 			}
 		});
 
+	py::class_<ValueBuffer>(m, "ValueBuffer", py::buffer_protocol())
+		.def_buffer([](ValueBuffer& buffer) -> py::buffer_info {
+			std::vector<py::ssize_t> strides(buffer.shape.size(), sizeof(double));
+			for (auto dim = static_cast<int>(buffer.shape.size()) - 2; dim >= 0; dim--) {
+				strides[dim] = strides[dim + 1] * buffer.shape[dim + 1];
+			}
+			return py::buffer_info(buffer.data.data(), sizeof(double), py::format_descriptor<double>::format(), buffer.shape.size(), buffer.shape, strides);
+		})
+		.def("__len__", [](const ValueBuffer& buffer) {
+			return buffer.shape.front();
+		});
+
+	m.def("getValues", [](const std::vector<raco::core::SEditorObject>& objects, const std::string& path) {
+		return python_get_values(bulkDescriptors(objects, path), true);
+	});
+
+	m.def("setValues", [](const std::vector<raco::core::SEditorObject>& objects, const std::string& path, py::buffer buffer) {
+		python_set_values(bulkDescriptors(objects, path), buffer);
+	});
+
 	py::class_<raco::core::LinkDescriptor>(m, "LinkDescriptor")
 		.def("__repr__", [](const raco::core::LinkDescriptor& desc) {
 			return fmt::format("<Link: start='{}' end='{}' valid='{}' weak='{}'>", desc.start.getPropertyPath(), desc.end.getPropertyPath(), desc.isValid, desc.isWeak);
@@ -779,35 +972,51 @@ PYBIND11_EMBEDDED_MODULE(raco, m) {
 		.def_readonly("valid", &raco::core::LinkDescriptor::isValid)
 		.def_readonly("weak", &raco::core::LinkDescriptor::isWeak);
 
+	py::class_<PythonBatch>(m, "Batch")
+		.def("__enter__", [](PythonBatch& batch) {
+			batch.enter();
+		})
+		.def("__exit__", [](PythonBatch& batch, py::object excType, py::object excValue, py::object traceback) {
+			batch.exit(!excType.is_none());
+		});
+
+	m.def("batch", []() {
+		return PythonBatch("Python batch");
+	});
+
+	m.def("batch", [](std::string description) {
+		return PythonBatch(description);
+	});
+
 	m.def("instances", []() {
 		return app->activeRaCoProject().project()->instances();
 	});
 
 	m.def("create", [](std::string typeName, std::string objectName) {
 		auto object = app->activeRaCoProject().commandInterface()->createObject(typeName, objectName);
-		app->doOneLoop();
+		doOneLoop();
 		return object;
 	});
 
 	m.def("delete", [](raco::core::SEditorObject obj) {
 		auto result = app->activeRaCoProject().commandInterface()->deleteObjects({obj});
-		app->doOneLoop();
+		doOneLoop();
 		return result;
 	});
 
 	m.def("delete", [](std::vector<raco::core::SEditorObject> objects) {
 		auto result = app->activeRaCoProject().commandInterface()->deleteObjects(objects);
-		app->doOneLoop();
+		doOneLoop();
 		return result;
 	});
 
 	m.def("moveScenegraph", [](raco::core::SEditorObject object, raco::core::SEditorObject newParent) {
 		app->activeRaCoProject().commandInterface()->moveScenegraphChildren({object}, newParent);
-		app->doOneLoop();
+		doOneLoop();
 	});
 	m.def("moveScenegraph", [](raco::core::SEditorObject object, raco::core::SEditorObject newParent, int insertBeforeIndex) {
 		app->activeRaCoProject().commandInterface()->moveScenegraphChildren({object}, newParent, insertBeforeIndex);
-		app->doOneLoop();
+		doOneLoop();
 	});
 
 	m.def("links", []() {
@@ -829,7 +1038,7 @@ PYBIND11_EMBEDDED_MODULE(raco, m) {
 
 	m.def("addLink", [](const raco::core::PropertyDescriptor& start, const raco::core::PropertyDescriptor& end) -> py::object {
 		if (auto newLink = app->activeRaCoProject().commandInterface()->addLink(raco::core::ValueHandle(start), raco::core::ValueHandle(end))) {
-			app->doOneLoop();
+			doOneLoop();
 			return py::cast(newLink->descriptor());
 		}
 		return py::none();
@@ -837,7 +1046,7 @@ PYBIND11_EMBEDDED_MODULE(raco, m) {
 
 	m.def("addLink", [](const raco::core::PropertyDescriptor& start, const raco::core::PropertyDescriptor& end, bool isWeak) -> py::object {
 		if (auto newLink = app->activeRaCoProject().commandInterface()->addLink(raco::core::ValueHandle(start), raco::core::ValueHandle(end), isWeak)) {
-			app->doOneLoop();
+			doOneLoop();
 			return py::cast(newLink->descriptor());
 		}
 		return py::none();
@@ -845,7 +1054,7 @@ PYBIND11_EMBEDDED_MODULE(raco, m) {
 
 	m.def("removeLink", [](const raco::core::PropertyDescriptor& end) {
 		app->activeRaCoProject().commandInterface()->removeLink(end);
-		app->doOneLoop();
+		doOneLoop();
 	});
 
 	m.def("getInstanceById", [](const std::string& id) -> py::object {
@@ -971,6 +1180,7 @@ bool preparePythonEnvironment(std::wstring argv0, const std::vector<std::wstring
 
 void setup(raco::application::RaCoApplication* racoApp) {
 	::app = racoApp;
+	::batchDepth = 0;
 
 	const std::wstring pythonPaths = Py_GetPath();
 	std::string pythonPathsUTF8(1024, 0);
@@ -980,6 +1190,25 @@ void setup(raco::application::RaCoApplication* racoApp) {
 	py::module::import("raco_py_io").attr("hook_stdout")();
 }
 
+namespace {
+
+class AsyncMeshLoadingGuard {
+public:
+	explicit AsyncMeshLoadingGuard(raco::application::RaCoApplication* app) : app_(app), async_(app->asyncMeshLoading()) {
+		app_->setAsyncMeshLoading(false);
+	}
+
+	~AsyncMeshLoadingGuard() {
+		app_->setAsyncMeshLoading(async_);
+	}
+
+private:
+	raco::application::RaCoApplication* app_;
+	bool async_;
+};
+
+}  // namespace
+
 PythonRunStatus runPythonScript(raco::application::RaCoApplication* app, const std::wstring& applicationPath, const std::string& pythonScriptPath, const std::vector<std::wstring>& pythonSearchPaths, const std::vector<const char*>& pos_argv_cp) {
 	currentRunStatus.stdOutBuffer.clear();
 	currentRunStatus.stdErrBuffer.clear();
@@ -988,6 +1217,8 @@ PythonRunStatus runPythonScript(raco::application::RaCoApplication* app, const s
 		py::scoped_interpreter pyGuard{true, static_cast<int>(pos_argv_cp.size()), pos_argv_cp.data()};
 
 		raco::python_api::setup(app);
+		// Scripts expect meshes to be loaded when the call which triggered the load returns.
+		AsyncMeshLoadingGuard asyncMeshLoadingGuard(app);
 		currentRunStatus.stdOutBuffer.append(fmt::format("running python script {}\n\n", pythonScriptPath));
 		try {
 			py::eval_file(pythonScriptPath);
@@ -34,11 +34,15 @@ public:
 	std::vector<ExportInformation> getExportInformation() const override;
 
 private:
+	raco::ramses_base::RamsesArrayResource sharedArrayResource(ramses::EDataType type, uint32_t numElements, const void* arrayData, const std::string& nameSuffix);
+
 	VertexDataMap vertexDataMap_;
 	raco::ramses_base::RamsesArrayResource indices_;
 	core::FileChangeMonitor::UniqueListener meshFileChangeListener_;
 	components::Subscription subscription_;
 	components::Subscription nameSubscription_;
+	// Object name the buffer names were created from
+	std::string bufferNamePrefix_;
 };
 
 };	// namespace raco::ramses_adaptor
@@ -14,7 +14,11 @@
 #include "ramses_base/LogicEngine.h"
 #include "ramses_base/RamsesHandles.h"
 #include "components/DataChangeDispatcher.h"
+#include <array>
 #include <map>
+#include <set>
+#include <tuple>
+#include <vector>
 #include "core/Link.h"
 
 namespace raco::ramses_adaptor {
@@ -45,8 +49,13 @@ public:
 	const ramses_base::RamsesAppearance defaultAppearance(bool withMeshNormals);
 	const ramses_base::RamsesArrayResource defaultVertices();
 	const ramses_base::RamsesArrayResource defaultIndices();
+	// Array resource with the given content, shared by all adaptors which request identical data.
+	// The name is only used if no resource with this content exists yet.
+	ramses_base::RamsesArrayResource sharedArrayResource(ramses::EDataType type, uint32_t numElements, const void* arrayData, const std::string& name);
 	ObjectAdaptor* lookupAdaptor(const core::SEditorObject& editorObject) const;
 	Project& project() const;
+	// Called by ObjectAdaptor::tagDirty: only dirty adaptors and the adaptors depending on them are visited in the next update.
+	void adaptorDirty(ObjectAdaptor* adaptor);
 
 	template <class T>
 	T* lookup(const core::SEditorObject& editorObject) const {
@@ -69,18 +78,15 @@ private:
 	void removeLink(const core::LinkDescriptor& link);
 	void createAdaptor(SEditorObject obj);
 	void removeAdaptor(SEditorObject obj);
+	void removeObject(SEditorObject obj);
 
 	void performBulkEngineUpdate(const core::SEditorObjectSet& changedObjects);
 
-	struct DependencyNode {
-		SEditorObject object;
-		SEditorObjectSet referencedObjects;
-	};
-
-	void depthFirstSearch(data_storage::ReflectionInterface* object, DependencyNode& item, SEditorObjectSet const& instances, SEditorObjectSet& sortedObjs, std::vector<DependencyNode>& outSorted);
-
-	void depthFirstSearch(SEditorObject object, SEditorObjectSet const& instances, SEditorObjectSet& sortedObjs, std::vector<DependencyNode>& outSorted);
-	void rebuildSortedDependencyGraph(SEditorObjectSet const& objects);
+	void collectReferences(const data_storage::ReflectionInterface* object, SEditorObjectSet& outReferences) const;
+	void updateReferences(const SEditorObject& object);
+	void removeReferences(const SEditorObject& object);
+	void sortDependencies(const SEditorObject& object, const SEditorObjectSet& affected, SEditorObjectSet& visited, std::vector<SEditorObject>& outSorted) const;
+	void checkRenderOrder();
 
 	void updateRuntimeErrorList();
 
@@ -103,6 +109,23 @@ private:
 	ramses_base::RamsesArrayResource defaultIndices_{};
 	ramses_base::RamsesArrayResource defaultVertices_{};
 
+	struct ArrayResourceKey {
+		ramses::EDataType type;
+		uint32_t numElements;
+		std::array<uint64_t, 2> contentHash;
+
+		bool operator<(const ArrayResourceKey& other) const {
+			return std::tie(type, numElements, contentHash) < std::tie(other.type, other.numElements, other.contentHash);
+		}
+	};
+	struct SharedArrayResource {
+		// Copy of the resource content, a hash match is only shared if the bytes are equal as well.
+		std::vector<unsigned char> data;
+		// Not owning: the resource is deleted as soon as the last adaptor using it releases it.
+		std::weak_ptr<ramses::ArrayResource> resource;
+	};
+	std::map<ArrayResourceKey, SharedArrayResource> sharedArrayResources_;
+
 	std::map<SEditorObject, std::unique_ptr<ObjectAdaptor>> adaptors_{};
 	
 	struct LinkAdaptorContainer {
@@ -120,8 +143,12 @@ private:
 	SRamsesAdaptorDispatcher dispatcher_;
 
 	bool adaptorStatusDirty_ = false;
+	bool renderOrderDirty_ = true;
 
-	std::vector<DependencyNode> dependencyGraph_;
+	// Instances referenced by each instance and the reverse relation, updated from the created, changed and deleted objects.
+	std::map<SEditorObject, SEditorObjectSet> references_;
+	std::map<SEditorObject, SEditorObjectSet> referencingObjects_;
+	std::set<ObjectAdaptor*> dirtyAdaptors_;
 };
 
 }  // namespace raco::ramses_adaptor
@@ -43,23 +43,34 @@ bool MeshAdaptor::isValid() {
 	return mesh.get() != nullptr;
 }
 
+raco::ramses_base::RamsesArrayResource MeshAdaptor::sharedArrayResource(ramses::EDataType type, uint32_t numElements, const void* arrayData, const std::string& nameSuffix) {
+	auto name = editorObject_->objectName() + nameSuffix;
+	auto resource = sceneAdaptor_->sharedArrayResource(type, numElements, arrayData, name);
+	// Identical buffers of several meshes keep the name of the mesh which created them - unless that mesh was renamed.
+	if (resource && !bufferNamePrefix_.empty() && bufferNamePrefix_ + nameSuffix == resource->getName()) {
+		resource->setName(name.c_str());
+	}
+	return resource;
+}
+
 bool MeshAdaptor::sync(core::Errors* errors) {
 	ObjectAdaptor::sync(errors);
 	if (isValid()) {
 		auto mesh = editorObject_->meshData();
-		auto indices = mesh->getIndices();
-		indices_ = ramsesArrayResource(sceneAdaptor_->scene(), ramses::EDataType::UInt32, static_cast<uint32_t>(indices.size()), indices.data());
-		indices_->setName(std::string(this->editorObject_->objectName() + "_MeshIndexData").c_str());
+		indices_.reset();
+		vertexDataMap_.clear();
 
+		const auto& indices = mesh->getIndices();
+		indices_ = sharedArrayResource(ramses::EDataType::UInt32, static_cast<uint32_t>(indices.size()), indices.data(), "_MeshIndexData");
 
 		for (uint32_t i{0}; i < mesh->numAttributes(); i++) {
 			auto name = mesh->attribName(i);
 			auto type = mesh->attribDataType(i);
 			auto buffer = mesh->attribBuffer(i);
 			auto elementCount = mesh->attribElementCount(i);
-			vertexDataMap_[name] = ramsesArrayResource(sceneAdaptor_->scene(), convert(type), elementCount, buffer);
-			vertexDataMap_[name]->setName(std::string(this->editorObject_->objectName() + "_MeshVertexData_" + name).c_str());
+			vertexDataMap_[name] = sharedArrayResource(convert(type), elementCount, buffer, "_MeshVertexData_" + name);
 		}
+		bufferNamePrefix_ = editorObject_->objectName();
 	} else {
 		vertexDataMap_.clear();
 		indices_.reset();
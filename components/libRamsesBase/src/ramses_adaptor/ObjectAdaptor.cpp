@@ -27,6 +27,9 @@ bool ObjectAdaptor::isDirty() const {
 
 void ObjectAdaptor::tagDirty(bool newStatus) {
 	dirtyStatus_ = newStatus;
+	if (newStatus && sceneAdaptor_) {
+		sceneAdaptor_->adaptorDirty(this);
+	}
 }
 
 }  // namespace raco::ramses_adaptor
\ No newline at end of file
@@ -34,6 +34,7 @@
 #include <spdlog/fmt/fmt.h>
 
 #include <algorithm>
+#include <cstring>
 #include <map>
 #include <memory>
 #include <unordered_set>
@@ -88,12 +89,67 @@ inline RamsesArrayResource createDefaultVertexDataBuffer(ramses::Scene* scene) {
 	return ramsesArrayResource(scene, ramses::EDataType::Vector3F, static_cast<uint32_t>(vertices.size()), vertices.data(), defaultVertexDataBufferName);
 }
 
+namespace {
+
+size_t dataTypeSize(ramses::EDataType type) {
+	switch (type) {
+		case ramses::EDataType::UInt16:
+			return sizeof(uint16_t);
+		case ramses::EDataType::UInt32:
+		case ramses::EDataType::Float:
+			return sizeof(uint32_t);
+		case ramses::EDataType::Vector2F:
+			return 2 * sizeof(float);
+		case ramses::EDataType::Vector3F:
+			return 3 * sizeof(float);
+		case ramses::EDataType::Vector4F:
+			return 4 * sizeof(float);
+		default:
+			// Not shared
+			return 0;
+	}
+}
+
+uint64_t mixHash(uint64_t value) {
+	value ^= value >> 33;
+	value *= 0xff51afd7ed558ccdULL;
+	value ^= value >> 33;
+	value *= 0xc4ceb9fe1a85ec53ULL;
+	value ^= value >> 33;
+	return value;
+}
+
+// Two independently seeded 64 bit hashes of the data: identical resources are detected without keeping a copy of their content.
+std::array<uint64_t, 2> contentHash(const void* data, size_t size) {
+	auto bytes = static_cast<const unsigned char*>(data);
+	uint64_t h0 = 0x9e3779b97f4a7c15ULL ^ size;
+	uint64_t h1 = 0xcbf29ce484222325ULL + size;
+	auto combine = [&h0, &h1](uint64_t word) {
+		h0 = mixHash(h0 ^ word) + 0x9e3779b97f4a7c15ULL;
+		h1 = (h1 ^ mixHash(word + 0x632be59bd9b4e019ULL)) * 0x100000001b3ULL;
+	};
+	size_t pos = 0;
+	for (; pos + sizeof(uint64_t) <= size; pos += sizeof(uint64_t)) {
+		uint64_t word;
+		std::memcpy(&word, bytes + pos, sizeof(uint64_t));
+		combine(word);
+	}
+	if (pos < size) {
+		uint64_t word = 0;
+		std::memcpy(&word, bytes + pos, size - pos);
+		combine(word);
+	}
+	return {mixHash(h0), mixHash(h1)};
+}
+
+}  // namespace
+
 SceneAdaptor::SceneAdaptor(ramses::RamsesClient* client, ramses_base::LogicEngine* logicEngine, ramses::sceneId_t id, Project* project, components::SDataChangeDispatcher dispatcher, core::Errors* errors, bool optimizeForExport)
 	: client_{client},
 	  logicEngine_{logicEngine},
 	  project_(project),
 	  scene_{ramsesScene(id, client_)},
-	  subscription_{dispatcher->registerOnObjectsLifeCycle([this](SEditorObject obj) { createAdaptor(obj); }, [this](SEditorObject obj) { removeAdaptor(obj); })},
+	  subscription_{dispatcher->registerOnObjectsLifeCycle([this](SEditorObject obj) { createAdaptor(obj); }, [this](SEditorObject obj) { removeObject(obj); })},
 	  childrenSubscription_(dispatcher->registerOnPropertyChange("children", [this](core::ValueHandle handle) {
 	adaptorStatusDirty_ = true; 
 		  })),
@@ -147,6 +203,7 @@ void SceneAdaptor::createAdaptor(SEditorObject obj) {
 	if (needAdaptor(obj)) {
 		auto adaptor = Factories::createAdaptor(this, obj);
 		if (adaptor) {
+			dirtyAdaptors_.erase(lookupAdaptor(obj));
 			adaptor->tagDirty();
 			adaptors_[obj] = std::move(adaptor);
 		}
@@ -154,13 +211,22 @@ void SceneAdaptor::createAdaptor(SEditorObject obj) {
 }
 
 void SceneAdaptor::removeAdaptor(SEditorObject obj) {
-	auto adaptorWasLogicProvider = dynamic_cast<ILogicPropertyProvider*>(lookupAdaptor(obj)) != nullptr;
+	auto adaptor = lookupAdaptor(obj);
+	auto adaptorWasLogicProvider = dynamic_cast<ILogicPropertyProvider*>(adaptor) != nullptr;
+	dirtyAdaptors_.erase(adaptor);
 	adaptors_.erase(obj);
 	deleteUnusedDefaultResources();
 	if (adaptorWasLogicProvider) {
 		updateRuntimeErrorList();
 	}
-	dependencyGraph_.clear();
+}
+
+void SceneAdaptor::removeObject(SEditorObject obj) {
+	removeAdaptor(obj);
+	removeReferences(obj);
+	if (obj->isType<user_types::RenderPass>() || obj->isType<user_types::BlitPass>()) {
+		renderOrderDirty_ = true;
+	}
 }
 
 void SceneAdaptor::iterateAdaptors(std::function<void(ObjectAdaptor*)> func) {
@@ -259,6 +325,13 @@ void SceneAdaptor::deleteUnusedDefaultResources() {
 	if (defaultVertices_.use_count() == 1) {
 		defaultVertices_.reset();
 	}
+	for (auto it = sharedArrayResources_.begin(); it != sharedArrayResources_.end();) {
+		if (it->second.resource.expired()) {
+			it = sharedArrayResources_.erase(it);
+		} else {
+			++it;
+		}
+	}
 }
 
 void SceneAdaptor::readDataFromEngine(core::DataChangeRecorder& recorder) {
@@ -353,6 +426,32 @@ const RamsesArrayResource SceneAdaptor::defaultIndices() {
 	return defaultIndices_;
 }
 
+RamsesArrayResource SceneAdaptor::sharedArrayResource(ramses::EDataType type, uint32_t numElements, const void* arrayData, const std::string& name) {
+	auto elementSize = dataTypeSize(type);
+	if (elementSize == 0 || numElements == 0) {
+		return ramsesArrayResource(scene_.get(), type, numElements, arrayData, name.c_str());
+	}
+
+	auto size = elementSize * numElements;
+	ArrayResourceKey key{type, numElements, contentHash(arrayData, size)};
+	auto it = sharedArrayResources_.find(key);
+	if (it != sharedArrayResources_.end()) {
+		if (auto resource = it->second.resource.lock()) {
+			if (std::memcmp(it->second.data.data(), arrayData, size) == 0) {
+				return resource;
+			}
+			// Hash collision: the pooled resource stays shared, the new content gets a resource of its own.
+			return ramsesArrayResource(scene_.get(), type, numElements, arrayData, name.c_str());
+		}
+	}
+	auto resource = ramsesArrayResource(scene_.get(), type, numElements, arrayData, name.c_str());
+	if (resource) {
+		auto bytes = static_cast<const unsigned char*>(arrayData);
+		sharedArrayResources_[key] = SharedArrayResource{std::vector<unsigned char>(bytes, bytes + size), resource};
+	}
+	return resource;
+}
+
 ObjectAdaptor* SceneAdaptor::lookupAdaptor(const core::SEditorObject& editorObject) const {
 	if (!editorObject) {
 		return nullptr;
@@ -368,53 +467,121 @@ raco::core::Project& SceneAdaptor::project() const {
 	return *project_;
 }
 
-void SceneAdaptor::depthFirstSearch(data_storage::ReflectionInterface* object, DependencyNode& item, SEditorObjectSet const& instances, SEditorObjectSet& sortedObjs, std::vector<DependencyNode>& outSorted) {
+void SceneAdaptor::adaptorDirty(ObjectAdaptor* adaptor) {
+	dirtyAdaptors_.insert(adaptor);
+}
+
+void SceneAdaptor::collectReferences(const data_storage::ReflectionInterface* object, SEditorObjectSet& outReferences) const {
 	for (size_t index = 0; index < object->size(); index++) {
 		auto v = (*object)[index];
 		switch (v->type()) {
 			case data_storage::PrimitiveType::Ref: {
 				auto refValue = v->asRef();
-				if (refValue && instances.find(refValue) != instances.end()) {
-					depthFirstSearch(refValue, instances, sortedObjs, outSorted);
-					item.referencedObjects.insert(refValue);
+				if (refValue && project_->isInstance(refValue)) {
+					outReferences.insert(refValue);
 				}
 				break;
 			}
 			case data_storage::PrimitiveType::Table:
-				depthFirstSearch(&v->asTable(), item, instances, sortedObjs, outSorted);
+				collectReferences(&v->asTable(), outReferences);
 				break;
 		}
 	}
 }
 
-void SceneAdaptor::depthFirstSearch(SEditorObject object, SEditorObjectSet const& instances, SEditorObjectSet& sortedObjs, std::vector<DependencyNode>& outSorted) {
-	using namespace raco::core;
+void SceneAdaptor::updateReferences(const SEditorObject& object) {
+	SEditorObjectSet references;
+	collectReferences(object.get(), references);
 
-	if (sortedObjs.find(object) != sortedObjs.end()) {
-		return;
+	auto& current = references_[object];
+	for (const auto& oldRef : current) {
+		if (references.find(oldRef) == references.end()) {
+			auto it = referencingObjects_.find(oldRef);
+			if (it != referencingObjects_.end()) {
+				it->second.erase(object);
+				if (it->second.empty()) {
+					referencingObjects_.erase(it);
+				}
+			}
+		}
+	}
+	for (const auto& newRef : references) {
+		if (current.find(newRef) == current.end()) {
+			referencingObjects_[newRef].insert(object);
+		}
 	}
+	current = std::move(references);
+}
 
-	DependencyNode item;
-	item.object = object;
-	depthFirstSearch(object.get(), item, instances, sortedObjs, outSorted);
+void SceneAdaptor::removeReferences(const SEditorObject& object) {
+	auto refIt = references_.find(object);
+	if (refIt != references_.end()) {
+		for (const auto& ref : refIt->second) {
+			auto it = referencingObjects_.find(ref);
+			if (it != referencingObjects_.end()) {
+				it->second.erase(object);
+				if (it->second.empty()) {
+					referencingObjects_.erase(it);
+				}
+			}
+		}
+		references_.erase(refIt);
+	}
+
+	// References to deleted objects are normally reset before the deletion is dispatched: only stale entries are left here.
+	auto referencingIt = referencingObjects_.find(object);
+	if (referencingIt != referencingObjects_.end()) {
+		for (const auto& referencing : referencingIt->second) {
+			auto it = references_.find(referencing);
+			if (it != references_.end()) {
+				it->second.erase(object);
+			}
+		}
+		referencingObjects_.erase(referencingIt);
+	}
+}
 
-	outSorted.emplace_back(item);
-	sortedObjs.insert(item.object);
+void SceneAdaptor::sortDependencies(const SEditorObject& object, const SEditorObjectSet& affected, SEditorObjectSet& visited, std::vector<SEditorObject>& outSorted) const {
+	if (!visited.insert(object).second) {
+		return;
+	}
+	auto it = references_.find(object);
+	if (it != references_.end()) {
+		for (const auto& ref : it->second) {
+			if (affected.find(ref) != affected.end()) {
+				sortDependencies(ref, affected, visited, outSorted);
+			}
+		}
+	}
+	outSorted.emplace_back(object);
 }
 
-void SceneAdaptor::rebuildSortedDependencyGraph(SEditorObjectSet const& objects) {
-	dependencyGraph_.clear();
-	dependencyGraph_.reserve(objects.size());
-	SEditorObjectSet sortedObjs;
-	for (auto obj : objects) {
-		depthFirstSearch(obj, objects, sortedObjs, dependencyGraph_);
+void SceneAdaptor::checkRenderOrder() {
+	// Check if all render passes have a unique order index, otherwise Ramses renders them in arbitrary order.
+	errors_->removeIf([](core::ErrorItem const& error) {
+		return error.valueHandle().isRefToProp(&user_types::RenderPass::renderOrder_) || error.valueHandle().isRefToProp(&user_types::BlitPass::renderOrder_);
+	});
+
+	std::map<int, std::vector<raco::core::SEditorObject>> orderIndices;
+	for (auto const& typeName : {user_types::RenderPass::typeDescription.typeName, user_types::BlitPass::typeDescription.typeName}) {
+		for (auto const& obj : project_->instancesOfType(typeName)) {
+			int order = obj->get("renderOrder")->asInt();
+			orderIndices[order].emplace_back(obj);
+		}
+	}
+	for (auto const& oi : orderIndices) {
+		if (oi.second.size() > 1) {
+			auto errorMsg = fmt::format("The render/blit passes {} have the same order index and will be rendered in arbitrary order.", oi.second);
+			for (auto const& obj : oi.second) {
+				errors_->addError(core::ErrorCategory::GENERAL, core::ErrorLevel::WARNING, ValueHandle{obj, {"renderOrder"}}, errorMsg);
+			}
+		}
 	}
 }
 
 void SceneAdaptor::performBulkEngineUpdate(const core::SEditorObjectSet& changedObjects) {
 	if (adaptorStatusDirty_) {
-		for (const auto& item : dependencyGraph_) {
-			auto object = item.object;
+		for (const auto& object : project_->instances()) {
 			auto adaptor = lookupAdaptor(object);
 
 			bool haveAdaptor = adaptor != nullptr;
@@ -435,38 +602,57 @@ void SceneAdaptor::performBulkEngineUpdate(const core::SEditorObjectSet& changed
 		adaptorStatusDirty_ = false;
 	}
 
-	if (dependencyGraph_.empty() || !changedObjects.empty()) {
-		rebuildSortedDependencyGraph(SEditorObjectSet(project_->instances().begin(), project_->instances().end()));
-		// Check if all render passes have a unique order index, otherwise Ramses renders them in arbitrary order.
-		errors_->removeIf([](core::ErrorItem const& error) {
-			return error.valueHandle().isRefToProp(&user_types::RenderPass::renderOrder_) || error.valueHandle().isRefToProp(&user_types::BlitPass::renderOrder_);
-		});
-
-		std::map<int, std::vector<raco::core::SEditorObject>> orderIndices;
-		for (auto const& obj : project_->instances()) {
-			if (obj->isType<raco::user_types::RenderPass>() || obj->isType<raco::user_types::BlitPass>()) {
-				int order = obj->get("renderOrder")->asInt();
-				orderIndices[order].emplace_back(obj);
+	for (const auto& object : changedObjects) {
+		if (project_->isInstance(object)) {
+			updateReferences(object);
+			if (object->isType<user_types::RenderPass>() || object->isType<user_types::BlitPass>()) {
+				renderOrderDirty_ = true;
 			}
 		}
-		for (auto const& oi : orderIndices) {
-			if (oi.second.size() > 1) {				
-				auto errorMsg = fmt::format("The render/blit passes {} have the same order index and will be rendered in arbitrary order.", oi.second);
-				for (auto const& obj : oi.second) {
-					errors_->addError(core::ErrorCategory::GENERAL, core::ErrorLevel::WARNING, ValueHandle{obj, {"renderOrder"}}, errorMsg);
-				}
-			}
+	}
+
+	if (renderOrderDirty_) {
+		checkRenderOrder();
+		renderOrderDirty_ = false;
+	}
+
+	// Only the dirty adaptors and the objects (transitively) referencing them can need an update.
+	SEditorObjectSet affected;
+	std::vector<SEditorObject> stack;
+	for (auto adaptor : dirtyAdaptors_) {
+		if (adaptor->isDirty()) {
+			stack.emplace_back(adaptor->baseEditorObject());
 		}
 	}
+	dirtyAdaptors_.clear();
+	while (!stack.empty()) {
+		auto object = stack.back();
+		stack.pop_back();
+		if (!project_->isInstance(object) || !affected.insert(object).second) {
+			continue;
+		}
+		auto it = referencingObjects_.find(object);
+		if (it != referencingObjects_.end()) {
+			stack.insert(stack.end(), it->second.begin(), it->second.end());
+		}
+	}
+
+	std::vector<SEditorObject> sortedObjects;
+	sortedObjects.reserve(affected.size());
+	SEditorObjectSet visited;
+	for (const auto& object : affected) {
+		sortDependencies(object, affected, visited, sortedObjects);
+	}
+
 	std::set<LinkAdaptor*> liftedLinks;
 
 	SEditorObjectSet updated;
-	for (const auto& item : dependencyGraph_) {
-		auto object = item.object;
+	for (const auto& object : sortedObjects) {
 		if (auto adaptor = lookupAdaptor(object)) {
 			bool needsUpdate = adaptor->isDirty();
 			if (!needsUpdate) {
-				needsUpdate = std::any_of(item.referencedObjects.begin(), item.referencedObjects.end(),
+				const auto& referencedObjects = references_[object];
+				needsUpdate = std::any_of(referencedObjects.begin(), referencedObjects.end(),
 					[&updated](SEditorObject const& object) {
 						return updated.find(object) != updated.end();
 					});
@@ -503,6 +689,14 @@ void SceneAdaptor::performBulkEngineUpdate(const core::SEditorObjectSet& changed
 		link->connect();
 	}
 
+	// Adaptors which stay dirty after their sync are retried in the next update.
+	for (const auto& object : sortedObjects) {
+		auto adaptor = lookupAdaptor(object);
+		if (adaptor && adaptor->isDirty()) {
+			dirtyAdaptors_.insert(adaptor);
+		}
+	}
+
 	for (const auto& newLink : newLinks_) {
 		auto adaptor = std::make_shared<LinkAdaptor>(newLink, this);
 		links_.linksByStart_[newLink.start.object()->objectID()][newLink] = adaptor;
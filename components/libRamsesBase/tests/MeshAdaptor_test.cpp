@@ -76,4 +76,74 @@ TEST_F(MeshAdaptorTest, gltf_with_meshes_but_no_mesh_refs_unbaked) {
 	ASSERT_TRUE(isRamsesNameInArray("Mesh Name_MeshVertexData_a_Normal", meshStuff));
 	ASSERT_TRUE(isRamsesNameInArray("Mesh Name_MeshVertexData_a_TextureCoordinate", meshStuff));
 	ASSERT_EQ(context.errors().getError(mesh).level(), raco::core::ErrorLevel::INFORMATION);
-}
\ No newline at end of file
+}
+
+TEST_F(MeshAdaptorTest, identical_meshes_share_buffers) {
+	auto mesh1 = context.createObject(raco::user_types::Mesh::typeDescription.typeName, "Mesh 1");
+	auto mesh2 = context.createObject(raco::user_types::Mesh::typeDescription.typeName, "Mesh 2");
+	context.set({mesh1, &raco::user_types::Mesh::uri_}, test_path().append("meshes/Duck.glb").string());
+	context.set({mesh2, &raco::user_types::Mesh::uri_}, test_path().append("meshes/Duck.glb").string());
+
+	dispatch();
+
+	auto meshStuff{select<ramses::ArrayResource>(*sceneContext.scene(), ramses::ERamsesObjectType::ERamsesObjectType_ArrayResource)};
+	EXPECT_EQ(meshStuff.size(), 4);
+
+	auto adaptor1 = sceneContext.lookup<raco::ramses_adaptor::MeshAdaptor>(mesh1);
+	auto adaptor2 = sceneContext.lookup<raco::ramses_adaptor::MeshAdaptor>(mesh2);
+	ASSERT_NE(adaptor1->indicesPtr(), nullptr);
+	EXPECT_EQ(adaptor1->indicesPtr(), adaptor2->indicesPtr());
+	EXPECT_EQ(adaptor1->vertexData().at("a_Position"), adaptor2->vertexData().at("a_Position"));
+
+	context.deleteObjects({mesh1});
+	dispatch();
+
+	meshStuff = select<ramses::ArrayResource>(*sceneContext.scene(), ramses::ERamsesObjectType::ERamsesObjectType_ArrayResource);
+	EXPECT_EQ(meshStuff.size(), 4);
+
+	context.deleteObjects({mesh2});
+	dispatch();
+
+	meshStuff = select<ramses::ArrayResource>(*sceneContext.scene(), ramses::ERamsesObjectType::ERamsesObjectType_ArrayResource);
+	EXPECT_EQ(meshStuff.size(), 0);
+}
+
+TEST_F(MeshAdaptorTest, different_meshes_dont_share_buffers) {
+	auto mesh1 = context.createObject(raco::user_types::Mesh::typeDescription.typeName, "Mesh 1");
+	auto mesh2 = context.createObject(raco::user_types::Mesh::typeDescription.typeName, "Mesh 2");
+	context.set({mesh1, &raco::user_types::Mesh::uri_}, test_path().append("meshes/Duck.glb").string());
+	context.set({mesh2, &raco::user_types::Mesh::bakeMeshes_}, false);
+	context.set({mesh2, &raco::user_types::Mesh::uri_}, test_path().append("meshes/meshrefless.gltf").string());
+
+	dispatch();
+
+	auto meshStuff{select<ramses::ArrayResource>(*sceneContext.scene(), ramses::ERamsesObjectType::ERamsesObjectType_ArrayResource)};
+	EXPECT_EQ(meshStuff.size(), 8);
+
+	auto adaptor1 = sceneContext.lookup<raco::ramses_adaptor::MeshAdaptor>(mesh1);
+	auto adaptor2 = sceneContext.lookup<raco::ramses_adaptor::MeshAdaptor>(mesh2);
+	ASSERT_NE(adaptor1->indicesPtr(), nullptr);
+	ASSERT_NE(adaptor2->indicesPtr(), nullptr);
+	EXPECT_NE(adaptor1->vertexData().at("a_Position"), adaptor2->vertexData().at("a_Position"));
+}
+
+TEST_F(MeshAdaptorTest, shared_buffers_renamed_with_creating_mesh) {
+	auto mesh1 = context.createObject(raco::user_types::Mesh::typeDescription.typeName, "Mesh 1");
+	auto mesh2 = context.createObject(raco::user_types::Mesh::typeDescription.typeName, "Mesh 2");
+	context.set({mesh1, &raco::user_types::Mesh::uri_}, test_path().append("meshes/Duck.glb").string());
+	dispatch();
+	context.set({mesh2, &raco::user_types::Mesh::uri_}, test_path().append("meshes/Duck.glb").string());
+	dispatch();
+
+	auto meshStuff{select<ramses::ArrayResource>(*sceneContext.scene(), ramses::ERamsesObjectType::ERamsesObjectType_ArrayResource)};
+	EXPECT_EQ(meshStuff.size(), 4);
+	ASSERT_TRUE(isRamsesNameInArray("Mesh 1_MeshIndexData", meshStuff));
+
+	context.set({mesh1, &raco::user_types::Mesh::objectName_}, std::string("Changed"));
+	dispatch();
+
+	meshStuff = select<ramses::ArrayResource>(*sceneContext.scene(), ramses::ERamsesObjectType::ERamsesObjectType_ArrayResource);
+	EXPECT_EQ(meshStuff.size(), 4);
+	ASSERT_TRUE(isRamsesNameInArray("Changed_MeshIndexData", meshStuff));
+	ASSERT_TRUE(isRamsesNameInArray("Changed_MeshVertexData_a_Position", meshStuff));
+}
@@ -163,6 +163,29 @@ TEST_F(SceneContextTest, construction_createMeshNodeWithMeshThenUnassignMesh) {
 	ASSERT_TRUE(isRamsesNameInArray("Material", materialStuff));
 }
 
+TEST_F(SceneContextTest, dataChange_referencedMeshUpdatedAfterUnrelatedDeletion) {
+	auto meshNode = context.createObject(MeshNode::typeDescription.typeName, "MeshNode");
+	auto mesh = context.createObject(Mesh::typeDescription.typeName, "Mesh");
+	auto unrelated = context.createObject(Node::typeDescription.typeName, "Node");
+	context.set(raco::core::ValueHandle{meshNode, {"mesh"}}, mesh);
+	dispatch();
+
+	auto meshNodes{select<ramses::MeshNode>(*sceneContext.scene(), ramses::ERamsesObjectType::ERamsesObjectType_MeshNode)};
+	ASSERT_EQ(meshNodes.size(), 1);
+	auto defaultIndexCount = meshNodes[0]->getIndexCount();
+
+	context.deleteObjects({unrelated});
+	dispatch();
+
+	// Only the mesh is changed: the mesh node has to be updated through its reference.
+	context.set(raco::core::ValueHandle{mesh, {"uri"}}, (test_path() / "meshes/Duck.glb").string());
+	dispatch();
+
+	meshNodes = select<ramses::MeshNode>(*sceneContext.scene(), ramses::ERamsesObjectType::ERamsesObjectType_MeshNode);
+	ASSERT_EQ(meshNodes.size(), 1);
+	EXPECT_NE(meshNodes[0]->getIndexCount(), defaultIndexCount);
+}
+
 TEST_F(SceneContextTest, construction_createSceneWithSimpleHierarchy) {
 	auto parent = context.createObject(Node::typeDescription.typeName);
 	auto child = context.createObject(MeshNode::typeDescription.typeName);
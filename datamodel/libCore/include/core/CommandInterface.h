@@ -77,6 +77,11 @@ public:
 	void set(ValueHandle const& handle, std::array<int, 3> const& value);
 	void set(ValueHandle const& handle, std::array<int, 4> const& value);
 
+	// Set a batch of Double properties as one change set.
+	// All handles are checked before anything is written; unchanged values are skipped.
+	// The prefab update runs once for the whole batch and at most one undo entry is created.
+	void setValues(std::vector<std::pair<ValueHandle, double>> const& values, bool push = true);
+
 	
 	bool canSetTags(ValueHandle const& handle, std::vector<std::string> const& value, std::string* outError = nullptr) const;
 
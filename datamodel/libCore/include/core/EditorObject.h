@@ -203,7 +203,7 @@ public:
 
 	Property<Table, ArraySemanticAnnotation, HiddenProperty, UserTagContainerAnnotation, DisplayNameAnnotation> userTags_{{}, {}, {}, {}, {"User Tags"}};
 
-	// Used to check back pointers in the unit tests.
+	// Objects holding references to this object. Used by the reference queries and to check back pointers in the unit tests.
 	const std::set<WEditorObject, std::owner_less<WEditorObject>>& referencesToThis() const;
 
 private:
@@ -330,6 +330,9 @@ public:
 	virtual ~MeshCache() = default;
 
 	virtual SharedMeshData loadMesh(const raco::core::MeshDescriptor& descriptor) = 0;
+	// True while the file is loaded in the background. loadMesh returns nullptr until the file change handlers
+	// of the path are notified that the load has finished.
+	virtual bool isMeshLoading(const std::string& absPath) = 0;
 	
 	virtual const MeshScenegraph* getMeshScenegraph(const std::string& absPath) = 0;
 	virtual std::string getMeshError(const std::string& absPath) = 0;
@@ -31,6 +31,7 @@ struct PathManager {
 	static constexpr const char* Q_PREFERENCES_FILE_NAME = "preferences.ini";
 	static constexpr const char* Q_RECENT_FILES_STORE_NAME = "recent_files.ini";
 	static constexpr const char* LOG_SUB_DIRECTORY = "logs";
+	static constexpr const char* MESH_CACHE_SUB_DIRECTORY = "meshcache";
 	static constexpr const char* LEGACY_CONFIG_SUB_DIRECTORY = "configfiles";
 	static constexpr const char* DEFAULT_PROJECT_SUB_DIRECTORY = "projects";
 	static constexpr const char* LOG_FILE_EDITOR_BASE_NAME = "RamsesComposer";
@@ -56,6 +57,8 @@ struct PathManager {
 
 	static u8path logFileDirectory();
 
+	static u8path meshCacheDirectory();
+
 	static u8path defaultConfigDirectory();
 
 	static u8path defaultResourceDirectory();
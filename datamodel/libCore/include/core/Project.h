@@ -44,6 +44,9 @@ public:
 
 	const std::vector<SEditorObject>& instances() const;
 
+	// Instances with exactly the given type name, in the same order as in instances().
+	const std::vector<SEditorObject>& instancesOfType(const std::string& typeName) const;
+
 	std::string projectName() const;
 	
 	std::string projectID() const;
@@ -171,10 +174,21 @@ private:
 	std::string folder_;
 	std::string filename_;
 
+	void insertInstance(SEditorObject object);
+
+	struct InstanceEntry {
+		SEditorObject object;
+		// Positions of the object in instances_ and in its instancesByType_ bucket.
+		size_t index;
+		size_t typeIndex;
+	};
+
 	// Ordered list of all instances.
 	std::vector<SEditorObject> instances_;
 	// Instance dictionary using object id as key for faster lookup.
-	std::unordered_map<std::string, SEditorObject> instanceMap_;
+	std::unordered_map<std::string, InstanceEntry> instanceMap_;
+	// Instances grouped by type name, each bucket ordered like instances_.
+	std::unordered_map<std::string, std::vector<SEditorObject>> instancesByType_;
 
 	// This map contains all the external project used by the current one;
 	// Keys are the project IDs
@@ -131,8 +131,13 @@ std::unique_ptr<ValueBase> deserializeProperty(const raco::core::Project& projec
 
 std::optional<ObjectsDeserialization> deserializeObjects(const std::string& json, bool checkVersionInfo = true);
 
+// Files with the current file version and data model are deserialized directly into user objects,
+// older files go through the IR and the migration code.
 ProjectDeserializationInfo deserializeProject(const QJsonDocument& jsonDocument, const std::string& filename);
 
+// Always use the IR and the migration code, independent of the file version.
+ProjectDeserializationInfo deserializeProjectWithMigration(const QJsonDocument& jsonDocument, const std::string& filename);
+
 std::map<std::string, std::map<std::string, std::string>> makeUserTypePropertyMap();
 std::map<std::string, std::map<std::string, std::string>> makeStructPropertyMap();
 std::map<std::string, std::map<std::string, std::string>> deserializeUserTypePropertyMap(const QVariant& container);
@@ -9,11 +9,16 @@
  */
 #pragma once
 
+#include "core/LinkContainer.h"
 #include "core/Project.h"
 #include "core/UndoState.h"
 
 #include <functional>
+#include <map>
+#include <optional>
+#include <set>
 #include <string>
+#include <unordered_map>
 #include <memory.h>
 
 namespace raco::core {
@@ -56,6 +61,18 @@ class UndoStack {
 public:
     using Callback = std::function<void()>;
 
+    struct MemoryStatistics {
+        size_t entries = 0;
+        // Estimated size of the object and link snapshots kept by the stack, in bytes
+        size_t bytes = 0;
+        // Part of bytes needed for the oldest reachable state
+        size_t baseBytes = 0;
+        // 0 means unlimited
+        size_t budget = 0;
+        // Number of entries dropped to stay within the budget since the last reset
+        size_t evictedEntries = 0;
+    };
+
     UndoStack(
         BaseContext *context, const Callback &onChange = []() {});
 
@@ -63,6 +80,13 @@ public:
     void push(const std::string &description, std::string mergeId = std::string());
     void push(const std::string &description, UndoState state);
 
+    // Composite commands: pushes between begin and end don't create entries. The changes of all of them are
+    // recorded as a single entry by the outermost endCompositeCommand. Composite commands can be nested.
+    void beginCompositeCommand();
+    // With abort = true all changes since the outermost begin are reverted instead when the outermost command ends.
+    void endCompositeCommand(const std::string &description, bool abort = false);
+    bool isInCompositeCommand() const;
+
     // Number of entries on the undo stack
     size_t size() const;
     const std::string &description(size_t index) const;
@@ -85,17 +109,60 @@ public:
     void reset();
     void resetUndoState(STRUCT_VISUAL_CURVE_POS pos);
     void resetUndoState(STRUCT_NODE node);
+    // Animation state of the current entry, pass it to UndoState::saveCurrentUndoState to share unchanged curves.
+    const UndoState &currentUndoState() const;
 
     bool curIndexIsOpreatObject();
 
+    // The oldest entries are dropped when the estimated memory of the stack exceeds the budget after a push.
+    // The initial and the current entry are always kept. A budget of 0 disables the limit.
+    void setMemoryBudget(size_t bytes);
+    size_t memoryBudget() const;
+    MemoryStatistics memoryStatistics() const;
+
 protected:
-    void saveProjectState(const Project *src, Project *dest, Project *ref, const DataChangeRecorder &changes, UserObjectFactoryInterface &factory);
-    void updateProjectState(const Project *src, Project *dest, const DataChangeRecorder &changes, UserObjectFactoryInterface &factory);
+    // Immutable copy of an object. Copies are shared between the snapshots of all entries they didn't change in.
+    // References between copies are resolved by object id.
+    struct ObjectSnapshot {
+        SEditorObject object;
+        // Position in the instance list: objects missing in the project are recreated in this order
+        uint64_t order = 0;
+        size_t bytes = 0;
+    };
+
+    // Project state at the current stack position.
+    struct Snapshot {
+        std::unordered_map<std::string, ObjectSnapshot> objects;
+        LinkContainer links;
+        std::map<std::string, serialization::ExternalProjectInfo> externalProjectsMap;
+        uint64_t nextOrder = 0;
+    };
+
+    // Changes between an entry and the one before it. Absent objects are represented by a null ObjectSnapshot::object.
+    struct Delta {
+        struct ObjectChange {
+            ObjectSnapshot before;
+            ObjectSnapshot after;
+        };
+        std::unordered_map<std::string, ObjectChange> objects;
+        std::vector<SLink> removedLinks;
+        std::vector<SLink> addedLinks;
+        std::optional<std::map<std::string, serialization::ExternalProjectInfo>> externalProjectsMapBefore;
+        std::optional<std::map<std::string, serialization::ExternalProjectInfo>> externalProjectsMapAfter;
+    };
 
-    void restoreProjectState(Project *src, Project *dest, BaseContext &context, UserObjectFactoryInterface &factory);
-    void restoreAnimationState(UndoState state);
+    SEditorObject snapshotObject(const SEditorObject &obj) const;
+    ObjectSnapshot createObjectSnapshot(const SEditorObject &srcObj, uint64_t order, UserObjectFactoryInterface &factory);
+    void saveProjectState(const Project *src, UserObjectFactoryInterface &factory);
+    void saveProjectChanges(const Project *src, const DataChangeRecorder &changes, Delta &outDelta, size_t &outBytes, UserObjectFactoryInterface &factory);
+    void updateProjectState(const Project *src, const DataChangeRecorder &changes, UserObjectFactoryInterface &factory);
+    void applyDelta(const Delta &delta, bool forward, std::set<std::string> &outChangedIDs);
+
+    void restoreProjectState(const Snapshot &src, Project *dest, BaseContext &context, UserObjectFactoryInterface &factory, const std::set<std::string> *changedIDs);
+    void restoreAnimationState(const UndoState &state);
 
     bool canMerge(const DataChangeRecorder &changes);
+    void evictEntries();
 
     BaseContext *context_;
     Callback onChange_;
@@ -104,12 +171,23 @@ protected:
         Entry(std::string description = std::string(), std::string mergeId = std::string());
         std::string description;
         std::string mergeId;
-        Project state;
+        // Changes relative to the previous entry, empty for the first entry
+        Delta delta;
+        // Estimated size of the snapshots created for this entry
+        size_t bytes = 0;
         UndoState undoState;
     };
 
     std::vector<std::unique_ptr<Entry>> stack_;
     size_t index_ = 0;
+
+    Snapshot state_;
+    size_t baseBytes_ = 0;
+    size_t memoryBudget_ = 0;
+    size_t evictedEntries_ = 0;
+
+    int compositeCommandDepth_ = 0;
+    bool compositeCommandAborted_ = false;
 };
 
 }  // namespace raco::core
@@ -12,10 +12,13 @@
 #include "core/Project.h"
 #include "core/ChangeBase.h"
 #include "core/StructCommon.h"
+#include "CurveData/CurveManager.h"
 
 #include <functional>
+#include <map>
+#include <memory>
 #include <string>
-#include <memory.h>
+#include <vector>
 
 namespace raco::core {
 
@@ -25,6 +28,8 @@ public:
 
     // save Current Undo State
     void saveCurrentUndoState();
+    // save Current Undo State, curves, folders and bindings which didn't change since previous are shared with it
+    void saveCurrentUndoState(const UndoState &previous);
 
     // push state-visualcurve
     void push(STRUCT_VISUAL_CURVE_POS data);
@@ -32,21 +37,28 @@ public:
     void push(STRUCT_NODE node);
 
     // get VisualCurve data
-    STRUCT_VISUAL_CURVE_POS visualPosData();
+    STRUCT_VISUAL_CURVE_POS visualPosData() const;
 
     // get Folder Data
-    STRUCT_FOLDER folderData();
+    STRUCT_FOLDER folderData() const;
 
     // get Curve Data
-    std::list<STRUCT_CURVE> curveData();
+    const std::vector<raco::guiData::SharedCurveSnapshot> &curveData() const;
 
     // get Node Data
-    STRUCT_NODE nodeData();
+    STRUCT_NODE nodeData() const;
+
+    // estimated size of the data not shared with previous, in bytes
+    size_t memoryUsage(const UndoState &previous) const;
 private:
+    using BindingMap = std::map<std::string, std::string>;
+
+    // the Qt containers in here already share their data between copies
     STRUCT_VISUAL_CURVE_POS posData_;
-    STRUCT_FOLDER folderData_;
-    std::list<STRUCT_CURVE> curveData_;
-    STRUCT_NODE nodeData_;
+    std::shared_ptr<const STRUCT_FOLDER> folderData_;
+    std::vector<raco::guiData::SharedCurveSnapshot> curveData_;
+    std::string activeNodeId_;
+    std::map<std::string, std::shared_ptr<const BindingMap>> bindingMap_;
 };
 
 }  // namespace raco::core
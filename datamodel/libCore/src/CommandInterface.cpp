@@ -231,6 +231,25 @@ void CommandInterface::set(ValueHandle const& handle, double const& value, bool
     }
 }
 
+void CommandInterface::setValues(std::vector<std::pair<ValueHandle, double>> const& values, bool push) {
+	for (auto const& [handle, value] : values) {
+		checkScalarHandleForSet(handle, PrimitiveType::Double);
+	}
+	size_t changed = 0;
+	for (auto const& [handle, value] : values) {
+		if (handle.asDouble() != value) {
+			context_->set(handle, value);
+			++changed;
+		}
+	}
+	if (changed > 0) {
+		PrefabOperations::globalPrefabUpdate(*context_);
+		if (push) {
+			undoStack_->push(fmt::format("Set {} properties", changed));
+		}
+	}
+}
+
 void CommandInterface::set(ValueHandle const& handle, std::string const& value) {
 	if (checkScalarHandleForSet(handle, PrimitiveType::String)) {
 		auto newValue = handle.query<URIAnnotation>() ? raco::utils::u8path::sanitizePathString(value) : value;
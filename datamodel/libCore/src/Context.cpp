@@ -1008,7 +1008,7 @@ void BaseContext::insertAssetScenegraph(const raco::core::MeshScenegraph& sceneg
 	std::vector<SEditorObject> meshScenegraphNodes;
 
 	LOG_INFO(log_system::CONTEXT, "Importing all meshes...");
-	auto projectMeshes = Queries::filterByTypeName(project()->instances(), {raco::user_types::Mesh::typeDescription.typeName});
+	auto projectMeshes = project()->instancesOfType(raco::user_types::Mesh::typeDescription.typeName);
 	std::map<std::tuple<bool, int, std::string>, SEditorObject> propertiesToMeshMap;
 	std::map<std::tuple<std::string, int, int>, SEditorObject> propertiesToChannelMap;
 
@@ -1058,7 +1058,7 @@ void BaseContext::insertAssetScenegraph(const raco::core::MeshScenegraph& sceneg
 	}
 
 	LOG_DEBUG(log_system::CONTEXT, "Traversing through scenegraph nodes...");
-	auto projectMaterials = Queries::filterByTypeName(project()->instances(), {user_types::Material::typeDescription.typeName});
+	auto projectMaterials = project()->instancesOfType(user_types::Material::typeDescription.typeName);
 	for (size_t i{0}; i < scenegraph.nodes.size(); ++i) {
 		if (!scenegraph.nodes[i].has_value()) {
 			LOG_DEBUG(log_system::CONTEXT, "Found disabled node at index {}, ignoring Node...", i);
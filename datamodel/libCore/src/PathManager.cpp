@@ -62,6 +62,10 @@ u8path PathManager::logFileDirectory() {
 	return defaultConfigDirectory() / LOG_SUB_DIRECTORY;
 }
 
+u8path PathManager::meshCacheDirectory() {
+	return defaultConfigDirectory() / MESH_CACHE_SUB_DIRECTORY;
+}
+
 u8path PathManager::layoutFilePath() {
 	return defaultConfigDirectory() / Q_LAYOUT_FILE_NAME;
 }
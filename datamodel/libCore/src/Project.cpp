@@ -14,28 +14,79 @@
 #include "core/CoreFormatter.h"
 #include "log_system/log.h"
 
+#include <algorithm>
 #include <cctype>
 #include <filesystem>
 
 namespace raco::core {
 
+namespace {
+
+// Remove the cleared slots from position first onwards, keeping the order of the remaining objects.
+template <typename Reindex>
+void compactInstances(std::vector<SEditorObject>& objects, size_t first, Reindex reindex) {
+	size_t dest = first;
+	for (size_t src = first; src < objects.size(); src++) {
+		if (objects[src]) {
+			if (dest != src) {
+				objects[dest] = std::move(objects[src]);
+			}
+			reindex(objects[dest], dest);
+			dest++;
+		}
+	}
+	objects.resize(dest);
+}
+
+}  // namespace
+
 Project::Project() : instances_{} {
 	setCurrentPath(utils::u8path::current().string());
 }
 
-Project::Project(const std::vector<SEditorObject>& instances) : instances_{instances} {
-	for (auto obj : instances_) {
-		instanceMap_[obj->objectID()] = obj;
+Project::Project(const std::vector<SEditorObject>& instances) {
+	instances_.reserve(instances.size());
+	for (auto obj : instances) {
+		insertInstance(obj);
 	}
 	setCurrentPath(utils::u8path::current().string());
 }
 
 bool Project::removeInstances(SEditorObjectSet const& objects, bool gcExternalProjectMap) {
+	// Clear the slots of the removed objects first and close the gaps in a single pass afterwards.
+	size_t firstRemoved = instances_.size();
+	std::map<std::string, size_t> firstRemovedByType;
 	for (const auto& object : objects) {
-		instances_.erase(std::find(instances_.begin(), instances_.end(), object));
+		auto it = instanceMap_.find(object->objectID());
+		if (it != instanceMap_.end() && it->second.object == object) {
+			const auto& typeName = object->getTypeDescription().typeName;
+			instances_[it->second.index].reset();
+			instancesByType_[typeName][it->second.typeIndex].reset();
+			firstRemoved = std::min(firstRemoved, it->second.index);
+			auto typeIt = firstRemovedByType.find(typeName);
+			if (typeIt == firstRemovedByType.end()) {
+				firstRemovedByType[typeName] = it->second.typeIndex;
+			} else {
+				typeIt->second = std::min(typeIt->second, it->second.typeIndex);
+			}
+			instanceMap_.erase(it);
+		}
 		codeCtrldObjs_.erase(object);
-		instanceMap_.erase(object->objectID());
 	}
+
+	compactInstances(instances_, firstRemoved, [this](const SEditorObject& object, size_t index) {
+		instanceMap_.at(object->objectID()).index = index;
+	});
+	for (const auto& [typeName, first] : firstRemovedByType) {
+		auto& bucket = instancesByType_[typeName];
+		compactInstances(bucket, first, [this](const SEditorObject& object, size_t index) {
+			instanceMap_.at(object->objectID()).typeIndex = index;
+		});
+		if (bucket.empty()) {
+			instancesByType_.erase(typeName);
+		}
+	}
+
 	if (gcExternalProjectMap) {
 		return gcExternalProjectMapping();
 	}
@@ -46,14 +97,29 @@ void Project::addInstance(SEditorObject object) {
 	if (instanceMap_.find(object->objectID()) != instanceMap_.end()) {
 		throw std::runtime_error(fmt::format("duplicate object {} with id {}", object->objectName(), object->objectID()));
 	}
+	insertInstance(object);
+}
+
+void Project::insertInstance(SEditorObject object) {
+	auto& bucket = instancesByType_[object->getTypeDescription().typeName];
+	instanceMap_[object->objectID()] = InstanceEntry{object, instances_.size(), bucket.size()};
 	instances_.push_back(object);
-	instanceMap_[object->objectID()] = object;
+	bucket.push_back(object);
 }
 
 const std::vector<SEditorObject>& Project::instances() const {
 	return instances_;
 }
 
+const std::vector<SEditorObject>& Project::instancesOfType(const std::string& typeName) const {
+	static const std::vector<SEditorObject> empty;
+	auto it = instancesByType_.find(typeName);
+	if (it != instancesByType_.end()) {
+		return it->second;
+	}
+	return empty;
+}
+
 std::string Project::projectName() const {
 	if (auto settingsObj = settings()) {
 		return settingsObj->objectName();
@@ -186,19 +252,17 @@ void Project::deduplicateLinks() {
 }
 
 std::shared_ptr<const ProjectSettings> Project::settings() const {
-	for (auto& instance : instances_) {
-		if (instance->isType<core::ProjectSettings>()) {
-			return std::dynamic_pointer_cast<core::ProjectSettings>(instance);
-		}
+	const auto& settingsObjects = instancesOfType(ProjectSettings::typeDescription.typeName);
+	if (!settingsObjects.empty()) {
+		return std::dynamic_pointer_cast<core::ProjectSettings>(settingsObjects.front());
 	}
 	return {};
 }
 
 std::shared_ptr<ProjectSettings> Project::settings() {
-	for (auto &instance : instances_) {
-		if (instance->isType<core::ProjectSettings>()) {
-			return std::dynamic_pointer_cast<core::ProjectSettings>(instance);
-		}
+	const auto& settingsObjects = instancesOfType(ProjectSettings::typeDescription.typeName);
+	if (!settingsObjects.empty()) {
+		return std::dynamic_pointer_cast<core::ProjectSettings>(settingsObjects.front());
 	}
 	return {};
 }
@@ -206,14 +270,14 @@ std::shared_ptr<ProjectSettings> Project::settings() {
 SEditorObject Project::getInstanceByID(const std::string& objectID) const {
 	auto it = instanceMap_.find(objectID);
 	if (it != instanceMap_.end()) {
-		return it->second;
+		return it->second.object;
 	}
 	return SEditorObject{};
 }
 
 bool Project::isInstance(const SEditorObject& object) const {
 	auto it = instanceMap_.find(object->objectID());
-	return it != instanceMap_.end() && it->second == object;
+	return it != instanceMap_.end() && it->second.object == object;
 }
 
 bool Project::createsLoop(const PropertyDescriptor& start, const PropertyDescriptor& end) const {
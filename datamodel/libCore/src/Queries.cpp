@@ -34,16 +34,41 @@
 
 namespace raco::core {
 
+namespace {
+
+// Instances holding a reference to object, found through the back pointers kept up to date by the objects.
+// Objects which have been deleted from the project may still be referencing it and are skipped.
+bool isReferencedByInstance(Project const& project, SEditorObject const& object) {
+	for (auto const& srcWeakObj : object->referencesToThis()) {
+		auto srcObj = srcWeakObj.lock();
+		if (srcObj && project.isInstance(srcObj)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+}  // namespace
+
 std::vector<ValueHandle> Queries::findAllReferencesTo(Project const& project, std::vector<SEditorObject> const& objects) {
+	SEditorObjectSet targets(objects.begin(), objects.end());
+	SEditorObjectSet srcObjects;
+	for (auto const& obj : objects) {
+		for (auto const& srcWeakObj : obj->referencesToThis()) {
+			auto srcObj = srcWeakObj.lock();
+			if (srcObj && targets.find(srcObj) == targets.end() && project.isInstance(srcObj)) {
+				srcObjects.insert(srcObj);
+			}
+		}
+	}
+
 	std::vector<ValueHandle> refs;
-	for (auto instance : project.instances()) {
-		if (std::find(objects.begin(), objects.end(), instance) == objects.end()) {
-			for (auto const& prop : ValueTreeIteratorAdaptor(ValueHandle(instance))) {
-				if (prop.type() == PrimitiveType::Ref) {
-					auto refValue = prop.asTypedRef<EditorObject>();
-					if (refValue && (std::find(objects.begin(), objects.end(), refValue) != objects.end())) {
-						refs.emplace_back(prop);
-					}
+	for (auto instance : srcObjects) {
+		for (auto const& prop : ValueTreeIteratorAdaptor(ValueHandle(instance))) {
+			if (prop.type() == PrimitiveType::Ref) {
+				auto refValue = prop.asTypedRef<EditorObject>();
+				if (refValue && targets.find(refValue) != targets.end()) {
+					refs.emplace_back(prop);
 				}
 			}
 		}
@@ -95,47 +120,34 @@ std::vector<ValueHandle> Queries::findAllReferences(const SEditorObject& object)
 }
 
 std::vector<SEditorObject> Queries::findAllUnreferencedObjects(Project const& project, std::function<bool(SEditorObject)> predicate) {
-	SEditorObjectSet referenced;
 	std::set<std::string> referencedRenderableTags;
 	std::set<std::string> referencedMaterialTags;
+	for (auto const& instance : project.instancesOfType(user_types::RenderLayer::typeDescription.typeName)) {
+		auto renderLayer = instance->as<user_types::RenderLayer>();
+		auto const& renderableTags = renderLayer->renderableTags();
+		auto materialTags = renderLayer->materialFilterTags();
+		referencedRenderableTags.insert(std::begin(renderableTags), std::end(renderableTags));
+		referencedMaterialTags.merge(materialTags);
+	}
 
 	// This is deliberately naive right now: only objects which are not referenced (directly or via tag) by anything
 	// else count as "unreferenced". Render passes cannot be referenced by anything and are therefore never "unreferenced".
 	// A less naive alternative would be to use the render passes as seed objects, and then gather all objects which
 	// are referenced by them, but given that this function is mainly used to delete "unused" resources it
 	// seems to be better to return fewer rather than more objects.
+	std::vector<SEditorObject> unreferenced;
 	for (auto instance : project.instances()) {
-		auto links = getLinksConnectedToObject(project, instance, true, false);
-		if (!links.empty()) {
-			referenced.insert(instance);
+		if (predicate && !predicate(instance)) {
+			continue;
 		}
-
 		// RenderPass or AnchorPoint objects cannot be referenced by anything - don't count them as unreferenced.
 		if (instance->isType<user_types::RenderPass>() || instance->isType<user_types::AnchorPoint>()) {
-			referenced.insert(instance);
-		}
-		if (auto renderLayer = instance->as<user_types::RenderLayer>()) {
-			auto const& renderableTags = renderLayer->renderableTags();
-			auto materialTags = renderLayer->materialFilterTags();
-			referencedRenderableTags.insert(std::begin(renderableTags), std::end(renderableTags));
-			referencedMaterialTags.merge(materialTags);
-		}
-		for (auto const& prop : ValueTreeIteratorAdaptor(ValueHandle(instance))) {
-			if (prop.type() == PrimitiveType::Ref) {
-				auto refValue = prop.asTypedRef<EditorObject>();
-				if (refValue) {
-					referenced.insert(refValue);
-				}
-			}
+			continue;
 		}
-	}
-
-	std::vector<SEditorObject> unreferenced;
-	for (auto instance : project.instances()) {
-		if (referenced.find(instance) != referenced.end()) {
+		if (isReferencedByInstance(project, instance)) {
 			continue;
 		}
-		if (predicate && !predicate(instance)) {
+		if (!getLinksConnectedToObject(project, instance, true, false).empty()) {
 			continue;
 		}
 		if (Queries::hasObjectAnyTag(instance->as<user_types::Node>(), referencedRenderableTags)) {
@@ -30,7 +30,10 @@
 #include <QJsonObject>
 #include <QStringList>
 
+#include <chrono>
 #include <filesystem>
+#include <future>
+#include <thread>
 
 using namespace raco::serialization;
 using namespace raco::data_storage;
@@ -275,7 +278,7 @@ void createMissingProperties(const QJsonArray& jsonArray, raco::data_storage::Ta
 void deserializeValueBase(const QJsonValue& property, ValueBase& value, References& references, const raco::core::UserObjectFactoryInterface& factory, const std::map<std::string, std::map<std::string, std::string>>& structPropTypesMap, bool dynamicallyTyped = false) {
 	bool childrenDynamicallyTyped{value.type() == PrimitiveType::Table};
 	auto valueIsClassType{hasTypeSubstructure(value.type())};
-	auto hasAnnotations{property.isObject() && property.toObject().keys().contains(keys::ANNOTATIONS)};
+	auto hasAnnotations{property.isObject() && property.toObject().contains(keys::ANNOTATIONS)};
 
 	if (dynamicallyTyped || hasAnnotations || childrenDynamicallyTyped) {
 		auto propertyAsObject{property.toObject()};
@@ -365,11 +368,11 @@ std::optional<QJsonObject> serializeObjectProperties(const ReflectionInterface&
 
 /** Deserializes result of `serializeObjectProperties` from `properties` into the given `interface`. */
 void deserializeObjectProperties(const QJsonObject& properties, ReflectionInterface& objectInterface, References& references, const raco::core::UserObjectFactoryInterface& factory, const std::map<std::string, std::map<std::string, std::string>>& structPropTypesMap, bool dynamicallyTyped = false) {
-	for (const auto& qPropertyName : properties.keys()) {
-		std::string name = qPropertyName.toStdString();
-		ValueBase& value = *objectInterface.get(objectInterface.index(name));
-		if (&value != nullptr) {
-			deserializeValueBase(properties[qPropertyName], value, references, factory, structPropTypesMap, dynamicallyTyped);
+	for (auto it = properties.begin(); it != properties.end(); ++it) {
+		std::string name = it.key().toStdString();
+		ValueBase* value = objectInterface.get(objectInterface.index(name));
+		if (value != nullptr) {
+			deserializeValueBase(it.value(), *value, references, factory, structPropTypesMap, dynamicallyTyped);
 		} else {
 			LOG_WARNING(raco::log_system::DESERIALIZATION, "Dropping unsupported or deprecated property {}", name);
 		}
@@ -414,7 +417,7 @@ SReflectionInterface deserializeTypedObject(const QJsonObject& jsonObject, raco:
 		object = factory.createObject(typeName);
 	}
 
-	if (jsonObject.keys().contains(keys::ANNOTATIONS)) {
+	if (jsonObject.contains(keys::ANNOTATIONS)) {
 		deserializeObjectAnnotations(jsonObject[keys::ANNOTATIONS].toArray(),
 			std::dynamic_pointer_cast<raco::data_storage::ClassWithReflectedMembers>(object).get(),
 			references, factory, structPropTypesMap);
@@ -610,6 +613,94 @@ ProjectDeserializationInfo ConvertFromIRToUserTypes(const ProjectDeserialization
 	return result;
 }
 
+// Files written with the current file version and data model need no migration and can be deserialized
+// directly into user objects. The type maps are compared too since the data model may change without a
+// new file version during development.
+bool isCurrentDataModel(const QJsonDocument& document, const std::map<std::string, std::map<std::string, std::string>>& userPropTypeMap, const std::map<std::string, std::map<std::string, std::string>>& structPropTypeMap) {
+	return deserializeFileVersion(document) == RAMSES_PROJECT_FILE_VERSION &&
+		   deserializeUserTypePropertyMap(document[keys::USER_TYPE_PROP_MAP]) == userPropTypeMap &&
+		   deserializeUserTypePropertyMap(document[keys::STRUCT_PROP_MAP]) == structPropTypeMap;
+}
+
+// Objects in the file are independent of each other until the references are resolved. Larger projects are split
+// into chunks which are constructed in parallel, the calling thread takes the first chunk.
+constexpr size_t MIN_OBJECTS_PER_THREAD = 256;
+
+template <typename F>
+void runChunks(size_t chunks, const F& func) {
+	std::vector<std::future<void>> futures;
+	futures.reserve(chunks);
+	for (size_t chunk = 1; chunk < chunks; chunk++) {
+		futures.emplace_back(std::async(std::launch::async, func, chunk));
+	}
+	func(0);
+	for (auto& future : futures) {
+		future.get();
+	}
+}
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+ProjectDeserializationInfo deserializeProjectToUserTypes(const QJsonDocument& document, const std::map<std::string, std::map<std::string, std::string>>& userPropTypeMap, const std::map<std::string, std::map<std::string, std::string>>& structPropTypeMap) {
+	auto& factory{raco::user_types::UserObjectFactory::getInstance()};
+
+	ProjectDeserializationInfo result;
+	result.versionInfo = deserializeProjectVersionInfo(document);
+	deserializeExternalProjectsMap(document[keys::EXTERNAL_PROJECTS].toVariant(), result.externalProjectsMap);
+
+	auto constructionStart = std::chrono::steady_clock::now();
+
+	const auto instances = document[keys::INSTANCES].toArray();
+	const size_t numObjects = instances.size();
+	const size_t chunks = std::max<size_t>(1, std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), numObjects / MIN_OBJECTS_PER_THREAD));
+
+	// Each chunk collects its own references, the objects are written to disjoint slots.
+	std::vector<References> chunkReferences(chunks);
+	result.objects.resize(numObjects);
+	runChunks(chunks, [&](size_t chunk) {
+		for (size_t index = numObjects * chunk / chunks; index < numObjects * (chunk + 1) / chunks; index++) {
+			result.objects[index] = std::dynamic_pointer_cast<EditorObject>(deserializeTypedObject(instances[static_cast<int>(index)].toObject(), factory, chunkReferences[chunk], userPropTypeMap, structPropTypeMap));
+		}
+	});
+
+	References linkReferences;
+	const auto links = document[keys::LINKS].toArray();
+	result.links.reserve(links.size());
+	for (const auto& linkJson : links) {
+		result.links.emplace_back(std::dynamic_pointer_cast<raco::core::Link>(deserializeTypedObject(linkJson.toObject(), factory, linkReferences, userPropTypeMap, structPropTypeMap)));
+	}
+	auto constructionTime = millisecondsSince(constructionStart);
+
+	// Join: references can only be resolved once all objects exist.
+	auto referencesStart = std::chrono::steady_clock::now();
+	std::unordered_map<std::string, raco::core::SEditorObject> instanceMap;
+	instanceMap.reserve(numObjects);
+	for (const auto& obj : result.objects) {
+		instanceMap[obj->objectID()] = obj;
+	}
+	auto resolveReferences = [&instanceMap](const References& references) {
+		for (const auto& [value, objectID] : references) {
+			auto it = instanceMap.find(objectID);
+			if (it != instanceMap.end()) {
+				*value = it->second;
+			} else {
+				LOG_WARNING(raco::log_system::DESERIALIZATION, "Load: referenced object not found: {}", objectID);
+			}
+		}
+	};
+	runChunks(chunks, [&](size_t chunk) {
+		resolveReferences(chunkReferences[chunk]);
+	});
+	resolveReferences(linkReferences);
+
+	LOG_INFO(raco::log_system::PROJECT, "Deserialized {} objects and {} links using {} threads: construction {:.1f} ms, references {:.1f} ms",
+		numObjects, result.links.size(), chunks, constructionTime, millisecondsSince(referencesStart));
+
+	return result;
+}
+
 }  // namespace
 
 
@@ -960,6 +1051,15 @@ ProjectDeserializationInfoIR deserializeProjectToIR(const QJsonDocument& documen
 }
 
 ProjectDeserializationInfo deserializeProject(const QJsonDocument& document, const std::string& filename) {
+	auto userPropTypeMap = makeUserTypePropertyMap();
+	auto structPropTypeMap = makeStructPropertyMap();
+	if (isCurrentDataModel(document, userPropTypeMap, structPropTypeMap)) {
+		return deserializeProjectToUserTypes(document, userPropTypeMap, structPropTypeMap);
+	}
+	return deserializeProjectWithMigration(document, filename);
+}
+
+ProjectDeserializationInfo deserializeProjectWithMigration(const QJsonDocument& document, const std::string& filename) {
 	auto deserializedIR{deserializeProjectToIR(document, filename)};
 
 	// run new migration code
@@ -110,7 +110,7 @@ std::set<user_types::SRenderPass> TagDataCache::allRenderPassesForObjectWithTags
 		}
 		allLayers.insert(newLayers.begin(), newLayers.end());
 	} while (!newLayers.empty());
-	auto rps = core::Queries::filterByType<user_types::RenderPass>(project_->instances());
+	auto rps = core::Queries::filterByType<user_types::RenderPass>(project_->instancesOfType(user_types::RenderPass::typeDescription.typeName));
 	for (auto const& rp : rps) {
 		auto rprls = {rp->layer0_.asRef(), rp->layer1_.asRef(), rp->layer2_.asRef(), rp->layer3_.asRef(),
 			rp->layer4_.asRef(), rp->layer5_.asRef(), rp->layer6_.asRef(), rp->layer7_.asRef()};
@@ -20,10 +20,12 @@
 #include "data_storage/ReflectionInterface.h"
 #include "data_storage/Table.h"
 #include "data_storage/Value.h"
+#include "log_system/log.h"
 #include "VisualCurveData/VisualCurvePosManager.h"
 #include "FolderData/FolderDataManager.h"
 #include "CurveData/CurveManager.h"
 #include "signal/SignalProxy.h"
+#include <algorithm>
 #include <cassert>
 
 namespace raco::core {
@@ -209,85 +211,308 @@ void UndoHelpers::updateEditorObject(const EditorObject *src, SEditorObject dest
 	}
 }
 
-void UndoStack::saveProjectState(const Project *src, Project *dest, Project *ref, const DataChangeRecorder &changes, UserObjectFactoryInterface &factory) {
-	assert(dest->links().size() == 0);
-	assert(dest->linkStartPoints().empty());
-	assert(dest->linkEndPoints().empty());
-	assert(dest->instances().empty());
+namespace {
+
+// Rough per property overhead of the value objects and their property table entries
+constexpr size_t PROPERTY_BYTES = 128;
+constexpr size_t OBJECT_BYTES = 512;
+constexpr size_t LINK_BYTES = 256;
+
+size_t estimateMemory(const ReflectionInterface &object) {
+	size_t bytes = 0;
+	for (size_t index = 0; index < object.size(); index++) {
+		auto value = object.get(index);
+		bytes += PROPERTY_BYTES + object.name(index).capacity();
+		if (value->type() == PrimitiveType::String) {
+			bytes += value->asString().capacity();
+		} else if (hasTypeSubstructure(value->type())) {
+			bytes += estimateMemory(value->getSubstructure());
+		}
+	}
+	return bytes;
+}
 
-	SEditorObjectSet dirtyObjects;
-	if (ref) {
-		dirtyObjects = changes.getAllChangedObjects();
-	} else {
-		std::copy(src->instances().begin(), src->instances().end(), std::inserter(dirtyObjects, dirtyObjects.end()));
+size_t estimateMemory(const EditorObject &object) {
+	size_t bytes = OBJECT_BYTES + estimateMemory(static_cast<const ReflectionInterface &>(object));
+	for (const auto &anno : object.annotations()) {
+		bytes += estimateMemory(*anno);
 	}
+	return bytes;
+}
 
-	for (const auto &srcObj : src->instances()) {
-		if (!ref || dirtyObjects.find(srcObj) != dirtyObjects.end()) {
-			// changed -> create new object
-			auto destObj = factory.createObject(srcObj->getTypeDescription().typeName, srcObj->objectName(), srcObj->objectID());
-			dest->addInstance(destObj);
-		} else {
-			// unchanged -> use object from ref
-			dest->addInstance(ref->getInstanceByID(srcObj->objectID()));
+bool sameLinkState(const Link &left, const Link &right) {
+	return left.isValid() == right.isValid() && *left.isWeak_ == *right.isWeak_;
+}
+
+}  // namespace
+
+SEditorObject UndoStack::snapshotObject(const SEditorObject &obj) const {
+	if (obj) {
+		auto it = state_.objects.find(obj->objectID());
+		if (it != state_.objects.end()) {
+			return it->second.object;
 		}
 	}
+	return nullptr;
+}
 
-	auto translateRef = [dest](SEditorObject srcObj) -> SEditorObject {
-		if (srcObj) {
-			return dest->getInstanceByID(srcObj->objectID());
-		}
-		return nullptr;
+UndoStack::ObjectSnapshot UndoStack::createObjectSnapshot(const SEditorObject &srcObj, uint64_t order, UserObjectFactoryInterface &factory) {
+	return {factory.createObject(srcObj->getTypeDescription().typeName, srcObj->objectName(), srcObj->objectID()), order, 0};
+}
+
+void UndoStack::saveProjectState(const Project *src, UserObjectFactoryInterface &factory) {
+	state_ = Snapshot();
+	for (const auto &srcObj : src->instances()) {
+		state_.objects[srcObj->objectID()] = createObjectSnapshot(srcObj, state_.nextOrder++, factory);
+	}
+
+	auto translateRef = [this](SEditorObject srcObj) -> SEditorObject {
+		return snapshotObject(srcObj);
 	};
 
-	for (const auto &srcObj : dirtyObjects) {
-		auto destObj = dest->getInstanceByID(srcObj->objectID());
+	baseBytes_ = 0;
+	for (const auto &srcObj : src->instances()) {
+		auto &snapshot = state_.objects[srcObj->objectID()];
 		UndoHelpers::updateEditorObject(
-			srcObj.get(), destObj, translateRef, [](const std::string &) { return false; }, factory, nullptr, false);
+			srcObj.get(), snapshot.object, translateRef, [](const std::string &) { return false; }, factory, nullptr, false);
+		snapshot.bytes = estimateMemory(*snapshot.object);
+		baseBytes_ += snapshot.bytes;
 	}
 
 	for (const auto &srcLink : src->links()) {
-		if (!ref || changes.isLinkAdded(srcLink) || changes.isLinkValidityChanged(srcLink)) {
-			dest->addLink(Link::cloneLinkWithTranslation(srcLink, translateRef));
-		} else {
-			dest->addLink(ref->findLinkByObjectID(srcLink));
-		}
+		state_.links.addLink(Link::cloneLinkWithTranslation(srcLink, translateRef));
+		baseBytes_ += LINK_BYTES;
 	}
 
-	// Update external project name map
-	dest->externalProjectsMap_ = src->externalProjectsMap_;
+	state_.externalProjectsMap = src->externalProjectsMap_;
 }
 
-void UndoStack::updateProjectState(const Project *src, Project *dest, const DataChangeRecorder &changes, UserObjectFactoryInterface &factory) {
-	SEditorObjectSet dirtyObjects = changes.getAllChangedObjects();
+// Update the snapshot with the recorded changes only and store the replaced and new snapshots in the delta.
+void UndoStack::saveProjectChanges(const Project *src, const DataChangeRecorder &changes, Delta &outDelta, size_t &outBytes, UserObjectFactoryInterface &factory) {
+	std::set<std::string> deletedIDs;
+	for (const auto &obj : changes.getDeletedObjects()) {
+		deletedIDs.insert(obj->objectID());
+	}
+	std::set<std::string> changedIDs{deletedIDs};
+	for (const auto &obj : changes.getAllChangedObjects()) {
+		changedIDs.insert(obj->objectID());
+	}
 
-	auto translateRef = [dest](SEditorObject srcObj) -> SEditorObject {
+	// New objects: recreated ones (deleted and created again with the same id) are treated as new too.
+	std::set<std::string> newIDs;
+	for (const auto &id : changedIDs) {
+		auto srcObj = src->getInstanceByID(id);
+		if (srcObj && (state_.objects.find(id) == state_.objects.end() || deletedIDs.find(id) != deletedIDs.end() || changes.getCreatedObjects().find(srcObj) != changes.getCreatedObjects().end())) {
+			newIDs.insert(id);
+		}
+	}
+
+	// Objects are appended to the instance list when they are created, so the new ones are found at its end.
+	std::vector<SEditorObject> newObjects;
+	if (!newIDs.empty()) {
+		const auto &instances = src->instances();
+		for (auto it = instances.rbegin(); it != instances.rend() && newObjects.size() < newIDs.size(); ++it) {
+			if (newIDs.find((*it)->objectID()) != newIDs.end()) {
+				newObjects.emplace_back(*it);
+			}
+		}
+		std::reverse(newObjects.begin(), newObjects.end());
+	}
+	std::map<std::string, uint64_t> newOrder;
+	for (const auto &obj : newObjects) {
+		newOrder[obj->objectID()] = state_.nextOrder++;
+	}
+
+	std::set<std::string> structureChangedIDs;
+	for (const auto &id : changedIDs) {
+		auto srcObj = src->getInstanceByID(id);
+		auto stateIt = state_.objects.find(id);
+		ObjectSnapshot before;
+		if (stateIt != state_.objects.end()) {
+			before = stateIt->second;
+		}
+		if (!srcObj && !before.object) {
+			continue;
+		}
+
+		auto &change = outDelta.objects[id];
+		change.before = before;
 		if (srcObj) {
-			return dest->getInstanceByID(srcObj->objectID());
+			auto orderIt = newOrder.find(id);
+			auto order = orderIt != newOrder.end() ? orderIt->second : before.order;
+			state_.objects[id] = change.after = createObjectSnapshot(srcObj, order, factory);
+			if (orderIt != newOrder.end() || !before.object) {
+				structureChangedIDs.insert(id);
+			}
+		} else {
+			state_.objects.erase(id);
+			structureChangedIDs.insert(id);
+		}
+	}
+
+	auto translateRef = [this](SEditorObject srcObj) -> SEditorObject {
+		return snapshotObject(srcObj);
+	};
+
+	for (auto &[id, change] : outDelta.objects) {
+		if (change.after.object) {
+			UndoHelpers::updateEditorObject(
+				src->getInstanceByID(id).get(), change.after.object, translateRef, [](const std::string &) { return false; }, factory, nullptr, false);
+			change.after.bytes = estimateMemory(*change.after.object);
+			state_.objects[id].bytes = change.after.bytes;
+			outBytes += change.after.bytes;
+		}
+	}
+
+	// Links are compared per end object: links of recorded link changes and links of created or deleted objects.
+	std::set<std::string> linkEndIDs;
+	for (const auto *linkMap : {&changes.getAddedLinks(), &changes.getValidityChangedLinks(), &changes.getRemovedLinks()}) {
+		for (const auto &[endID, links] : *linkMap) {
+			linkEndIDs.insert(endID);
+		}
+	}
+	auto insertLinkEndIDs = [&linkEndIDs](const std::map<std::string, std::set<SLink>> &linkStartPoints, const std::string &startID) {
+		auto it = linkStartPoints.find(startID);
+		if (it != linkStartPoints.end()) {
+			for (const auto &link : it->second) {
+				linkEndIDs.insert((*link->endObject_)->objectID());
+			}
 		}
-		return nullptr;
 	};
+	for (const auto &id : structureChangedIDs) {
+		linkEndIDs.insert(id);
+		insertLinkEndIDs(state_.links.linkStartPoints_, id);
+		insertLinkEndIDs(src->linkStartPoints(), id);
+	}
+
+	for (const auto &endID : linkEndIDs) {
+		std::vector<SLink> removedLinks;
+		std::vector<SLink> addedLinks;
+		auto stateIt = state_.links.linkEndPoints_.find(endID);
+		if (stateIt != state_.links.linkEndPoints_.end()) {
+			for (const auto &stateLink : stateIt->second) {
+				auto srcLink = LinkContainer::findLinkByObjectID(src->linkEndPoints(), stateLink);
+				if (!srcLink || !sameLinkState(*srcLink, *stateLink)) {
+					removedLinks.emplace_back(stateLink);
+				}
+			}
+		}
+		auto srcIt = src->linkEndPoints().find(endID);
+		if (srcIt != src->linkEndPoints().end()) {
+			for (const auto &srcLink : srcIt->second) {
+				auto stateLink = state_.links.findLinkByObjectID(srcLink);
+				if (!stateLink || !sameLinkState(*srcLink, *stateLink)) {
+					addedLinks.emplace_back(Link::cloneLinkWithTranslation(srcLink, translateRef));
+				}
+			}
+		}
+		for (const auto &link : removedLinks) {
+			state_.links.removeLink(link);
+		}
+		for (const auto &link : addedLinks) {
+			state_.links.addLink(link);
+		}
+		outDelta.removedLinks.insert(outDelta.removedLinks.end(), removedLinks.begin(), removedLinks.end());
+		outDelta.addedLinks.insert(outDelta.addedLinks.end(), addedLinks.begin(), addedLinks.end());
+		outBytes += addedLinks.size() * LINK_BYTES;
+	}
+
+	if (state_.externalProjectsMap != src->externalProjectsMap_) {
+		outDelta.externalProjectsMapBefore = state_.externalProjectsMap;
+		outDelta.externalProjectsMapAfter = src->externalProjectsMap_;
+		state_.externalProjectsMap = src->externalProjectsMap_;
+	}
+}
+
+// Merge changes into the current entry: only values of existing objects have changed.
+void UndoStack::updateProjectState(const Project *src, const DataChangeRecorder &changes, UserObjectFactoryInterface &factory) {
+	auto &entry = *stack_[index_];
 
-	for (const auto &srcObj : dirtyObjects) {
-		auto destObj = dest->getInstanceByID(srcObj->objectID());
+	auto translateRef = [this](SEditorObject srcObj) -> SEditorObject {
+		return snapshotObject(srcObj);
+	};
+
+	for (const auto &srcObj : changes.getAllChangedObjects()) {
+		auto stateIt = state_.objects.find(srcObj->objectID());
+		if (stateIt == state_.objects.end()) {
+			continue;
+		}
+		auto &snapshot = stateIt->second;
+		auto changeIt = entry.delta.objects.find(srcObj->objectID());
+		size_t &bytes = index_ > 0 ? entry.bytes : baseBytes_;
+		if (changeIt != entry.delta.objects.end() && changeIt->second.after.object == snapshot.object) {
+			// Snapshot created for this entry: not shared with other entries and can be updated in place.
+			bytes -= snapshot.bytes;
+		} else {
+			auto newSnapshot = createObjectSnapshot(srcObj, snapshot.order, factory);
+			if (index_ > 0) {
+				entry.delta.objects[srcObj->objectID()].before = snapshot;
+			} else {
+				// The first entry has no delta: the replaced snapshot is dropped.
+				bytes -= snapshot.bytes;
+			}
+			snapshot = newSnapshot;
+		}
 		UndoHelpers::updateEditorObject(
-			srcObj.get(), destObj, translateRef, [](const std::string &) { return false; }, factory, nullptr, false);
+			srcObj.get(), snapshot.object, translateRef, [](const std::string &) { return false; }, factory, nullptr, false);
+		snapshot.bytes = estimateMemory(*snapshot.object);
+		bytes += snapshot.bytes;
+		if (index_ > 0) {
+			entry.delta.objects[srcObj->objectID()].after = snapshot;
+		}
 	}
 
-	// Update external project name map
-	dest->externalProjectsMap_ = src->externalProjectsMap_;
+	if (state_.externalProjectsMap != src->externalProjectsMap_) {
+		if (index_ > 0) {
+			if (!entry.delta.externalProjectsMapBefore) {
+				entry.delta.externalProjectsMapBefore = state_.externalProjectsMap;
+			}
+			entry.delta.externalProjectsMapAfter = src->externalProjectsMap_;
+		}
+		state_.externalProjectsMap = src->externalProjectsMap_;
+	}
+}
+
+void UndoStack::applyDelta(const Delta &delta, bool forward, std::set<std::string> &outChangedIDs) {
+	for (const auto &[id, change] : delta.objects) {
+		const auto &snapshot = forward ? change.after : change.before;
+		if (snapshot.object) {
+			state_.objects[id] = snapshot;
+		} else {
+			state_.objects.erase(id);
+		}
+		outChangedIDs.insert(id);
+	}
+	for (const auto &link : forward ? delta.removedLinks : delta.addedLinks) {
+		state_.links.removeLink(link);
+	}
+	for (const auto &link : forward ? delta.addedLinks : delta.removedLinks) {
+		state_.links.addLink(link);
+	}
+	const auto &externalProjectsMap = forward ? delta.externalProjectsMapAfter : delta.externalProjectsMapBefore;
+	if (externalProjectsMap) {
+		state_.externalProjectsMap = *externalProjectsMap;
+	}
 }
 
-void UndoStack::restoreProjectState(Project *src, Project *dest, BaseContext &context, UserObjectFactoryInterface &factory) {
+void UndoStack::restoreProjectState(const Snapshot &src, Project *dest, BaseContext &context, UserObjectFactoryInterface &factory, const std::set<std::string> *changedIDs) {
 	DataChangeRecorder changes;
 	bool extrefDirty = false;
 
 	const auto destLinks{dest->links()};
-	const auto srcLinks{src->links()};
+	const auto &srcLinks{src.links};
+
+	auto findSrcObject = [&src](const std::string &id) -> SEditorObject {
+		auto it = src.objects.find(id);
+		if (it != src.objects.end()) {
+			return it->second.object;
+		}
+		return nullptr;
+	};
 
 	// Remove dest links not present in src
 	for (const auto &destLink : destLinks) {
-		if (!src->findLinkByObjectID(destLink)) {
+		if (!srcLinks.findLinkByObjectID(destLink)) {
 			changes.recordRemoveLink(destLink->descriptor());
 			dest->removeLink(destLink);
 			extrefDirty = extrefDirty || (*destLink->endObject_)->query<ExternalReferenceAnnotation>();
@@ -297,7 +522,7 @@ void UndoStack::restoreProjectState(Project *src, Project *dest, BaseContext &co
 	// Remove dest objects not present in src
 	SEditorObjectSet toRemove;
     for (const auto &destObj : dest->instances()) {
-		if (!src->getInstanceByID(destObj->objectID())) {
+		if (!findSrcObject(destObj->objectID())) {
 			toRemove.insert(destObj);
 			changes.recordDeleteObject(destObj);
 			extrefDirty = extrefDirty || destObj->query<ExternalReferenceAnnotation>();
@@ -306,14 +531,24 @@ void UndoStack::restoreProjectState(Project *src, Project *dest, BaseContext &co
 	context.deleteWithVolatileSideEffects(dest, toRemove, context.errors());
 
 	// Create src object not present in dest
-	for (const auto &srcObj : src->instances()) {
-		if (!dest->getInstanceByID(srcObj->objectID())) {
-			auto destObj = factory.createObject(srcObj->getTypeDescription().typeName, srcObj->objectName(), srcObj->objectID());
-			dest->addInstance(destObj);
-			changes.recordCreateObject(destObj);
-			extrefDirty = extrefDirty || srcObj->query<ExternalReferenceAnnotation>();
+	std::vector<const ObjectSnapshot *> toCreate;
+	for (const auto &[id, snapshot] : src.objects) {
+		if (!dest->getInstanceByID(id)) {
+			toCreate.emplace_back(&snapshot);
 		}
 	}
+	std::sort(toCreate.begin(), toCreate.end(), [](const ObjectSnapshot *left, const ObjectSnapshot *right) {
+		return left->order < right->order;
+	});
+	SEditorObjectSet createdObjects;
+	for (const auto snapshot : toCreate) {
+		const auto &srcObj = snapshot->object;
+		auto destObj = factory.createObject(srcObj->getTypeDescription().typeName, srcObj->objectName(), srcObj->objectID());
+		dest->addInstance(destObj);
+		changes.recordCreateObject(destObj);
+		createdObjects.insert(destObj);
+		extrefDirty = extrefDirty || srcObj->query<ExternalReferenceAnnotation>();
+	}
 
 	auto translateRef = [dest](SEditorObject srcObj) -> SEditorObject {
 		if (srcObj) {
@@ -322,11 +557,26 @@ void UndoStack::restoreProjectState(Project *src, Project *dest, BaseContext &co
 		return nullptr;
 	};
 
-	// Update objects
-	for (const auto &destObj : dest->instances()) {
-		auto srcObj = src->getInstanceByID(destObj->objectID());
+	// Update objects: all of them or only the ones changed between the current and the restored state
+	auto updateObject = [&](const SEditorObject &destObj) {
+		auto srcObj = findSrcObject(destObj->objectID());
 		UndoHelpers::updateEditorObject(
 			srcObj.get(), destObj, translateRef, [](const std::string &) { return false; }, factory, &changes, true);
+	};
+	if (changedIDs) {
+		for (const auto &id : *changedIDs) {
+			auto destObj = dest->getInstanceByID(id);
+			if (destObj && createdObjects.find(destObj) == createdObjects.end()) {
+				updateObject(destObj);
+			}
+		}
+		for (const auto &destObj : createdObjects) {
+			updateObject(destObj);
+		}
+	} else {
+		for (const auto &destObj : dest->instances()) {
+			updateObject(destObj);
+		}
 	}
 
 	auto findExtref = [](const std::map<std::string, std::set<ValueHandle>>& changes) {
@@ -368,8 +618,8 @@ void UndoStack::restoreProjectState(Project *src, Project *dest, BaseContext &co
 	}
 
 	// Update external project name map
-	if (dest->externalProjectsMap_ != src->externalProjectsMap_) {
-		dest->externalProjectsMap_ = src->externalProjectsMap_;
+	if (dest->externalProjectsMap_ != src.externalProjectsMap) {
+		dest->externalProjectsMap_ = src.externalProjectsMap;
 		extrefDirty = true;
 	}
 
@@ -410,14 +660,12 @@ void UndoStack::restoreProjectState(Project *src, Project *dest, BaseContext &co
     }
 }
 
-void UndoStack::restoreAnimationState(UndoState state) {
+void UndoStack::restoreAnimationState(const UndoState &state) {
     QVariant nodeData;
     nodeData.setValue(state.nodeData());
     guiData::NodeDataManager::GetInstance().merge(nodeData);
 
-    QVariant curveData;
-    curveData.setValue(state.curveData());
-    guiData::CurveManager::GetInstance().merge(curveData);
+    guiData::CurveManager::GetInstance().restoreCurves(state.curveData());
 
     QVariant folderData;
     folderData.setValue(state.folderData());
@@ -430,16 +678,18 @@ void UndoStack::restoreAnimationState(UndoState state) {
 }
 
 UndoStack::UndoStack(BaseContext* context, const Callback& onChange) : context_(context), onChange_ { onChange } {
-	auto initialState = &stack_.emplace_back(new Entry("Initial"))->state;
-    saveProjectState(context_->project(), initialState, nullptr, context_->modelChanges(), *context_->objectFactory());
+	stack_.emplace_back(new Entry("Initial"));
+	saveProjectState(context_->project(), *context_->objectFactory());
 }
 
 void UndoStack::reset() {
 	stack_.clear();
     index_ = 0;
-	auto initialState = &stack_.emplace_back(new Entry("Initial"))->state;
+	evictedEntries_ = 0;
+	compositeCommandDepth_ = 0;
+	stack_.emplace_back(new Entry("Initial"));
 	context_->modelChanges().reset();
-	saveProjectState(context_->project(), initialState, nullptr, context_->modelChanges(), *context_->objectFactory());
+	saveProjectState(context_->project(), *context_->objectFactory());
 
     raco::core::UndoState undoState;
     undoState.saveCurrentUndoState();
@@ -455,6 +705,10 @@ void UndoStack::resetUndoState(STRUCT_NODE node) {
     stack_.front()->undoState.push(node);
 }
 
+const UndoState &UndoStack::currentUndoState() const {
+    return stack_[index_]->undoState;
+}
+
 bool UndoStack::curIndexIsOpreatObject() {
     bool isObject = stack_[index_]->description.find("object") == std::string::npos ? false : true;
     return isObject;
@@ -465,18 +719,23 @@ bool UndoStack::canMerge(const DataChangeRecorder &changes) {
 }
 
 void UndoStack::push(const std::string &description, std::string mergeId) {
+	if (compositeCommandDepth_ > 0) {
+		// the model changes keep accumulating until the composite command ends
+		return;
+	}
 	stack_.resize(index_ + 1);
 	if (!mergeId.empty() && mergeId == stack_.back()->mergeId && canMerge(context_->modelChanges())) {
 		// mergable -> In-place update of the last stack state
-		updateProjectState(context_->project(), &stack_.back()->state, context_->modelChanges(), *context_->objectFactory());
+		updateProjectState(context_->project(), context_->modelChanges(), *context_->objectFactory());
 		stack_.back()->description = description;
 	} else {
-		// not mergable -> create and fill new state
+		// not mergable -> create new entry containing only the changes
         UndoState undoState = stack_.back()->undoState;
-		auto nextState = &stack_.emplace_back(new Entry(description, mergeId))->state;
-        stack_.back()->undoState = undoState;
+		auto &entry = stack_.emplace_back(new Entry(description, mergeId));
+        entry->undoState = undoState;
         ++index_;
-        saveProjectState(context_->project(), nextState, &stack_[index_ - 1]->state, context_->modelChanges(), *context_->objectFactory());
+		saveProjectChanges(context_->project(), context_->modelChanges(), entry->delta, entry->bytes, *context_->objectFactory());
+		evictEntries();
 	}
 
 	onChange_();
@@ -488,14 +747,50 @@ void UndoStack::push(const std::string &description, UndoState state) {
         return;
     }
     Entry *entry = new Entry(description);
-    entry->state = stack_.back()->state;
     stack_.resize(index_ + 1);
+    entry->bytes = state.memoryUsage(stack_.back()->undoState);
     entry->undoState = state;
     stack_.emplace_back(std::unique_ptr<Entry>(entry));
     ++index_;
+    evictEntries();
     onChange_();
 }
 
+void UndoStack::beginCompositeCommand() {
+	if (compositeCommandDepth_++ == 0) {
+		compositeCommandAborted_ = false;
+	}
+}
+
+void UndoStack::endCompositeCommand(const std::string &description, bool abort) {
+	if (compositeCommandDepth_ == 0) {
+		return;
+	}
+	compositeCommandAborted_ = compositeCommandAborted_ || abort;
+	if (--compositeCommandDepth_ > 0) {
+		return;
+	}
+	if (compositeCommandAborted_) {
+		// The snapshot is still at the state before the composite command, only the recorded objects need to be restored.
+		std::set<std::string> changedIDs;
+		const auto &modelChanges = context_->modelChanges();
+		for (const auto &obj : modelChanges.getAllChangedObjects()) {
+			changedIDs.insert(obj->objectID());
+		}
+		for (const auto &obj : modelChanges.getDeletedObjects()) {
+			changedIDs.insert(obj->objectID());
+		}
+		restoreProjectState(state_, context_->project(), *context_, *context_->objectFactory(), &changedIDs);
+		onChange_();
+	} else {
+		push(description);
+	}
+}
+
+bool UndoStack::isInCompositeCommand() const {
+	return compositeCommandDepth_ > 0;
+}
+
 size_t UndoStack::size() const {
 	return stack_.size();
 }
@@ -506,8 +801,23 @@ size_t UndoStack::getIndex() const {
 
 size_t UndoStack::setIndex(size_t newIndex, bool force) {
 	if (newIndex < size() && (newIndex != index_ || force)) {
-        index_ = newIndex;
-        restoreProjectState(&stack_[index_]->state, context_->project(), *context_, *context_->objectFactory());
+		// Move the snapshot to the new position and collect the objects changed on the way.
+		std::set<std::string> changedIDs;
+		for (; index_ > newIndex; --index_) {
+			applyDelta(stack_[index_]->delta, false, changedIDs);
+		}
+		for (; index_ < newIndex; ++index_) {
+			applyDelta(stack_[index_ + 1]->delta, true, changedIDs);
+		}
+		// Changes not pushed to the stack yet need to be reverted too.
+		const auto &modelChanges = context_->modelChanges();
+		for (const auto &obj : modelChanges.getAllChangedObjects()) {
+			changedIDs.insert(obj->objectID());
+		}
+		for (const auto &obj : modelChanges.getDeletedObjects()) {
+			changedIDs.insert(obj->objectID());
+		}
+        restoreProjectState(state_, context_->project(), *context_, *context_->objectFactory(), force ? nullptr : &changedIDs);
         restoreAnimationState(stack_[index_]->undoState);
         onChange_();
 	}
@@ -529,6 +839,54 @@ void UndoStack::redo() {
 UndoStack::Entry::Entry(std::string desc, std::string id) : description(desc), mergeId(id) {
 }
 
+void UndoStack::evictEntries() {
+	if (memoryBudget_ == 0) {
+		return;
+	}
+	auto bytes = memoryStatistics().bytes;
+	size_t evicted = 0;
+	// Fold the second entry into the first one: its delta is dropped together with the snapshots only it referenced.
+	while (bytes > memoryBudget_ && index_ > 1) {
+		auto &next = *stack_[1];
+		for (const auto &[id, change] : next.delta.objects) {
+			baseBytes_ -= change.before.bytes;
+		}
+		baseBytes_ -= next.delta.removedLinks.size() * LINK_BYTES;
+		baseBytes_ += next.bytes;
+		next.delta = Delta();
+		next.bytes = 0;
+		stack_.erase(stack_.begin());
+		--index_;
+		++evicted;
+		bytes = memoryStatistics().bytes;
+	}
+	if (evicted > 0) {
+		evictedEntries_ += evicted;
+		LOG_DEBUG(log_system::CONTEXT, "Dropped {} undo stack entries to stay within the memory budget: {} of {} bytes used", evicted, bytes, memoryBudget_);
+	}
+}
+
+void UndoStack::setMemoryBudget(size_t bytes) {
+	memoryBudget_ = bytes;
+}
+
+size_t UndoStack::memoryBudget() const {
+	return memoryBudget_;
+}
+
+UndoStack::MemoryStatistics UndoStack::memoryStatistics() const {
+	MemoryStatistics statistics;
+	statistics.entries = stack_.size();
+	statistics.baseBytes = baseBytes_;
+	statistics.bytes = baseBytes_;
+	for (const auto &entry : stack_) {
+		statistics.bytes += entry->bytes;
+	}
+	statistics.budget = memoryBudget_;
+	statistics.evictedEntries = evictedEntries_;
+	return statistics;
+}
+
 const std::string& UndoStack::description(size_t index) const {
 	return stack_.at(index)->description;
 }
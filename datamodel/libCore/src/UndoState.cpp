@@ -24,20 +24,68 @@
 #include "visual_curve/VisualCurveWidget.h"
 #include "FolderData/FolderDataManager.h"
 
+#include <algorithm>
 #include <cassert>
+#include <set>
 
 namespace raco::core {
 using namespace raco::visualCurve;
 
+namespace {
+bool sameFolder(const STRUCT_FOLDER &left, const STRUCT_FOLDER &right) {
+    if (left.folderName_ != right.folderName_ || left.curveList.size() != right.curveList.size() || left.folerList.size() != right.folerList.size()) {
+        return false;
+    }
+    if (!std::equal(left.curveList.begin(), left.curveList.end(), right.curveList.begin(), [](const STRUCT_CURVE_PROP &a, const STRUCT_CURVE_PROP &b) {
+            return a.curve_ == b.curve_ && a.visible_ == b.visible_;
+        })) {
+        return false;
+    }
+    return std::equal(left.folerList.begin(), left.folerList.end(), right.folerList.begin(), sameFolder);
+}
+
+size_t folderBytes(const STRUCT_FOLDER &folder) {
+    size_t bytes = sizeof(STRUCT_FOLDER) + folder.folderName_.capacity();
+    for (const auto &curve : folder.curveList) {
+        bytes += sizeof(STRUCT_CURVE_PROP) + curve.curve_.capacity();
+    }
+    for (const auto &child : folder.folerList) {
+        bytes += folderBytes(child);
+    }
+    return bytes;
+}
+}  // namespace
+
 UndoState::UndoState() {
 
 }
 
 void UndoState::saveCurrentUndoState() {
+    saveCurrentUndoState(UndoState());
+}
+
+void UndoState::saveCurrentUndoState(const UndoState &previous) {
     posData_ = raco::guiData::VisualCurvePosManager::GetInstance().convertDataStruct();
-    curveData_ = raco::guiData::CurveManager::GetInstance().convertCurveData();
-    folderData_ = raco::guiData::FolderDataManager::GetInstance().converFolderData();
-    nodeData_ = raco::guiData::NodeDataManager::GetInstance().convertCurveData();
+    curveData_ = raco::guiData::CurveManager::GetInstance().snapshotCurves(previous.curveData_);
+
+    STRUCT_FOLDER folder = raco::guiData::FolderDataManager::GetInstance().converFolderData();
+    if (previous.folderData_ && sameFolder(*previous.folderData_, folder)) {
+        folderData_ = previous.folderData_;
+    } else {
+        folderData_ = std::make_shared<const STRUCT_FOLDER>(std::move(folder));
+    }
+
+    STRUCT_NODE node = raco::guiData::NodeDataManager::GetInstance().convertCurveData();
+    activeNodeId_ = node.activeNodeId;
+    bindingMap_.clear();
+    for (auto &[animation, bindings] : node.bindingMap_) {
+        auto it = previous.bindingMap_.find(animation);
+        if (it != previous.bindingMap_.end() && *it->second == bindings) {
+            bindingMap_.emplace(animation, it->second);
+        } else {
+            bindingMap_.emplace(animation, std::make_shared<const BindingMap>(std::move(bindings)));
+        }
+    }
 }
 
 void UndoState::push(STRUCT_VISUAL_CURVE_POS data) {
@@ -45,23 +93,57 @@ void UndoState::push(STRUCT_VISUAL_CURVE_POS data) {
 }
 
 void UndoState::push(STRUCT_NODE node) {
-    nodeData_ = node;
+    activeNodeId_ = node.activeNodeId;
+    bindingMap_.clear();
+    for (auto &[animation, bindings] : node.bindingMap_) {
+        bindingMap_.emplace(animation, std::make_shared<const BindingMap>(std::move(bindings)));
+    }
 }
 
-STRUCT_VISUAL_CURVE_POS UndoState::visualPosData() {
+STRUCT_VISUAL_CURVE_POS UndoState::visualPosData() const {
     return posData_;
 }
 
-STRUCT_FOLDER UndoState::folderData() {
-    return folderData_;
+STRUCT_FOLDER UndoState::folderData() const {
+    return folderData_ ? *folderData_ : STRUCT_FOLDER();
 }
 
-std::list<STRUCT_CURVE> UndoState::curveData() {
+const std::vector<raco::guiData::SharedCurveSnapshot> &UndoState::curveData() const {
     return curveData_;
 }
 
-STRUCT_NODE UndoState::nodeData() {
-    return nodeData_;
+STRUCT_NODE UndoState::nodeData() const {
+    STRUCT_NODE node;
+    node.activeNodeId = activeNodeId_;
+    for (const auto &[animation, bindings] : bindingMap_) {
+        node.bindingMap_.emplace(animation, *bindings);
+    }
+    return node;
+}
+
+size_t UndoState::memoryUsage(const UndoState &previous) const {
+    size_t bytes = 0;
+    std::set<const raco::guiData::CurveSnapshot *> previousCurves;
+    for (const auto &curve : previous.curveData_) {
+        previousCurves.insert(curve.get());
+    }
+    for (const auto &curve : curveData_) {
+        if (previousCurves.find(curve.get()) == previousCurves.end()) {
+            bytes += curve->memoryUsage();
+        }
+    }
+    if (folderData_ && folderData_ != previous.folderData_) {
+        bytes += folderBytes(*folderData_);
+    }
+    for (const auto &[animation, bindings] : bindingMap_) {
+        auto it = previous.bindingMap_.find(animation);
+        if (it == previous.bindingMap_.end() || it->second != bindings) {
+            for (const auto &[property, curve] : *bindings) {
+                bytes += property.capacity() + curve.capacity();
+            }
+        }
+    }
+    return bytes;
 }
 
 }  // namespace raco::core
@@ -67,6 +67,35 @@ TEST_F(CommandInterfaceTest, set_double_fail) {
 	EXPECT_THROW(commandInterface.set({obj, &Foo::x_}, 2.0), std::runtime_error);
 }
 
+TEST_F(CommandInterfaceTest, set_values_fail) {
+	auto obj = create<Foo>("name");
+
+	EXPECT_THROW(commandInterface.setValues({{{obj, &Foo::x_}, 2.0}, {{obj, &Foo::b_}, 3.0}}), std::runtime_error);
+	EXPECT_EQ(*obj->x_, 2.5);
+	EXPECT_THROW(commandInterface.setValues({{{obj, {"no_such_property"}}, 2.0}}), std::runtime_error);
+
+	commandInterface.deleteObjects({obj});
+	EXPECT_THROW(commandInterface.setValues({{{obj, &Foo::x_}, 2.0}}), std::runtime_error);
+}
+
+TEST_F(CommandInterfaceTest, set_values_single_undo_entry) {
+	auto foo = create<Foo>("foo");
+	auto bar = create<Foo>("bar");
+	size_t undoSize = undoStack.size();
+
+	commandInterface.setValues({{{foo, &Foo::x_}, 2.0}, {{bar, &Foo::x_}, 3.0}});
+	EXPECT_EQ(*foo->x_, 2.0);
+	EXPECT_EQ(*bar->x_, 3.0);
+	EXPECT_EQ(undoStack.size(), undoSize + 1);
+
+	commandInterface.setValues({{{foo, &Foo::x_}, 2.0}, {{bar, &Foo::x_}, 3.0}});
+	EXPECT_EQ(undoStack.size(), undoSize + 1);
+
+	commandInterface.setValues({{{foo, &Foo::x_}, 4.0}}, false);
+	EXPECT_EQ(*foo->x_, 4.0);
+	EXPECT_EQ(undoStack.size(), undoSize + 1);
+}
+
 TEST_F(CommandInterfaceTest, set_string_fail) {
 	auto obj = create<Foo>("name");
 
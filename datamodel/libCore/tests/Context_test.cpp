@@ -264,6 +264,22 @@ TEST_F(ContextTest, MeshDeletion) {
 	EXPECT_EQ(project.instances().size(), 1);
 }
 
+TEST_F(ContextTest, FindReferencesToMesh) {
+	auto mesh = context.createObject(Mesh::typeDescription.typeName, "mesh");
+	auto unused = context.createObject(Mesh::typeDescription.typeName, "unused");
+	auto meshnode = context.createObject(MeshNode::typeDescription.typeName, "meshnode");
+	auto deleted = context.createObject(MeshNode::typeDescription.typeName, "deleted");
+	context.set(ValueHandle{meshnode, {"mesh"}}, mesh);
+	context.set(ValueHandle{deleted, {"mesh"}}, unused);
+
+	EXPECT_EQ(Queries::findAllReferencesTo(project, {mesh}), std::vector<ValueHandle>({ValueHandle{meshnode, {"mesh"}}}));
+	EXPECT_TRUE(Queries::findAllReferencesTo(project, {mesh, meshnode}).empty());
+
+	context.deleteObjects({deleted});
+	EXPECT_TRUE(Queries::findAllReferencesTo(project, {unused}).empty());
+	EXPECT_EQ(Queries::findAllUnreferencedObjects(project, Queries::isResource), std::vector<SEditorObject>({unused}));
+}
+
 TEST_F(ContextTest, MeshNode) {
 	SMesh mesh{new Mesh("mesh")};
 	SMeshNode meshnode{new MeshNode("meshnode")};
@@ -314,6 +330,33 @@ TEST_F(ContextTest, ObjectCreation) {
 	EXPECT_EQ(recorder.getCreatedObjects(), SEditorObjectSet({root, mnb, mnl}));
 }
 
+TEST_F(ContextTest, DeleteKeepsInstanceOrder) {
+	auto settings = project.settings();
+	auto node1 = context.createObject(Node::typeDescription.typeName, "node1");
+	auto mesh1 = context.createObject(Mesh::typeDescription.typeName, "mesh1");
+	auto node2 = context.createObject(Node::typeDescription.typeName, "node2");
+	auto mesh2 = context.createObject(Mesh::typeDescription.typeName, "mesh2");
+	auto node3 = context.createObject(Node::typeDescription.typeName, "node3");
+
+	EXPECT_EQ(project.instancesOfType(Node::typeDescription.typeName), std::vector<SEditorObject>({node1, node2, node3}));
+	EXPECT_EQ(project.instancesOfType(Mesh::typeDescription.typeName), std::vector<SEditorObject>({mesh1, mesh2}));
+
+	checkedDeleteObjects({node1, mesh2});
+
+	EXPECT_EQ(project.instances(), std::vector<SEditorObject>({settings, mesh1, node2, node3}));
+	EXPECT_EQ(project.instancesOfType(Node::typeDescription.typeName), std::vector<SEditorObject>({node2, node3}));
+	EXPECT_EQ(project.instancesOfType(Mesh::typeDescription.typeName), std::vector<SEditorObject>({mesh1}));
+
+	checkedDeleteObjects({mesh1, node3});
+	auto node4 = context.createObject(Node::typeDescription.typeName, "node4");
+
+	EXPECT_EQ(project.instances(), std::vector<SEditorObject>({settings, node2, node4}));
+	EXPECT_EQ(project.instancesOfType(Node::typeDescription.typeName), std::vector<SEditorObject>({node2, node4}));
+	EXPECT_TRUE(project.instancesOfType(Mesh::typeDescription.typeName).empty());
+	EXPECT_EQ(project.getInstanceByID(node4->objectID()), node4);
+	EXPECT_FALSE(project.isInstance(node3));
+}
+
 TEST_F(ContextTest, DeleteIsolatedNode) {
 	auto node = context.createObject(Node::typeDescription.typeName, "n");
 
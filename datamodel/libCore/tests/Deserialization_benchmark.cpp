@@ -0,0 +1,93 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/bmwcarit/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+// Project load benchmark on a synthetic project, not run as part of the tests:
+//   libCore_deserialization_benchmark [object count]
+
+#include "core/ProjectMigration.h"
+#include "core/Serialization.h"
+#include "core/SerializationKeys.h"
+#include "user_types/Mesh.h"
+#include "user_types/MeshNode.h"
+#include "user_types/Node.h"
+#include "user_types/UserObjectFactory.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+namespace {
+
+QJsonDocument createProject(size_t numObjects) {
+	auto& factory{raco::user_types::UserObjectFactory::getInstance()};
+
+	std::vector<raco::serialization::SReflectionInterface> instances;
+	raco::core::SEditorObject mesh;
+	for (size_t index = 0; index < numObjects; index++) {
+		auto name = std::to_string(index);
+		switch (index % 3) {
+			case 0:
+				mesh = factory.createObject(raco::user_types::Mesh::typeDescription.typeName, "mesh_" + name);
+				instances.emplace_back(mesh);
+				break;
+			case 1: {
+				auto meshNode = std::dynamic_pointer_cast<raco::user_types::MeshNode>(factory.createObject(raco::user_types::MeshNode::typeDescription.typeName, "meshnode_" + name));
+				meshNode->mesh_ = std::dynamic_pointer_cast<raco::user_types::Mesh>(mesh);
+				instances.emplace_back(meshNode);
+				break;
+			}
+			default:
+				instances.emplace_back(factory.createObject(raco::user_types::Node::typeDescription.typeName, "node_" + name));
+				break;
+		}
+	}
+
+	std::unordered_map<std::string, std::vector<int>> versions = {
+		{raco::serialization::keys::FILE_VERSION, {raco::serialization::RAMSES_PROJECT_FILE_VERSION}},
+		{raco::serialization::keys::RAMSES_VERSION, {1, 0, 0}},
+		{raco::serialization::keys::RAMSES_LOGIC_ENGINE_VERSION, {1, 0, 0}},
+		{raco::serialization::keys::RAMSES_COMPOSER_VERSION, {1, 0, 0}}};
+	return raco::serialization::serializeProject(versions, 1, instances, {}, {});
+}
+
+template <typename F>
+double measure(F&& func) {
+	auto start = std::chrono::steady_clock::now();
+	func();
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+	size_t numObjects = argc > 1 ? std::stoul(argv[1]) : 30000;
+
+	auto document = createProject(numObjects);
+	auto json = document.toJson();
+
+	QJsonDocument parsed;
+	double parseTime = measure([&]() {
+		parsed = QJsonDocument::fromJson(json);
+	});
+	size_t directCount = 0;
+	double directTime = measure([&]() {
+		directCount = raco::serialization::deserializeProject(parsed, "").objects.size();
+	});
+	size_t migrationCount = 0;
+	double migrationTime = measure([&]() {
+		migrationCount = raco::serialization::deserializeProjectWithMigration(parsed, "").objects.size();
+	});
+
+	std::cout << numObjects << " objects, " << json.size() / 1024 << " KiB" << std::endl;
+	std::cout << "  parse json:          " << parseTime << " ms" << std::endl;
+	std::cout << "  direct:              " << directTime << " ms (" << directCount << " objects)" << std::endl;
+	std::cout << "  with migration:      " << migrationTime << " ms (" << migrationCount << " objects)" << std::endl;
+	return directCount == migrationCount ? 0 : 1;
+}
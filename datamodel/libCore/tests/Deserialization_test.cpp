@@ -13,11 +13,14 @@
 #include "testing/TestEnvironmentCore.h"
 #include "testing/TestUtil.h"
 #include "core/ExternalReferenceAnnotation.h"
+#include "core/ProjectMigration.h"
+#include "user_types/Mesh.h"
 #include "user_types/LuaScript.h"
 #include "user_types/Material.h"
 #include "user_types/MeshNode.h"
 #include "user_types/Node.h"
 #include "user_types/Texture.h"
+#include "user_types/UserObjectFactory.h"
 
 #include "utils/FileUtils.h"
 
@@ -217,4 +220,64 @@ TEST_F(DeserializationTest, deserializeObjects_luaScriptLinkedToNode) {
 
 	std::set<std::string> refRootObjectIDs{"node_id", "lua_script_id"};
 	EXPECT_EQ(result->rootObjectIDs, refRootObjectIDs);
-}
\ No newline at end of file
+}
+
+TEST_F(DeserializationTest, deserializeProject_currentVersionMatchesMigrationPath) {
+	auto node = create<Node>("node");
+	auto mesh = create<Mesh>("mesh");
+	auto meshNode = create<MeshNode>("meshnode", node);
+	commandInterface.set({meshNode, {"mesh"}}, mesh);
+
+	std::unordered_map<std::string, std::vector<int>> versions = {
+		{raco::serialization::keys::FILE_VERSION, {raco::serialization::RAMSES_PROJECT_FILE_VERSION}},
+		{raco::serialization::keys::RAMSES_VERSION, {1, 0, 0}},
+		{raco::serialization::keys::RAMSES_LOGIC_ENGINE_VERSION, {1, 0, 0}},
+		{raco::serialization::keys::RAMSES_COMPOSER_VERSION, {1, 0, 0}}};
+	std::vector<raco::serialization::SReflectionInterface> instances{project.instances().begin(), project.instances().end()};
+	auto document = raco::serialization::serializeProject(versions, 1, instances, {}, {});
+
+	auto direct = raco::serialization::deserializeProject(document, "");
+	auto migrated = raco::serialization::deserializeProjectWithMigration(document, "");
+
+	ASSERT_EQ(direct.objects.size(), migrated.objects.size());
+	for (size_t index = 0; index < direct.objects.size(); index++) {
+		EXPECT_EQ(raco::serialization::test_helpers::serializeObject(direct.objects[index]), raco::serialization::test_helpers::serializeObject(migrated.objects[index]));
+	}
+
+	auto directMeshNode = raco::select<MeshNode>(direct.objects);
+	auto directMesh = raco::select<Mesh>(direct.objects);
+	EXPECT_EQ(*directMeshNode->mesh_, directMesh);
+	EXPECT_EQ(directMeshNode->getParent(), raco::select<Node>(direct.objects));
+}
+
+TEST_F(DeserializationTest, deserializeProject_largeProjectResolvesReferencesAcrossChunks) {
+	// Enough objects to be constructed on several threads, all meshnodes reference the last mesh.
+	auto& factory{UserObjectFactory::getInstance()};
+	auto mesh = std::dynamic_pointer_cast<Mesh>(factory.createObject(Mesh::typeDescription.typeName, "mesh"));
+	std::vector<raco::serialization::SReflectionInterface> instances;
+	for (size_t index = 0; index < 2000; index++) {
+		auto meshNode = std::dynamic_pointer_cast<MeshNode>(factory.createObject(MeshNode::typeDescription.typeName, "meshnode_" + std::to_string(index)));
+		meshNode->mesh_ = mesh;
+		instances.emplace_back(meshNode);
+	}
+	instances.emplace_back(mesh);
+
+	std::unordered_map<std::string, std::vector<int>> versions = {
+		{raco::serialization::keys::FILE_VERSION, {raco::serialization::RAMSES_PROJECT_FILE_VERSION}},
+		{raco::serialization::keys::RAMSES_VERSION, {1, 0, 0}},
+		{raco::serialization::keys::RAMSES_LOGIC_ENGINE_VERSION, {1, 0, 0}},
+		{raco::serialization::keys::RAMSES_COMPOSER_VERSION, {1, 0, 0}}};
+	auto document = raco::serialization::serializeProject(versions, 1, instances, {}, {});
+
+	auto result = raco::serialization::deserializeProject(document, "");
+
+	ASSERT_EQ(result.objects.size(), instances.size());
+	auto resultMesh = result.objects.back();
+	EXPECT_EQ(resultMesh->objectID(), mesh->objectID());
+	for (size_t index = 0; index + 1 < result.objects.size(); index++) {
+		auto meshNode = std::dynamic_pointer_cast<MeshNode>(result.objects[index]);
+		ASSERT_TRUE(meshNode != nullptr);
+		EXPECT_EQ(meshNode->objectID(), std::dynamic_pointer_cast<MeshNode>(instances[index])->objectID());
+		EXPECT_EQ(*meshNode->mesh_, resultMesh);
+	}
+}
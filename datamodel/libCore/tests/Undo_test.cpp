@@ -14,6 +14,7 @@
 #include "core/Project.h"
 #include "core/Queries.h"
 #include "core/ExternalReferenceAnnotation.h"
+#include "CurveData/CurveManager.h"
 #include "ramses_base/HeadlessEngineBackend.h"
 #include "testing/RacoBaseTest.h"
 #include "testing/TestEnvironmentCore.h"
@@ -1062,11 +1063,11 @@ end
 	checkLinks({{sprop, eprop, true}});
 
 	{
-		Project& stackProject = stack().back()->state;
+		const auto& stackState = undoStack.currentState();
 
-		auto stackLua = getInstance<LuaScript>(stackProject, "lua");
-		ASSERT_EQ(stackProject.links().size(), 1);
-		auto stackLink = *stackProject.links().begin();
+		auto stackLua = std::dynamic_pointer_cast<LuaScript>(stackState.objects.at(lua->objectID()).object);
+		ASSERT_EQ(stackState.links.size(), 1);
+		auto stackLink = *stackState.links.begin();
 
 		ValueHandle startProp{stackLua, stackLink->startPropertyNamesVector()};
 		EXPECT_TRUE(startProp && *stackLink->isValid_ || !startProp && !*stackLink->isValid_);
@@ -1491,4 +1492,191 @@ TEST_F(UndoTest, referenced_object_moved_into_prefab) {
 
 	commandInterface.undoStack().redo();
 	ASSERT_EQ(raco::core::ValueHandle(renderPass, &raco::user_types::RenderPass::camera_).asRef(), SEditorObject());
-}
\ No newline at end of file
+}
+
+TEST_F(UndoTest, entry_stores_only_changed_objects) {
+	std::vector<SEditorObject> nodes;
+	for (int index = 0; index < 20; index++) {
+		nodes.emplace_back(create<Node>("node " + std::to_string(index)));
+	}
+	auto statsBefore = undoStack.memoryStatistics();
+
+	commandInterface.set({nodes[3], {"translation", "x"}}, 2.0);
+
+	const auto& delta = stack().back()->delta;
+	ASSERT_EQ(delta.objects.size(), 1);
+	EXPECT_EQ(delta.objects.begin()->first, nodes[3]->objectID());
+	EXPECT_TRUE(delta.addedLinks.empty());
+	EXPECT_TRUE(delta.removedLinks.empty());
+
+	auto statsAfter = undoStack.memoryStatistics();
+	EXPECT_EQ(statsAfter.entries, statsBefore.entries + 1);
+	EXPECT_GT(statsAfter.bytes, statsBefore.bytes);
+	EXPECT_LT(statsAfter.bytes - statsBefore.bytes, statsBefore.bytes / 10);
+
+	// merged into the same entry
+	commandInterface.set({nodes[3], {"translation", "x"}}, 3.0);
+	EXPECT_EQ(undoStack.memoryStatistics().entries, statsAfter.entries);
+	EXPECT_EQ(stack().back()->delta.objects.size(), 1);
+
+	undoStack.undo();
+	EXPECT_EQ(ValueHandle(nodes[3], {"translation", "x"}).asDouble(), 0.0);
+	undoStack.redo();
+	EXPECT_EQ(ValueHandle(nodes[3], {"translation", "x"}).asDouble(), 3.0);
+}
+
+TEST_F(UndoTest, delete_undo_keeps_instance_order) {
+	auto first = create<Node>("first");
+	auto second = create<Node>("second");
+	auto third = create<Node>("third");
+
+	commandInterface.deleteObjects({first, second});
+	checkInstances({"ProjectSettings", "third"}, {"first", "second"});
+
+	undoStack.undo();
+	std::vector<std::string> names;
+	for (const auto& obj : project.instances()) {
+		if (obj->isType<Node>()) {
+			names.emplace_back(obj->objectName());
+		}
+	}
+	EXPECT_EQ(names, std::vector<std::string>({"third", "first", "second"}));
+
+	undoStack.redo();
+	checkInstances({"ProjectSettings", "third"}, {"first", "second"});
+}
+
+TEST_F(UndoTest, jump_over_several_entries) {
+	auto node = create<Node>("node");
+	auto meshNode = create<MeshNode>("meshnode");
+	size_t start = undoStack.getIndex();
+
+	commandInterface.set({node, {"translation", "x"}}, 1.0);
+	commandInterface.moveScenegraphChildren({meshNode}, node);
+	commandInterface.set({meshNode, {"translation", "y"}}, 2.0);
+	auto lua = create<LuaScript>("lua");
+	commandInterface.deleteObjects({node});
+	size_t end = undoStack.getIndex();
+	checkInstances({"ProjectSettings", "lua"}, {"node", "meshnode"});
+
+	undoStack.setIndex(start);
+	checkInstances({"ProjectSettings", "node", "meshnode"}, {"lua"});
+	node = getInstance<Node>("node");
+	meshNode = getInstance<MeshNode>("meshnode");
+	EXPECT_EQ(ValueHandle(node, {"translation", "x"}).asDouble(), 0.0);
+	EXPECT_EQ(meshNode->getParent(), nullptr);
+
+	undoStack.setIndex(end - 1);
+	checkInstances({"ProjectSettings", "node", "meshnode", "lua"}, {});
+	node = getInstance<Node>("node");
+	meshNode = getInstance<MeshNode>("meshnode");
+	EXPECT_EQ(ValueHandle(node, {"translation", "x"}).asDouble(), 1.0);
+	EXPECT_EQ(ValueHandle(meshNode, {"translation", "y"}).asDouble(), 2.0);
+	EXPECT_EQ(meshNode->getParent(), node);
+
+	undoStack.setIndex(end);
+	checkInstances({"ProjectSettings", "lua"}, {"node", "meshnode"});
+}
+
+TEST_F(UndoTest, memory_budget_drops_oldest_entries) {
+	auto node = create<Node>("node");
+	// alternate between properties to prevent merging of the entries
+	for (int index = 1; index <= 5; index++) {
+		commandInterface.set({node, {"translation", index % 2 ? "x" : "y"}}, static_cast<double>(index));
+	}
+	EXPECT_EQ(undoStack.memoryStatistics().evictedEntries, 0);
+	auto size = undoStack.size();
+
+	undoStack.setMemoryBudget(1);
+	commandInterface.set({node, {"translation", "z"}}, 6.0);
+
+	auto stats = undoStack.memoryStatistics();
+	EXPECT_EQ(stats.budget, 1);
+	EXPECT_EQ(stats.entries, 2);
+	EXPECT_EQ(stats.evictedEntries, size - 1);
+	EXPECT_EQ(undoStack.size(), 2);
+	EXPECT_EQ(undoStack.getIndex(), 1);
+
+	undoStack.undo();
+	EXPECT_EQ(ValueHandle(node, {"translation", "z"}).asDouble(), 0.0);
+	EXPECT_EQ(ValueHandle(node, {"translation", "x"}).asDouble(), 5.0);
+	EXPECT_FALSE(undoStack.canUndo());
+	undoStack.redo();
+	EXPECT_EQ(ValueHandle(node, {"translation", "z"}).asDouble(), 6.0);
+
+	undoStack.setMemoryBudget(0);
+	commandInterface.set({node, {"translation", "x"}}, 7.0);
+	EXPECT_EQ(undoStack.size(), 3);
+}
+
+TEST_F(UndoTest, composite_command_creates_single_entry) {
+	auto size = undoStack.size();
+	undoStack.beginCompositeCommand();
+	auto node = create<Node>("node");
+	commandInterface.set({node, {"translation", "x"}}, 1.0);
+	undoStack.beginCompositeCommand();
+	commandInterface.set({node, {"translation", "y"}}, 2.0);
+	undoStack.endCompositeCommand("inner");
+	EXPECT_EQ(undoStack.size(), size);
+	EXPECT_TRUE(undoStack.isInCompositeCommand());
+	undoStack.endCompositeCommand("composite");
+	EXPECT_FALSE(undoStack.isInCompositeCommand());
+
+	EXPECT_EQ(undoStack.size(), size + 1);
+	EXPECT_EQ(undoStack.description(undoStack.getIndex()), "composite");
+
+	undoStack.undo();
+	checkInstances({"ProjectSettings"}, {"node"});
+	undoStack.redo();
+	checkInstances({"ProjectSettings", "node"}, {});
+	auto redoneNode = project.getInstanceByID(node->objectID());
+	EXPECT_EQ(ValueHandle(redoneNode, {"translation", "x"}).asDouble(), 1.0);
+	EXPECT_EQ(ValueHandle(redoneNode, {"translation", "y"}).asDouble(), 2.0);
+}
+
+TEST_F(UndoTest, composite_command_abort_reverts_changes) {
+	auto node = create<Node>("node");
+	auto size = undoStack.size();
+	undoStack.beginCompositeCommand();
+	commandInterface.set({node, {"translation", "x"}}, 1.0);
+	create<Node>("other");
+	undoStack.endCompositeCommand("composite", true);
+
+	EXPECT_EQ(undoStack.size(), size);
+	checkInstances({"ProjectSettings", "node"}, {"other"});
+	EXPECT_EQ(ValueHandle(node, {"translation", "x"}).asDouble(), 0.0);
+}
+
+TEST_F(UndoTest, animation_state_shares_unchanged_curves) {
+	using namespace raco::guiData;
+	auto &curveManager = CurveManager::GetInstance();
+	for (auto name : {"curve1", "curve2"}) {
+		auto curve = new Curve;
+		curve->setCurveName(name);
+		curve->insertPoint(PointData{0, LINER, 1.0});
+		curveManager.addCurve(curve);
+	}
+	UndoState first;
+	first.saveCurrentUndoState(undoStack.currentUndoState());
+	undoStack.push("add curves", first);
+
+	curveManager.getCurve("curve2")->insertPoint(PointData{10, LINER, 2.0});
+	UndoState second;
+	second.saveCurrentUndoState(undoStack.currentUndoState());
+	undoStack.push("edit curve2", second);
+
+	ASSERT_EQ(second.curveData().size(), 2);
+	EXPECT_EQ(second.curveData()[0], first.curveData()[0]);
+	EXPECT_NE(second.curveData()[1], first.curveData()[1]);
+	EXPECT_EQ(second.memoryUsage(first), second.curveData()[1]->memoryUsage());
+
+	auto curve1 = curveManager.getCurve("curve1");
+	undoStack.undo();
+	EXPECT_EQ(curveManager.getCurve("curve1"), curve1);
+	EXPECT_EQ(curveManager.getCurve("curve2")->getPointSize(), 1);
+	undoStack.redo();
+	EXPECT_EQ(curveManager.getCurve("curve2")->getPointSize(), 2);
+	EXPECT_EQ(curveManager.getCurve("curve2")->getRevision(), second.curveData()[1]->revision_);
+
+	curveManager.clearCurve();
+}
@@ -2,6 +2,7 @@
 #define GLTFANIMATIONMANAGER_H
 
 #include <QObject>
+#include <array>
 #include "signal/SignalProxy.h"
 #include "user_types/Animation.h"
 #include "user_types/AnimationChannel.h"
@@ -9,6 +10,7 @@
 #include "NodeData/nodeManager.h"
 #include "AnimationData/animationData.h"
 #include "CurveData/CurveManager.h"
+#include "CurveData/CurveReducer.h"
 
 #define SYMBOL_POINT        std::string(".")
 #define SYMBOL_UNDERLINE    std::string("_")
@@ -28,17 +30,38 @@ class ConvertEditorAnimation : public QObject {
 public:
     explicit ConvertEditorAnimation(raco::core::CommandInterface* commandInterface, QObject *parent = nullptr);
     void commandInterface(raco::core::CommandInterface* commandInterface);
+    // keys of imported curves are reduced within this tolerance, 0 keeps every key
+    void setKeyReduceTolerance(double tolerance);
 public Q_SLOTS:
     void slotUpdateGltfAnimation(const std::set<raco::core::ValueHandle> &handles, QString name);
+Q_SIGNALS:
+    // emitted after an import in which keys were reduced
+    void sigKeysReduced(QString animation, qulonglong removedKeys, qulonglong importedKeys, double tolerance);
 private:
     void updateGltfAnimation(std::string animation);
-    void updateOneGltfCurve(raco::guiData::NodeData *nodeData, std::vector<float> keyFrames, std::vector<std::vector<float>> propertyData, raco::core::MeshAnimationInterpolation interpolation, std::string property, std::string node);
-    bool insertCurve(int keyFrame, float data, std::string curve, raco::core::MeshAnimationInterpolation interpolation);
+    // keys of one channel, converted to editor curves without touching the curve or node data
+    struct GltfChannelCurves {
+        raco::guiData::NodeData *nodeData_{nullptr};
+        raco::core::SharedAnimationSamplerData samplerData_;
+        std::string property_;
+        std::string node_;
+        std::array<std::string, 3> props_;
+        std::array<std::string, 3> curves_;
+        std::array<raco::guiData::PointColumns, 3> columns_;
+        std::array<int, 3> insertCount_{0, 0, 0};
+        size_t importedKeys_{0};
+        size_t removedKeys_{0};
+    };
+
+    void convertOneGltfChannel(GltfChannelCurves &channel) const;
+    void updateOneGltfCurve(GltfChannelCurves &channel);
+    bool insertCurve(const std::string &curve, raco::guiData::PointColumns &&columns);
 private:
     raco::core::CommandInterface* commandInterface_{nullptr};
     std::vector<raco::user_types::AnimationChannel *> animationChannels_;
     std::vector<std::string> animationNodes_;
     QString curAnimation_;
+    raco::guiData::CurveReducer keyReducer_{0.0};
 };
 
 #endif // GLTFANIMATIONMANAGER_H
@@ -1,9 +1,62 @@
 #include "animation_editor/ConvertEditorAnimation.h"
 #include "utils/MathUtils.h"
+#include "log_system/log.h"
+
+#include <atomic>
+#include <future>
+#include <thread>
 
 
 #define PI 3.141592653589793238462643f
 static const int rotationSize{4};
+static const int propertySize{3};
+
+// run func(0) .. func(count - 1) on up to one thread per core. Exceptions are rethrown on the
+// calling thread after all workers have finished.
+template <typename Func>
+static void parallelFor(size_t count, Func func) {
+    size_t threadCount = std::min<size_t>(count, std::max(1u, std::thread::hardware_concurrency()));
+    if (threadCount <= 1) {
+        for (size_t i{0}; i < count; ++i) {
+            func(i);
+        }
+        return;
+    }
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    auto work = [&]() {
+        try {
+            for (size_t i = next++; i < count && !failed; i = next++) {
+                func(i);
+            }
+        } catch (...) {
+            failed = true;
+            throw;
+        }
+    };
+    std::vector<std::future<void>> futures;
+    for (size_t i{1}; i < threadCount; ++i) {
+        futures.emplace_back(std::async(std::launch::async, work));
+    }
+    std::exception_ptr error;
+    try {
+        work();
+    } catch (...) {
+        error = std::current_exception();
+    }
+    for (auto &future : futures) {
+        try {
+            future.get();
+        } catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
 
 double fixRotationValue(double value) {
     double decimal = value - int(value);
@@ -22,6 +75,10 @@ void ConvertEditorAnimation::commandInterface(raco::core::CommandInterface *comm
     commandInterface_ = commandInterface;
 }
 
+void ConvertEditorAnimation::setKeyReduceTolerance(double tolerance) {
+    keyReducer_.setTolerance(tolerance);
+}
+
 void ConvertEditorAnimation::slotUpdateGltfAnimation(const std::set<raco::core::ValueHandle> &handles, QString fileName) {
     animationChannels_.clear();
     animationNodes_.clear();
@@ -90,6 +147,8 @@ void ConvertEditorAnimation::updateGltfAnimation(std::string animation) {
         Q_EMIT raco::signal::signalProxy::GetInstance().sigUpdateActiveAnimation_From_AnimationLogic(curAnimation_);
         Q_EMIT raco::signal::signalProxy::GetInstance().sigInitAnimationView();
         //
+        std::vector<GltfChannelCurves> channels;
+        channels.reserve(animationChannels_.size());
         for (int i{0}; i < animationChannels_.size(); ++i) {
             raco::user_types::AnimationChannel *aniChannel = animationChannels_.at(i);
             std::string path = animationNodes_.at(i);
@@ -98,15 +157,33 @@ void ConvertEditorAnimation::updateGltfAnimation(std::string animation) {
             std::string property = qstrNode.split(".").at(1).toStdString();
 
             raco::guiData::NodeData *nodeData = raco::guiData::NodeDataManager::GetInstance().searchNodeByName(node);
-            if (nodeData && aniChannel) {
-                std::vector<float> keyFrames = aniChannel->currentSamplerData_.get()->input;
-                std::vector<std::vector<float>> propertyData = aniChannel->currentSamplerData_.get()->output;
-                raco::core::MeshAnimationInterpolation interpolation = aniChannel->currentSamplerData_.get()->interpolation;
-
-                // insert curves
-                updateOneGltfCurve(nodeData, keyFrames, propertyData, interpolation, property, node);
+            if (nodeData && aniChannel && aniChannel->currentSamplerData_) {
+                GltfChannelCurves channel;
+                channel.nodeData_ = nodeData;
+                channel.samplerData_ = aniChannel->currentSamplerData_;
+                channel.property_ = property;
+                channel.node_ = node;
+                channels.push_back(std::move(channel));
             }
         }
+
+        // channels are independent, their keys are converted in parallel
+        parallelFor(channels.size(), [this, &channels](size_t index) {
+            convertOneGltfChannel(channels[index]);
+        });
+
+        // insert curves
+        size_t importedKeys{0};
+        size_t removedKeys{0};
+        for (auto &channel : channels) {
+            importedKeys += channel.importedKeys_;
+            removedKeys += channel.removedKeys_;
+            updateOneGltfCurve(channel);
+        }
+        if (removedKeys > 0) {
+            LOG_INFO(raco::log_system::COMMON, "Animation '{}': {} of {} keys removed within tolerance {}", animation, removedKeys, importedKeys, keyReducer_.getTolerance());
+            Q_EMIT sigKeysReduced(curAnimation_, removedKeys, importedKeys, keyReducer_.getTolerance());
+        }
     }
     Q_EMIT raco::signal::signalProxy::GetInstance().sigInitCurveView();
     Q_EMIT raco::signal::signalProxy::GetInstance().sigRepaintTimeAixs_From_CurveUI();
@@ -158,140 +235,110 @@ std::array<double, 3> Eul_FromQuat(float x, float y, float z, float w) {
 }
 
 
-void ConvertEditorAnimation::updateOneGltfCurve(raco::guiData::NodeData *nodeData, std::vector<float> keyFrames, std::vector<std::vector<float>> propertyData, raco::core::MeshAnimationInterpolation interpolation, std::string property, std::string node)
-{
-    auto insertBindingItem = [=](std::string prop, std::string curve)->bool {
-        std::string animation = curAnimation_.toStdString();
-        std::map<std::string, std::string> bindingMap;
-        if (nodeData->NodeExtendRef().curveBindingRef().getPropCurve(animation, bindingMap)) {
-            auto it = bindingMap.find(prop);
-            if (it != bindingMap.end()) {
-                return false;
-            }
-            nodeData->NodeExtendRef().curveBindingRef().insertBindingDataItem(animation, prop, curve);
-        } else {
-            std::map<std::string, std::string> bindingMap;
-            bindingMap.emplace(prop, curve);
-            nodeData->NodeExtendRef().curveBindingRef().insertAnimation(animation, bindingMap);
-        }
-        return true;
-    };
-
-    if (keyFrames.empty()) {
+void ConvertEditorAnimation::convertOneGltfChannel(GltfChannelCurves &channel) const {
+    const std::vector<float> &keyFrames = channel.samplerData_->input;
+    const std::vector<std::vector<float>> &propertyData = channel.samplerData_->output;
+    size_t size = std::min(keyFrames.size(), propertyData.size());
+    if (size == 0) {
+        return;
+    }
+    // only vec3 properties and rotation quaternions are shown as editor curves
+    size_t dataSize = propertyData.front().size();
+    if (dataSize != propertySize && dataSize != rotationSize) {
         return;
     }
 
-    std::string propX = property + PROP_X;
-    std::string propY = property + PROP_Y;
-    std::string propZ = property + PROP_Z;
-    std::string curveX = curAnimation_.toStdString() + SYMBOL_UNDERLINE + node + SYMBOL_POINT + propX;
-    std::string curveY = curAnimation_.toStdString() + SYMBOL_UNDERLINE + node + SYMBOL_POINT + propY;
-    std::string curveZ = curAnimation_.toStdString() + SYMBOL_UNDERLINE + node + SYMBOL_POINT + propZ;
+    std::string animation = curAnimation_.toStdString();
+    const std::string suffixes[propertySize] = {PROP_X, PROP_Y, PROP_Z};
+    for (int i{0}; i < propertySize; ++i) {
+        channel.props_[i] = channel.property_ + suffixes[i];
+        channel.curves_[i] = animation + SYMBOL_UNDERLINE + channel.node_ + SYMBOL_POINT + channel.props_[i];
+        channel.columns_[i].reserve(size);
+    }
 
-    float lastX{0},lastY{0},lastZ{0};
-    float lastEulerX{0},lastEulerY{0},lastEulerZ{0};
-    int invalidIndexX{0},invalidIndexY{0},invalidIndexZ{0};
+    raco::guiData::PointData point;
+    switch (channel.samplerData_->interpolation) {
+    case raco::core::MeshAnimationInterpolation::Linear: {
+        point.interPolationType_ = raco::guiData::EInterPolationType::LINER;
+        break;
+    }
+    case raco::core::MeshAnimationInterpolation::Step: {
+        point.interPolationType_ = raco::guiData::EInterPolationType::STEP;
+        break;
+    }
+    case raco::core::MeshAnimationInterpolation::CubicSpline: {
+        point.interPolationType_ = raco::guiData::EInterPolationType::BESIER_SPLINE;
+        break;
+    }
+    }
 
-    for (int i{0}; i < keyFrames.size(); ++i) {
-        int keyFrame = qRound(keyFrames.at(i) * 24);
-        std::vector<float> data = propertyData.at(i);
-        bool isValid{false};
-        if (i + 1 < keyFrames.size()) {
-            std::vector<float> nextData = propertyData.at(i + 1);
-            if (nextData != data) {
-                isValid = true;
-            }
+    float last[propertySize]{0, 0, 0};
+    float lastEuler[propertySize]{0, 0, 0};
+    for (size_t i{0}; i < size; ++i) {
+        const std::vector<float> &data = propertyData[i];
+        if (data.size() != dataSize) {
+            continue;
         }
+        point.keyFrame_ = qRound(keyFrames[i] * 24);
+        bool isValid = i + 1 < size && propertyData[i + 1] != data;
 
         // calculate rotation property data
-        if (data.size() == rotationSize) {
+        if (dataSize == rotationSize) {
             auto rotation = Eul_FromQuat(data[ROTATION_X], data[ROTATION_Y], data[ROTATION_Z], data[ROTATION_W]);
-            auto eulerRotation = raco::utils::math::eulerAngle(lastEulerX, lastEulerY, lastEulerZ, rotation[ROTATION_X], rotation[ROTATION_Y], rotation[ROTATION_Z]);
-
-            lastEulerX = eulerRotation[ROTATION_X];
-            lastEulerY = eulerRotation[ROTATION_Y];
-            lastEulerZ = eulerRotation[ROTATION_Z];
-
-            insertBindingItem(propX, curveX);
-            insertBindingItem(propY, curveY);
-            insertBindingItem(propZ, curveZ);
-            insertCurve(keyFrame, eulerRotation[ROTATION_X], curveX, interpolation);
-            insertCurve(keyFrame, eulerRotation[ROTATION_Y], curveY, interpolation);
-            insertCurve(keyFrame, eulerRotation[ROTATION_Z], curveZ, interpolation);
+            auto eulerRotation = raco::utils::math::eulerAngle(lastEuler[ROTATION_X], lastEuler[ROTATION_Y], lastEuler[ROTATION_Z], rotation[ROTATION_X], rotation[ROTATION_Y], rotation[ROTATION_Z]);
+            for (int c{0}; c < propertySize; ++c) {
+                lastEuler[c] = static_cast<float>(eulerRotation[c]);
+                point.data_ = eulerRotation[c];
+                channel.columns_[c].append(point);
+            }
             continue;
         }
 
-        // insert translation/scale property data
-        if ((data[ROTATION_X] != lastX || isValid) || i == 0) {
-            insertBindingItem(propX, curveX);
-            insertCurve(keyFrame, data[ROTATION_X], curveX, interpolation);
-            lastX = data[ROTATION_X];
-            invalidIndexX++;
-        }
-        if ((data[ROTATION_Y] != lastY || isValid) || i == 0) {
-            insertBindingItem(propY, curveY);
-            insertCurve(keyFrame, data[ROTATION_Y], curveY, interpolation);
-            lastY = data[ROTATION_Y];
-            invalidIndexY++;
-        }
-        if ((data[ROTATION_Z] != lastZ || isValid) || i == 0) {
-            insertBindingItem(propZ, curveZ);
-            insertCurve(keyFrame, data[ROTATION_Z], curveZ, interpolation);
-            lastZ = data[ROTATION_Z];
-            invalidIndexZ++;
+        // translation/scale keys are only kept where the value changes
+        for (int c{0}; c < propertySize; ++c) {
+            if (data[c] != last[c] || isValid || i == 0) {
+                point.data_ = static_cast<double>(data[c]);
+                channel.columns_[c].append(point);
+                last[c] = data[c];
+                channel.insertCount_[c]++;
+            }
         }
     }
-    // handle invalid property data
-    if (invalidIndexX == 1) {
-        nodeData->NodeExtendRef().curveBindingRef().deleteBindingDataItem(curAnimation_.toStdString(), propX, curveX);
-        if (raco::guiData::CurveManager::GetInstance().getCurve(curveX)) {
-            raco::guiData::CurveManager::GetInstance().takeCurve(curveX);
-        }
+
+    for (auto &columns : channel.columns_) {
+        channel.importedKeys_ += columns.size();
+        channel.removedKeys_ += keyReducer_.reduce(columns);
     }
-    if (invalidIndexY == 1) {
-        nodeData->NodeExtendRef().curveBindingRef().deleteBindingDataItem(curAnimation_.toStdString(), propY, curveY);
-        if (raco::guiData::CurveManager::GetInstance().getCurve(curveY)) {
-            raco::guiData::CurveManager::GetInstance().takeCurve(curveY);
-        }
+}
+
+void ConvertEditorAnimation::updateOneGltfCurve(GltfChannelCurves &channel) {
+    if (channel.curves_[0].empty()) {
+        return;
     }
-    if (invalidIndexZ == 1) {
-        nodeData->NodeExtendRef().curveBindingRef().deleteBindingDataItem(curAnimation_.toStdString(), propZ, curveZ);
-        if (raco::guiData::CurveManager::GetInstance().getCurve(curveZ)) {
-            raco::guiData::CurveManager::GetInstance().takeCurve(curveZ);
+    std::string animation = curAnimation_.toStdString();
+    auto &curveBinding = channel.nodeData_->NodeExtendRef().curveBindingRef();
+    for (int i{0}; i < propertySize; ++i) {
+        // a constant property has a single key, it doesn't get a curve
+        if (channel.insertCount_[i] == 1) {
+            curveBinding.deleteBindingDataItem(animation, channel.props_[i], channel.curves_[i]);
+            if (raco::guiData::CurveManager::GetInstance().getCurve(channel.curves_[i])) {
+                raco::guiData::CurveManager::GetInstance().takeCurve(channel.curves_[i]);
+            }
+            continue;
         }
+        curveBinding.insertBindingDataItem(animation, channel.props_[i], channel.curves_[i]);
+        insertCurve(channel.curves_[i], std::move(channel.columns_[i]));
     }
 }
 
-bool ConvertEditorAnimation::insertCurve(int keyFrame, float data, std::string curve, raco::core::MeshAnimationInterpolation interpolation) {
+bool ConvertEditorAnimation::insertCurve(const std::string &curve, raco::guiData::PointColumns &&columns) {
     raco::guiData::Curve *curveData = raco::guiData::CurveManager::GetInstance().getCurve(curve);
     if (curveData == nullptr) {
         curveData = new raco::guiData::Curve();
+        curveData->setCurveName(curve);
+        curveData->setDataType(raco::guiData::EDataType::Type_FLOAT);
+        raco::guiData::CurveManager::GetInstance().addCurve(curveData);
     }
-    curveData->setCurveName(curve);
-    curveData->setDataType(raco::guiData::EDataType::Type_FLOAT);
-    raco::guiData::Point *point = new raco::guiData::Point;
-    point->setKeyFrame(keyFrame);
-    point->setDataValue(static_cast<double>(data));
-
-    raco::guiData::EInterPolationType type = raco::guiData::EInterPolationType::LINER;
-
-    switch(interpolation) {
-    case raco::core::MeshAnimationInterpolation::Linear:{
-        type = raco::guiData::EInterPolationType::LINER;
-        break;
-    }
-    case raco::core::MeshAnimationInterpolation::Step:{
-        type = raco::guiData::EInterPolationType::STEP;
-        break;
-    }
-    case raco::core::MeshAnimationInterpolation::CubicSpline: {
-        type = raco::guiData::EInterPolationType::BESIER_SPLINE;
-        break;
-    }
-    }
-    point->setInterPolationType(type);
-    curveData->insertPoint(point);
-    raco::guiData::CurveManager::GetInstance().addCurve(curveData);
-
+    curveData->insertPoints(std::move(columns));
     return true;
 }
@@ -620,92 +620,27 @@ void InitCurveJson(QJsonArray& jsonObj) {
         curveJson.insert(JSON_NAME, QString::fromStdString(curve->getCurveName()));
         curveJson.insert(JSON_DATA_TYPE, int(curve->getDataType()));
 		QJsonArray pointList;
-		for (auto point : curve->getPointList()) {
+        // keys are stored as scalar columns whatever the data type, LoadCurveJson reads them back the same way
+        auto keyFrames = curve->getKeyFrames();
+        auto interPolationTypes = curve->getInterPolationTypes();
+        auto dataValues = curve->getDataValues();
+        auto leftTagents = curve->getLeftTagents();
+        auto rightTagents = curve->getRightTagents();
+        auto leftKeyFrames = curve->getLeftKeyFrames();
+        auto leftDataValues = curve->getLeftDataValues();
+        auto rightKeyFrames = curve->getRightKeyFrames();
+        auto rightDataValues = curve->getRightDataValues();
+        for (size_t index = 0; index < keyFrames.size(); index++) {
             QJsonObject pointJson;
-            pointJson.insert(JSON_KEYFRAME, point->getKeyFrame());
-            pointJson.insert(JSON_INTERPOLATION_TYPE, int(point->getInterPolationType()));
-            pointJson.insert(JSON_LEFT_KEYFRAME, point->getLeftKeyFrame());
-            if (point->getLeftData().type() == typeid(double)) {
-                qDebug() << "left:" << std::any_cast<double>(point->getLeftData());
-                pointJson.insert(JSON_LEFT_DATA, std::any_cast<double>(point->getLeftData()));
-            }
-            pointJson.insert(JSON_RIGHT_KEYFRAME, point->getRightKeyFrame());
-            if (point->getRightData().type() == typeid(double)) {
-                qDebug() << "right:" << std::any_cast<double>(point->getRightData());
-                pointJson.insert(JSON_RIGHT_DATA, std::any_cast<double>(point->getRightData()));
-            }
-
-			if (raco::guiData::Type_FLOAT == curve->getDataType()) {
-				if (point->getDataValue().type() == typeid(float)) {
-                    pointJson.insert(JSON_DATA, std::any_cast<float>(point->getDataValue()));
-                    pointJson.insert(JSON_LEFT_TANGENT, std::any_cast<float>(point->getLeftTagent()));
-                    pointJson.insert(JSON_RIGHT_TANGENT, std::any_cast<float>(point->getRightTagent()));
-				}
-
-				if (point->getDataValue().type() == typeid(double)) {
-                    pointJson.insert(JSON_DATA, std::any_cast<double>(point->getDataValue()));
-                    pointJson.insert(JSON_LEFT_TANGENT, std::any_cast<double>(point->getLeftTagent()));
-                    pointJson.insert(JSON_RIGHT_TANGENT, std::any_cast<double>(point->getRightTagent()));
-				}
-			}
-
-			if (raco::guiData::Type_VEC2 == curve->getDataType()) {
-				QJsonObject dataJson;
-                dataJson.insert(JSON_X, std::any_cast<Vec2>(point->getDataValue()).x);
-                dataJson.insert(JSON_Y, std::any_cast<Vec2>(point->getDataValue()).y);
-                pointJson.insert(JSON_DATA, dataJson);
-
-				QJsonObject leftTagentJson;
-                leftTagentJson.insert(JSON_X, std::any_cast<Vec2>(point->getLeftTagent()).x);
-                leftTagentJson.insert(JSON_Y, std::any_cast<Vec2>(point->getLeftTagent()).y);
-                pointJson.insert(JSON_LEFT_TANGENT, leftTagentJson);
-
-				QJsonObject rightTagentJson;
-                rightTagentJson.insert(JSON_X, std::any_cast<Vec2>(point->getRightTagent()).x);
-                rightTagentJson.insert(JSON_Y, std::any_cast<Vec2>(point->getRightTagent()).y);
-                pointJson.insert(JSON_RIGHT_TANGENT, rightTagentJson);
-			}
-			if (raco::guiData::Type_VEC3 == curve->getDataType()) {
-				QJsonObject dataJson;
-                dataJson.insert(JSON_X, std::any_cast<Vec3>(point->getDataValue()).x);
-                dataJson.insert(JSON_Y, std::any_cast<Vec3>(point->getDataValue()).y);
-                dataJson.insert(JSON_Z, std::any_cast<Vec3>(point->getDataValue()).z);
-                pointJson.insert(JSON_DATA, dataJson);
-
-				QJsonObject leftTagentJson;
-                leftTagentJson.insert(JSON_X, std::any_cast<Vec3>(point->getLeftTagent()).x);
-                leftTagentJson.insert(JSON_Y, std::any_cast<Vec3>(point->getLeftTagent()).y);
-                leftTagentJson.insert(JSON_Z, std::any_cast<Vec3>(point->getLeftTagent()).z);
-                pointJson.insert(JSON_LEFT_TANGENT, leftTagentJson);
-
-				QJsonObject rightTagentJson;
-                rightTagentJson.insert(JSON_X, std::any_cast<Vec3>(point->getRightTagent()).x);
-                rightTagentJson.insert(JSON_Y, std::any_cast<Vec3>(point->getRightTagent()).y);
-                rightTagentJson.insert(JSON_Z, std::any_cast<Vec3>(point->getRightTagent()).z);
-                pointJson.insert(JSON_RIGHT_TANGENT, rightTagentJson);
-			}
-			if (raco::guiData::Type_VEC4 == curve->getDataType()) {
-				QJsonObject dataJson;
-                dataJson.insert(JSON_X, std::any_cast<Vec4>(point->getDataValue()).x);
-                dataJson.insert(JSON_Y, std::any_cast<Vec4>(point->getDataValue()).y);
-                dataJson.insert(JSON_Z, std::any_cast<Vec4>(point->getDataValue()).z);
-                dataJson.insert(JSON_W, std::any_cast<Vec4>(point->getDataValue()).w);
-                pointJson.insert(JSON_DATA, dataJson);
-
-				QJsonObject leftTagentJson;
-                leftTagentJson.insert(JSON_X, std::any_cast<Vec4>(point->getLeftTagent()).x);
-                leftTagentJson.insert(JSON_Y, std::any_cast<Vec4>(point->getLeftTagent()).y);
-                leftTagentJson.insert(JSON_Z, std::any_cast<Vec4>(point->getLeftTagent()).z);
-                leftTagentJson.insert(JSON_W, std::any_cast<Vec4>(point->getDataValue()).w);
-                pointJson.insert(JSON_LEFT_TANGENT, leftTagentJson);
-
-				QJsonObject rightTagentJson;
-                rightTagentJson.insert(JSON_X, std::any_cast<Vec4>(point->getRightTagent()).x);
-                rightTagentJson.insert(JSON_Y, std::any_cast<Vec4>(point->getRightTagent()).y);
-                rightTagentJson.insert(JSON_Z, std::any_cast<Vec4>(point->getRightTagent()).z);
-                rightTagentJson.insert(JSON_W, std::any_cast<Vec4>(point->getRightTagent()).w);
-                pointJson.insert(JSON_RIGHT_TANGENT, rightTagentJson);
-			}
+            pointJson.insert(JSON_KEYFRAME, keyFrames[index]);
+            pointJson.insert(JSON_INTERPOLATION_TYPE, int(interPolationTypes[index]));
+            pointJson.insert(JSON_LEFT_KEYFRAME, leftKeyFrames[index]);
+            pointJson.insert(JSON_LEFT_DATA, leftDataValues[index]);
+            pointJson.insert(JSON_RIGHT_KEYFRAME, rightKeyFrames[index]);
+            pointJson.insert(JSON_RIGHT_DATA, rightDataValues[index]);
+            pointJson.insert(JSON_DATA, dataValues[index]);
+            pointJson.insert(JSON_LEFT_TANGENT, leftTagents[index]);
+            pointJson.insert(JSON_RIGHT_TANGENT, rightTagents[index]);
 			pointList.append(pointJson);
 		}
         curveJson.insert(JSON_POINT_LIST, pointList);
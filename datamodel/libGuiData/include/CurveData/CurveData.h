@@ -2,11 +2,16 @@
 #define CURVEDATA_H
 
 #include <list>
+#include <vector>
 #include <mutex>
 #include <string>
 #include <any>
 #include <map>
 #include <regex>
+#include <climits>
+#include <cstdint>
+#include "CurveData/CurveEvaluator.h"
+#include "CurveData/CurveFrameCache.h"
 
 namespace raco::guiData {
 
@@ -24,6 +29,77 @@ enum EInterPolationType{
     STEP
 };
 
+// read only view on one key column of a curve
+template <typename T>
+class KeySpan
+{
+public:
+    KeySpan(const T* data = nullptr, size_t size = 0) : data_{data}, size_{size} {}
+
+    const T* begin() const {
+        return data_;
+    }
+    const T* end() const {
+        return data_ + size_;
+    }
+    const T* data() const {
+        return data_;
+    }
+    size_t size() const {
+        return size_;
+    }
+    bool empty() const {
+        return size_ == 0;
+    }
+    const T& operator[](size_t index) const {
+        return data_[index];
+    }
+
+private:
+    const T* data_;
+    size_t size_;
+};
+
+// one key of a curve
+struct PointData {
+    int keyFrame_{0};
+    EInterPolationType interPolationType_{LINER};
+    double data_{0.0};
+    double leftTagent_{0.0};
+    double rightTagent_{0.0};
+    double leftData_{(double)INT_MIN};
+    double leftKeyFrame_{(double)INT_MIN};
+    double rightData_{(double)INT_MIN};
+    double rightKeyFrame_{(double)INT_MIN};
+};
+
+// keys of a curve stored column wise, one entry per key in every column
+struct PointColumns {
+    std::vector<int> keyFrames_;
+    std::vector<EInterPolationType> interPolationTypes_;
+    std::vector<double> data_;
+    std::vector<double> leftTagents_;
+    std::vector<double> rightTagents_;
+    std::vector<double> leftData_;
+    std::vector<double> leftKeyFrames_;
+    std::vector<double> rightData_;
+    std::vector<double> rightKeyFrames_;
+
+    size_t size() const;
+    void reserve(size_t size);
+    void clear();
+    void insert(size_t index, const PointData& point);
+    void append(const PointData& point);
+    void erase(size_t index);
+    PointData row(size_t index) const;
+    void setRow(size_t index, const PointData& point);
+    void permute(const std::vector<size_t>& order);
+};
+
+class Curve;
+
+// Editing handle on a curve key. A point created with new keeps its own values
+// until it is inserted into a curve, from then on it reads and writes the curve columns.
 class Point
 {
 public:
@@ -65,17 +141,15 @@ public:
     void setRightKeyFrame(const double keyFrame);
     //
     double getRightKeyFrame();
+    //
+    PointData getPointData();
 
 private:
-    int keyFrame_;
-    EInterPolationType interPolationType_{LINER};
-    std::any data_{0.0}; //
-    std::any leftTagent_{0.0};
-    std::any rightTagent_{0.0};
-    std::any leftData_{(double)INT_MIN};
-    double leftKeyFrame_{INT_MIN};
-    std::any rightData_{(double)INT_MIN};
-    double rightKeyFrame_{INT_MIN};
+    friend class Curve;
+
+    Curve* curve_{nullptr};
+    size_t index_{0};
+    PointData pointData_;
 };
 
 class Curve
@@ -94,33 +168,103 @@ public:
     EDataType getDataType();
     //
     bool insertPoint(Point* point);
+    // insert a key without creating a Point handle
+    bool insertPoint(const PointData& pointData);
+    // bulk insert in one pass, keys already in the curve and repeated frames are skipped like with insertPoint.
+    // Sorted input is taken over without copying when the curve is empty.
+    size_t insertPoints(PointColumns&& columns);
+    // replace all keys, existing Point handles are deleted
+    void assignPoints(PointColumns&& columns);
+    //
+    const PointColumns& getPointColumns() const;
     //
     bool insertSamePoint(Point* point);
     //
     bool delPoint(int keyFrame);
     bool takePoint(int keyFrame);
     bool delSamePoint(int keyFrame);
-    //
-    std::list<Point*> getPointList();
+    // Point handles of all keys, in key order
+    const std::vector<Point*>& getPointList();
     //
     Point* getPoint(int keyFrame);
     //
     bool sortPoint();
     //
+    size_t getPointSize() const;
+    //
+    void reservePoint(size_t size);
+    //
+    KeySpan<int> getKeyFrames() const;
+    //
+    KeySpan<EInterPolationType> getInterPolationTypes() const;
+    //
+    KeySpan<double> getDataValues() const;
+    //
+    KeySpan<double> getLeftTagents() const;
+    //
+    KeySpan<double> getRightTagents() const;
+    //
+    KeySpan<double> getLeftKeyFrames() const;
+    //
+    KeySpan<double> getLeftDataValues() const;
+    //
+    KeySpan<double> getRightKeyFrames() const;
+    //
+    KeySpan<double> getRightDataValues() const;
+    //
+    PointData getPointData(size_t index) const;
+    //
+    bool isSorted() const;
+    //
     bool getDataValue(int curFrame, double &value);
     //
     bool getStepValue(int curFrame, double &value);
     //
     bool getPointType(int curFrame, EInterPolationType &type);
     //
-    double calculateLinerValue(Point* firstPoint, Point* secondPoint, double curFrame);
+    double calculateLinerValue(size_t firstIndex, size_t secondIndex, double curFrame);
     //
     bool modifyPointKeyFrame(const int& keyFrame, const int& modifyKeyFrame);
+    // curve value at curFrame, compiled segment table is rebuilt after edits
+    bool evaluate(double curFrame, double &value);
+    // drop the compiled segment table and all cached frames
+    void invalidate();
+    // compiled segment table, rebuilt here if the keys changed; safe to read from several threads until the next edit
+    const CurveEvaluator& getEvaluator();
+    // curve value at an integer frame, served from the frame cache when possible
+    bool getFrameValue(int curFrame, double &value);
+    // cached frames, point edits only drop the frames they can change
+    CurveFrameCache& getFrameCache();
+    // changes with every edit of the keys and is never reused, curves with the same revision have the same keys
+    uint64_t getRevision() const;
+    // the keys were restored from a copy taken at revision
+    void restoreRevision(uint64_t revision);
 
 private:
+    friend class Point;
+
+    size_t findPoint(int keyFrame) const;
+    size_t lowerBound(int keyFrame) const;
+    void insertRow(size_t index, const PointData& pointData, Point* point);
+    void eraseRow(size_t index);
+    void updatePointIndex(size_t begin);
+    void setPointKeyFrame(size_t index, int keyFrame);
+    // frames influenced by the key at index: from the previous key to the next one
+    void keyFrameRange(size_t index, int &firstFrame, int &lastFrame) const;
+    void invalidateKey(size_t index);
+    void invalidateRange(int firstFrame, int lastFrame);
+
     std::string curveName_;
     EDataType dataType_{Type_FLOAT};
-    std::list<Point*> pointList_;
+    PointColumns columns_;
+    // handles are created on demand, entries stay nullptr until a caller asks for the Point
+    std::vector<Point*> points_;
+    bool sorted_{true};
+    bool pointListComplete_{true};
+    CurveEvaluator evaluator_;
+    bool evaluatorDirty_{true};
+    CurveFrameCache frameCache_;
+    uint64_t revision_;
 };
 }
 
@@ -0,0 +1,41 @@
+#ifndef CURVEEVALUATOR_H
+#define CURVEEVALUATOR_H
+
+#include <vector>
+
+namespace raco::guiData {
+
+class Curve;
+
+// Compiled form of a curve: one polynomial per segment between two keys,
+// evaluated analytically in frame space (independent of the curve view zoom).
+class CurveEvaluator
+{
+public:
+    struct Segment {
+        int type{0};
+        // value polynomial in normalized segment time t: ((c[0] * t + c[1]) * t + c[2]) * t + c[3]
+        double valueCoeff[4]{0.0, 0.0, 0.0, 0.0};
+        // bezier only: frame polynomial in t, solved for t before evaluating the value
+        double frameCoeff[4]{0.0, 0.0, 0.0, 0.0};
+    };
+
+    // rebuild the segment table from the curve key columns
+    void compile(const Curve& curve);
+    //
+    void clear();
+    //
+    bool empty() const;
+    //
+    bool evaluate(double frame, double &value) const;
+
+private:
+    double solveBezierTime(const Segment& segment, double x, double t) const;
+
+    std::vector<double> keyFrames_;
+    std::vector<double> keyValues_;
+    std::vector<Segment> segments_;
+};
+}
+
+#endif // CURVEEVALUATOR_H
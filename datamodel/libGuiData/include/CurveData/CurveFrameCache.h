@@ -0,0 +1,62 @@
+#ifndef CURVEFRAMECACHE_H
+#define CURVEFRAMECACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace raco::guiData {
+
+// Curve values sampled at integer frames. The cached window grows on demand up to a maximum span,
+// a frame far away from it starts a new window. When all caches together would exceed the memory budget
+// the least recently used caches are freed.
+// Not thread safe, the cache is filled and read on the thread which edits the curve.
+class CurveFrameCache
+{
+public:
+    struct Statistics {
+        uint64_t hits_{0};
+        uint64_t misses_{0};
+        uint64_t evictions_{0};
+        size_t memoryUsage_{0};
+        size_t memoryBudget_{0};
+    };
+
+    CurveFrameCache() = default;
+    // the cache is derived data, copies start empty
+    CurveFrameCache(const CurveFrameCache& other);
+    CurveFrameCache& operator=(const CurveFrameCache& other);
+    ~CurveFrameCache();
+
+    // cached value of frame, counts a hit or a miss
+    bool lookup(int frame, double &value);
+    //
+    void store(int frame, double value);
+    // forget the frames in [firstFrame, lastFrame]
+    void invalidate(int firstFrame, int lastFrame);
+    //
+    void clear();
+    //
+    size_t memoryUsage() const;
+
+    // budget for all curve caches together, in bytes
+    static void setMemoryBudget(size_t bytes);
+    //
+    static Statistics statistics();
+    //
+    static void resetStatistics();
+
+private:
+    bool reserveWindow(int firstFrame, int lastFrame);
+    void release();
+    // free least recently used caches other than this one until bytes more fit into the budget
+    bool evict(size_t bytes);
+
+    uint64_t lastUse_{0};
+    int firstFrame_{0};
+    std::vector<double> values_;
+    std::vector<uint8_t> valid_;
+};
+}
+
+#endif // CURVEFRAMECACHE_H
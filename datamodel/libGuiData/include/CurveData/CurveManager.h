@@ -4,9 +4,35 @@
 #include "CurveData/CurveData.h"
 #include "core/ChangeBase.h"
 #include "core/StructCommon.h"
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <vector>
 
 namespace raco::guiData {
 
+// Stays valid while the curve keeps its name, renaming or removing a curve invalidates it.
+struct CurveHandle {
+    size_t index_{SIZE_MAX};
+    uint32_t generation_{0};
+
+    bool isValid() const {
+        return index_ != SIZE_MAX;
+    }
+};
+
+// Read only copy of a curve for the undo stack. Undo states share the copy as long as the curve doesn't change.
+struct CurveSnapshot {
+    std::string curveName_;
+    EDataType dataType_{Type_FLOAT};
+    uint64_t revision_{0};
+    PointColumns columns_;
+
+    size_t memoryUsage() const;
+};
+using SharedCurveSnapshot = std::shared_ptr<const CurveSnapshot>;
+
 class CurveManager {
 public:
     static CurveManager& GetInstance();
@@ -16,6 +42,10 @@ public:
 
     std::list<STRUCT_CURVE> convertCurveData();
     void merge(QVariant data);
+    // copies of all curves in list order, copies in previous are reused for curves which didn't change since
+    std::vector<SharedCurveSnapshot> snapshotCurves(const std::vector<SharedCurveSnapshot>& previous = {});
+    // like merge: an empty list keeps the curves, otherwise only curves which differ from their copy are rebuilt
+    void restoreCurves(const std::vector<SharedCurveSnapshot>& snapshots);
 
     // add Curve
     bool addCurve(Curve* curve);
@@ -25,6 +55,10 @@ public:
     bool delCurve(const std::string& curveNmae);
     // get Curve
     Curve *getCurve(const std::string& curveName);
+    // get Curve from a cached handle, nullptr if the handle is stale
+    Curve *getCurve(const CurveHandle& handle);
+    // get handle of Curve
+    CurveHandle getCurveHandle(const std::string& curveName);
     // modify Curve Name
     bool modifyCurveName(const std::string& curveName, const std::string& modifyName);
     // copy Curve
@@ -44,10 +78,25 @@ public:
 private:
     CurveManager();
 
+private:
+    struct CurveSlot {
+        Curve* curve_{nullptr};
+        uint32_t generation_{0};
+        std::list<Curve*>::iterator listIt_;
+    };
+
+    void insertIndex(Curve* curve, std::list<Curve*>::iterator listIt);
+    Curve* eraseIndex(const std::string& curveName);
+
 private:
     static CurveManager* curveManager_;
     static std::mutex mutex_;
     std::list<Curve*> curveList_;
+    std::vector<CurveSlot> curveSlots_;
+    std::vector<size_t> freeSlots_;
+    std::unordered_map<std::string, size_t> curveIndex_;
+    std::string searchPattern_;
+    std::regex searchRegex_;
 };
 }
 
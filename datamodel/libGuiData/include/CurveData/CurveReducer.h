@@ -0,0 +1,41 @@
+#ifndef CURVEREDUCER_H
+#define CURVEREDUCER_H
+
+#include "CurveData/CurveData.h"
+
+namespace raco::guiData {
+
+// Keyframe reduction for densely baked curves.
+// Runs of linear keys are replaced by the fewest linear or bezier segments which stay within
+// the tolerance (in value units) at every removed key; repeated step keys are dropped.
+// Keys with other interpolation types and the first and last key are kept as they are.
+// A tolerance of 0 turns the reduction off.
+class CurveReducer
+{
+public:
+    explicit CurveReducer(double tolerance = 0.001);
+
+    //
+    void setTolerance(double tolerance);
+    //
+    double getTolerance() const;
+    // reduce keys sorted by frame, returns the number of removed keys
+    size_t reduce(PointColumns& columns) const;
+    // reduce the keys of a curve, returns the number of removed keys
+    size_t reduce(Curve& curve) const;
+
+private:
+    enum class FitType {
+        NONE,
+        LINER,
+        BESIER
+    };
+
+    void reduceLinerRun(PointColumns& columns, size_t first, size_t last, std::vector<bool>& keep) const;
+    FitType fit(const PointColumns& columns, const std::vector<double>& tangents, size_t runFirst, size_t first, size_t last) const;
+
+    double tolerance_;
+};
+}
+
+#endif // CURVEREDUCER_H
@@ -0,0 +1,58 @@
+#ifndef CURVESAMPLER_H
+#define CURVESAMPLER_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace raco::guiData {
+
+class CurveEvaluator;
+
+// Samples compiled curves on a small worker pool.
+// The evaluators are only read while sampling, callers compile them on their own thread
+// (Curve::getEvaluator) and must not edit the curves until the call returns.
+// Curves without keys are sampled as NaN.
+class CurveSampler
+{
+public:
+    // threadCount 0 uses one worker per hardware thread, the calling thread always helps
+    explicit CurveSampler(size_t threadCount = 0);
+    ~CurveSampler();
+    CurveSampler(const CurveSampler&) = delete;
+    CurveSampler& operator=(const CurveSampler&) = delete;
+
+    //
+    size_t threadCount() const;
+    // frames with fewer curves than this are sampled on the calling thread only
+    void setParallelThreshold(size_t threshold);
+    // values[i] = curves[i] at frame
+    void sampleFrame(const std::vector<const CurveEvaluator*>& curves, double frame, std::vector<double>& values);
+    // values[(frame - firstFrame) * curves.size() + i] = curves[i] at frame, for frame in [firstFrame, lastFrame].
+    // values is owned by the caller and can be reused between calls, nothing is written to the curve frame caches.
+    void sampleRange(const std::vector<const CurveEvaluator*>& curves, int firstFrame, int lastFrame, std::vector<double>& values);
+
+private:
+    void run(size_t taskCount, const std::function<void(size_t)>& task);
+    void runTasks(std::unique_lock<std::mutex>& lock);
+    void workerLoop();
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wakeCondition_;
+    std::condition_variable doneCondition_;
+    const std::function<void(size_t)>* task_{nullptr};
+    size_t taskCount_{0};
+    size_t nextTask_{0};
+    size_t finishedTasks_{0};
+    unsigned long long generation_{0};
+    bool stop_{false};
+    size_t parallelThreshold_{64};
+    // one output buffer per chunk, merged in curve order after the frame is sampled
+    std::vector<std::vector<double>> chunkValues_;
+};
+}
+
+#endif // CURVESAMPLER_H
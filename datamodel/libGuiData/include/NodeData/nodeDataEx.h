@@ -7,6 +7,7 @@
 #include <any>
 #include <list>
 #include <iostream>
+#include <cstdint>
 #include "PropertyData/PropertyData.h"
 
 namespace raco::guiData {
@@ -15,8 +16,13 @@ class CurveBinding
 {
 public:
     CurveBinding();
+    CurveBinding(const CurveBinding& other);
+    CurveBinding(CurveBinding&& other);
+    CurveBinding& operator=(const CurveBinding& other);
+    CurveBinding& operator=(CurveBinding&& other);
     ~CurveBinding();
-	std::map<std::string, std::map<std::string, std::string>>& bindingMap();
+    // changes go through the members below, they keep the curve binding index of NodeDataManager up to date
+	const std::map<std::string, std::map<std::string, std::string>>& bindingMap() const;
 	bool insertAnimation(std::string& sampleProp, std::map<std::string, std::string>& bindingData);
 	bool deleteAnimation(std::string& sampleProp);
     bool insertBindingDataItem(const std::string& sampleProp, const std::string& property, const std::string& curve);
@@ -25,7 +31,14 @@ public:
 	bool getPropCurve(std::string sampleProp, std::map<std::string, std::string>& bindingData);
     void traverseCurveBinding();
 	size_t getBindingMapSize() { return bindingMap_.size(); }
+    // counts bindings created, copied, assigned or destroyed, e.g. when nodes are copied into or removed from the node tree.
+    // Edits through the members above don't count, they update the curve binding index in place.
+    static uint64_t generation();
 private:
+    void touch();
+    void bindingInserted(const std::string& sampleProp, const std::string& property, const std::string& curve);
+    void bindingDeleted(const std::string& sampleProp, const std::string& property, const std::string& curve);
+
     std::map<std::string, std::map<std::string, std::string>>bindingMap_;
     //     < sampleProp_ ,  <property_, curve_> >
     //       animationName
@@ -11,6 +11,7 @@
 #include <list>
 #include <map>
 #include <functional>
+#include <unordered_map>
 
 namespace raco::guiData {
 
@@ -264,6 +265,13 @@ private:
     std::map<std::string, NodeData> childNodeMap_;
 };
 
+// one binding of a curve: property of node animated by the curve in animation sampleProperty_
+struct CurveBindingItem {
+    NodeData* node_{nullptr};
+    std::string sampleProperty_;
+    std::string property_;
+};
+
 class NodeDataManager
 {
 private:
@@ -326,7 +334,23 @@ public:
     void delCurveBindingByName(std::string curveName);
     void delOneCurveBindingByName(NodeData* pNode, std::string curveName);
 
+    // all bindings of curve. Binding edits update the index in place, it is rebuilt with one tree walk
+    // only after bindings were created, copied or destroyed (see CurveBinding::generation)
+    const std::vector<CurveBindingItem>& getCurveBindings(const std::string& curveName);
+
 private:
+    friend class CurveBinding;
+
+    bool isCurveBindingIndexValid() const;
+    void indexCurveBindings(NodeData* pNode);
+    // called by CurveBinding, bindings outside of the node tree are ignored
+    void curveBindingInserted(const CurveBinding* binding, const std::string& sampleProp, const std::string& property, const std::string& curve);
+    void curveBindingDeleted(const CurveBinding* binding, const std::string& sampleProp, const std::string& property, const std::string& curve);
+
+    std::map<std::string, std::vector<CurveBindingItem>> curveBindingIndex_;
+    // node owning each binding of the tree when the index was built
+    std::unordered_map<const CurveBinding*, NodeData*> curveBindingOwners_;
+    uint64_t curveBindingIndexGeneration_{UINT64_MAX};
     NodeData* activeNode_;
     NodeData root_;
     NodeData* searchedNode_;
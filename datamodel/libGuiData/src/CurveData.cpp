@@ -1,93 +1,283 @@
 #include "CurveData/CurveData.h"
 
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+
 namespace raco::guiData {
 
+namespace {
+const size_t npos = static_cast<size_t>(-1);
+
+double anyToDouble(const std::any &value) {
+    if (value.type() == typeid(double)) {
+        return std::any_cast<double>(value);
+    }
+    if (value.type() == typeid(float)) {
+        return std::any_cast<float>(value);
+    }
+    if (value.type() == typeid(int)) {
+        return std::any_cast<int>(value);
+    }
+    // keys are stored as double, silently writing 0.0 would corrupt the curve
+    throw std::invalid_argument(std::string("unsupported curve value type ") + value.type().name());
+}
+
+// unique over all curves, a new curve never repeats the revision of a deleted one
+uint64_t nextRevision() {
+    static std::atomic<uint64_t> revision{0};
+    return ++revision;
+}
+
+template <typename T>
+void permuteColumn(std::vector<T> &column, const std::vector<size_t> &order) {
+    std::vector<T> permuted;
+    permuted.reserve(column.size());
+    for (auto index : order) {
+        permuted.push_back(column[index]);
+    }
+    column.swap(permuted);
+}
+}
+
+size_t PointColumns::size() const {
+    return keyFrames_.size();
+}
+
+void PointColumns::reserve(size_t size) {
+    keyFrames_.reserve(size);
+    interPolationTypes_.reserve(size);
+    data_.reserve(size);
+    leftTagents_.reserve(size);
+    rightTagents_.reserve(size);
+    leftData_.reserve(size);
+    leftKeyFrames_.reserve(size);
+    rightData_.reserve(size);
+    rightKeyFrames_.reserve(size);
+}
+
+void PointColumns::clear() {
+    keyFrames_.clear();
+    interPolationTypes_.clear();
+    data_.clear();
+    leftTagents_.clear();
+    rightTagents_.clear();
+    leftData_.clear();
+    leftKeyFrames_.clear();
+    rightData_.clear();
+    rightKeyFrames_.clear();
+}
+
+void PointColumns::insert(size_t index, const PointData &point) {
+    keyFrames_.insert(keyFrames_.begin() + index, point.keyFrame_);
+    interPolationTypes_.insert(interPolationTypes_.begin() + index, point.interPolationType_);
+    data_.insert(data_.begin() + index, point.data_);
+    leftTagents_.insert(leftTagents_.begin() + index, point.leftTagent_);
+    rightTagents_.insert(rightTagents_.begin() + index, point.rightTagent_);
+    leftData_.insert(leftData_.begin() + index, point.leftData_);
+    leftKeyFrames_.insert(leftKeyFrames_.begin() + index, point.leftKeyFrame_);
+    rightData_.insert(rightData_.begin() + index, point.rightData_);
+    rightKeyFrames_.insert(rightKeyFrames_.begin() + index, point.rightKeyFrame_);
+}
+
+void PointColumns::append(const PointData &point) {
+    keyFrames_.push_back(point.keyFrame_);
+    interPolationTypes_.push_back(point.interPolationType_);
+    data_.push_back(point.data_);
+    leftTagents_.push_back(point.leftTagent_);
+    rightTagents_.push_back(point.rightTagent_);
+    leftData_.push_back(point.leftData_);
+    leftKeyFrames_.push_back(point.leftKeyFrame_);
+    rightData_.push_back(point.rightData_);
+    rightKeyFrames_.push_back(point.rightKeyFrame_);
+}
+
+void PointColumns::erase(size_t index) {
+    keyFrames_.erase(keyFrames_.begin() + index);
+    interPolationTypes_.erase(interPolationTypes_.begin() + index);
+    data_.erase(data_.begin() + index);
+    leftTagents_.erase(leftTagents_.begin() + index);
+    rightTagents_.erase(rightTagents_.begin() + index);
+    leftData_.erase(leftData_.begin() + index);
+    leftKeyFrames_.erase(leftKeyFrames_.begin() + index);
+    rightData_.erase(rightData_.begin() + index);
+    rightKeyFrames_.erase(rightKeyFrames_.begin() + index);
+}
+
+PointData PointColumns::row(size_t index) const {
+    PointData point;
+    point.keyFrame_ = keyFrames_[index];
+    point.interPolationType_ = interPolationTypes_[index];
+    point.data_ = data_[index];
+    point.leftTagent_ = leftTagents_[index];
+    point.rightTagent_ = rightTagents_[index];
+    point.leftData_ = leftData_[index];
+    point.leftKeyFrame_ = leftKeyFrames_[index];
+    point.rightData_ = rightData_[index];
+    point.rightKeyFrame_ = rightKeyFrames_[index];
+    return point;
+}
+
+void PointColumns::setRow(size_t index, const PointData &point) {
+    keyFrames_[index] = point.keyFrame_;
+    interPolationTypes_[index] = point.interPolationType_;
+    data_[index] = point.data_;
+    leftTagents_[index] = point.leftTagent_;
+    rightTagents_[index] = point.rightTagent_;
+    leftData_[index] = point.leftData_;
+    leftKeyFrames_[index] = point.leftKeyFrame_;
+    rightData_[index] = point.rightData_;
+    rightKeyFrames_[index] = point.rightKeyFrame_;
+}
+
+void PointColumns::permute(const std::vector<size_t> &order) {
+    permuteColumn(keyFrames_, order);
+    permuteColumn(interPolationTypes_, order);
+    permuteColumn(data_, order);
+    permuteColumn(leftTagents_, order);
+    permuteColumn(rightTagents_, order);
+    permuteColumn(leftData_, order);
+    permuteColumn(leftKeyFrames_, order);
+    permuteColumn(rightData_, order);
+    permuteColumn(rightKeyFrames_, order);
+}
+
 Point::Point(int keyFrame) {
-    keyFrame_ = keyFrame;
+    pointData_.keyFrame_ = keyFrame;
 }
 
 void Point::setKeyFrame(const int &keyFrame) {
-    keyFrame_ = keyFrame;
+    if (curve_) {
+        curve_->setPointKeyFrame(index_, keyFrame);
+    } else {
+        pointData_.keyFrame_ = keyFrame;
+    }
 }
 
 int Point::getKeyFrame() {
-    return keyFrame_;
+    return curve_ ? curve_->columns_.keyFrames_[index_] : pointData_.keyFrame_;
 }
 
 void Point::setInterPolationType(const EInterPolationType& interPolationType) {
-    interPolationType_ = interPolationType;
+    if (curve_) {
+        curve_->columns_.interPolationTypes_[index_] = interPolationType;
+        curve_->invalidateKey(index_);
+    } else {
+        pointData_.interPolationType_ = interPolationType;
+    }
 }
 
 EInterPolationType Point::getInterPolationType() {
-    return interPolationType_;
+    return curve_ ? curve_->columns_.interPolationTypes_[index_] : pointData_.interPolationType_;
 }
 
 void Point::setDataValue(const std::any &value) {
-    data_ = value;
+    if (curve_) {
+        curve_->columns_.data_[index_] = anyToDouble(value);
+        curve_->invalidateKey(index_);
+    } else {
+        pointData_.data_ = anyToDouble(value);
+    }
 }
 
 std::any Point::getDataValue() {
-    return data_;
+    return curve_ ? curve_->columns_.data_[index_] : pointData_.data_;
 }
 
 void Point::setLeftTagent(const std::any &value) {
-    leftTagent_ = value;
+    if (curve_) {
+        curve_->columns_.leftTagents_[index_] = anyToDouble(value);
+        curve_->invalidateKey(index_);
+    } else {
+        pointData_.leftTagent_ = anyToDouble(value);
+    }
 }
 
 std::any Point::getLeftTagent() {
-    return leftTagent_;
+    return curve_ ? curve_->columns_.leftTagents_[index_] : pointData_.leftTagent_;
 }
 
 void Point::setRightTagent(const std::any &value) {
-    rightTagent_ = value;
+    if (curve_) {
+        curve_->columns_.rightTagents_[index_] = anyToDouble(value);
+        curve_->invalidateKey(index_);
+    } else {
+        pointData_.rightTagent_ = anyToDouble(value);
+    }
 }
 
 std::any Point::getRightTagent() {
-    return rightTagent_;
+    return curve_ ? curve_->columns_.rightTagents_[index_] : pointData_.rightTagent_;
 }
 
 void Point::setLeftData(const std::any &value) {
-    leftData_ = value;
+    if (curve_) {
+        curve_->columns_.leftData_[index_] = anyToDouble(value);
+        curve_->invalidateKey(index_);
+    } else {
+        pointData_.leftData_ = anyToDouble(value);
+    }
 }
 
 std::any Point::getLeftData() {
-    return leftData_;
+    return curve_ ? curve_->columns_.leftData_[index_] : pointData_.leftData_;
 }
 
 void Point::setLeftKeyFrame(const double keyFrame) {
-    leftKeyFrame_ = keyFrame;
+    if (curve_) {
+        curve_->columns_.leftKeyFrames_[index_] = keyFrame;
+        curve_->invalidateKey(index_);
+    } else {
+        pointData_.leftKeyFrame_ = keyFrame;
+    }
 }
 
 double Point::getLeftKeyFrame() {
-    return leftKeyFrame_;
+    return curve_ ? curve_->columns_.leftKeyFrames_[index_] : pointData_.leftKeyFrame_;
 }
 
 void Point::setRightData(const std::any &value) {
-    rightData_ = value;
+    if (curve_) {
+        curve_->columns_.rightData_[index_] = anyToDouble(value);
+        curve_->invalidateKey(index_);
+    } else {
+        pointData_.rightData_ = anyToDouble(value);
+    }
 }
 
 std::any Point::getRightData() {
-    return rightData_;
+    return curve_ ? curve_->columns_.rightData_[index_] : pointData_.rightData_;
 }
 
 void Point::setRightKeyFrame(const double keyFrame) {
-    rightKeyFrame_ = keyFrame;
+    if (curve_) {
+        curve_->columns_.rightKeyFrames_[index_] = keyFrame;
+        curve_->invalidateKey(index_);
+    } else {
+        pointData_.rightKeyFrame_ = keyFrame;
+    }
 }
 
 double Point::getRightKeyFrame() {
-    return rightKeyFrame_;
+    return curve_ ? curve_->columns_.rightKeyFrames_[index_] : pointData_.rightKeyFrame_;
+}
+
+PointData Point::getPointData() {
+    return curve_ ? curve_->columns_.row(index_) : pointData_;
 }
 
-Curve::Curve() {
+Curve::Curve() : revision_{nextRevision()} {
 
 }
 
 Curve::~Curve() {
-    for (auto it = pointList_.begin(); it != pointList_.end(); it++) {
+    for (auto it = points_.begin(); it != points_.end(); it++) {
         delete (*it);
         (*it) = nullptr;
     }
-    pointList_.clear();
+    points_.clear();
+    columns_.clear();
 }
 
 void Curve::setCurveName(const std::string &curveName) {
@@ -107,289 +297,492 @@ EDataType Curve::getDataType() {
 }
 
 bool Curve::insertPoint(Point *point) {
-    if (point == nullptr) {
+    if (point == nullptr || point->curve_ != nullptr) {
         return false;
     }
 
-    int pointKeyFrame = point->getKeyFrame();
-    if (!pointList_.empty()) {
-        auto it = pointList_.begin();
-        while (it != pointList_.end()) {
-            if ((*it)->getKeyFrame() == pointKeyFrame) {
-                return false;
-            }
-            if ((*it)->getKeyFrame() > pointKeyFrame) {
-                pointList_.insert(it, point);
-                return true;
-            }
-            it++;
-        }
+    int pointKeyFrame = point->pointData_.keyFrame_;
+    size_t index = lowerBound(pointKeyFrame);
+    if (index < columns_.size() && columns_.keyFrames_[index] == pointKeyFrame) {
+        return false;
     }
+    insertRow(index, point->pointData_, point);
+    return true;
+}
 
-    pointList_.push_back(point);
+bool Curve::insertPoint(const PointData &pointData) {
+    size_t index = lowerBound(pointData.keyFrame_);
+    if (index < columns_.size() && columns_.keyFrames_[index] == pointData.keyFrame_) {
+        return false;
+    }
+    insertRow(index, pointData, nullptr);
     return true;
 }
 
+size_t Curve::insertPoints(PointColumns &&columns) {
+    auto &keyFrames = columns.keyFrames_;
+    // sort and drop repeated frames, the first key of a frame wins
+    std::vector<size_t> order;
+    bool sorted = std::is_sorted(keyFrames.begin(), keyFrames.end());
+    if (!sorted) {
+        order.resize(keyFrames.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&keyFrames](size_t a, size_t b) {
+            return keyFrames[a] < keyFrames[b];
+        });
+    }
+    if (std::adjacent_find(keyFrames.begin(), keyFrames.end()) != keyFrames.end() || !sorted) {
+        if (sorted) {
+            order.resize(keyFrames.size());
+            std::iota(order.begin(), order.end(), 0);
+        }
+        auto last = std::unique(order.begin(), order.end(), [&keyFrames](size_t a, size_t b) {
+            return keyFrames[a] == keyFrames[b];
+        });
+        order.erase(last, order.end());
+        columns.permute(order);
+    }
+
+    size_t size = columns.size();
+    if (size == 0) {
+        return 0;
+    }
+    if (columns_.size() == 0) {
+        columns_ = std::move(columns);
+        points_.assign(size, nullptr);
+        sorted_ = true;
+        pointListComplete_ = false;
+        invalidate();
+        return size;
+    }
+
+    // merge both sorted key lists
+    sortPoint();
+    PointColumns merged;
+    merged.reserve(columns_.size() + size);
+    std::vector<Point *> points;
+    points.reserve(columns_.size() + size);
+    size_t inserted{0};
+    size_t index{0};
+    for (size_t newIndex{0}; newIndex < size; newIndex++) {
+        int keyFrame = columns.keyFrames_[newIndex];
+        for (; index < columns_.size() && columns_.keyFrames_[index] <= keyFrame; index++) {
+            merged.append(columns_.row(index));
+            points.push_back(points_[index]);
+        }
+        if (!points.empty() && merged.keyFrames_.back() == keyFrame) {
+            continue;
+        }
+        merged.append(columns.row(newIndex));
+        points.push_back(nullptr);
+        inserted++;
+    }
+    for (; index < columns_.size(); index++) {
+        merged.append(columns_.row(index));
+        points.push_back(points_[index]);
+    }
+    columns_ = std::move(merged);
+    points_ = std::move(points);
+    updatePointIndex(0);
+    if (inserted > 0) {
+        pointListComplete_ = false;
+    }
+    invalidate();
+    return inserted;
+}
+
+void Curve::assignPoints(PointColumns &&columns) {
+    for (auto point : points_) {
+        delete point;
+    }
+    columns_ = std::move(columns);
+    points_.assign(columns_.size(), nullptr);
+    sorted_ = std::is_sorted(columns_.keyFrames_.begin(), columns_.keyFrames_.end());
+    pointListComplete_ = points_.empty();
+    invalidate();
+}
+
+const PointColumns &Curve::getPointColumns() const {
+    return columns_;
+}
+
 bool Curve::insertSamePoint(Point *point) {
-    if (point == nullptr) {
+    if (point == nullptr || point->curve_ != nullptr) {
         return false;
     }
 
-    int pointKeyFrame = point->getKeyFrame();
-    if (!pointList_.empty()) {
-        auto it = pointList_.begin();
-        while (it != pointList_.end()) {
-            if ((*it)->getKeyFrame() == pointKeyFrame) {
-                pointList_.insert(it, point);
-                return true;
-            }
-            it++;
-        }
+    size_t index = findPoint(point->pointData_.keyFrame_);
+    if (index == npos) {
+        return false;
     }
-    return false;
+    insertRow(index, point->pointData_, point);
+    return true;
 }
 
 bool Curve::delPoint(int keyFrame) {
-    if (!pointList_.empty()) {
-        auto it = pointList_.begin();
-        while (it != pointList_.end()) {
-            if ((*it)->getKeyFrame() == keyFrame) {
-                Point *point = (*it);
-                pointList_.erase(it);
-                delete point;
-                point = nullptr;
-                return true;
-            }
-            it++;
-        }
+    size_t index = findPoint(keyFrame);
+    if (index == npos) {
+        return false;
     }
-    return false;
+    delete points_[index];
+    eraseRow(index);
+    return true;
 }
 
 bool Curve::takePoint(int keyFrame) {
-    if (!pointList_.empty()) {
-        auto it = pointList_.begin();
-        while (it != pointList_.end()) {
-            if ((*it)->getKeyFrame() == keyFrame) {
-                pointList_.erase(it);
-                return true;
-            }
-            it++;
-        }
+    size_t index = findPoint(keyFrame);
+    if (index == npos) {
+        return false;
     }
-    return false;
+    Point *point = points_[index];
+    if (point) {
+        point->pointData_ = columns_.row(index);
+        point->curve_ = nullptr;
+        point->index_ = 0;
+    }
+    eraseRow(index);
+    return true;
 }
 
 bool Curve::delSamePoint(int keyFrame) {
-    if (!pointList_.empty()) {
-        auto it = pointList_.begin();
-        while (it != pointList_.end()) {
-            if ((*it)->getKeyFrame() == keyFrame) {
-                it++;
-                if (it != pointList_.end()) {
-                    Point *point = (*it);
-                    pointList_.erase(it);
-                    delete point;
-                    point = nullptr;
-                }
-                return true;
+    size_t index = findPoint(keyFrame);
+    if (index == npos) {
+        return false;
+    }
+    index++;
+    if (index < columns_.size()) {
+        delete points_[index];
+        eraseRow(index);
+    }
+    return true;
+}
+
+const std::vector<Point *> &Curve::getPointList() {
+    if (!pointListComplete_) {
+        for (size_t index{0}; index < points_.size(); index++) {
+            if (!points_[index]) {
+                Point *point = new Point;
+                point->curve_ = this;
+                point->index_ = index;
+                points_[index] = point;
             }
-            it++;
         }
+        pointListComplete_ = true;
     }
-    return false;
+    return points_;
 }
 
-std::list<Point *> Curve::getPointList() {
-    return pointList_;
-}
 Point *Curve::getPoint(int keyFrame) {
-    Point* point{nullptr};
-    auto it = pointList_.begin();
-    while (it != pointList_.end()) {
-        if ((*it)->getKeyFrame() == keyFrame) {
-            point = (*it);
-            break;
-        }
-        it++;
+    size_t index = findPoint(keyFrame);
+    if (index == npos) {
+        return nullptr;
     }
-    return point;
+    if (!points_[index]) {
+        Point *point = new Point;
+        point->curve_ = this;
+        point->index_ = index;
+        points_[index] = point;
+    }
+    return points_[index];
 }
 
 bool Curve::sortPoint() {
-    pointList_.sort([](Point* a, Point* b)->bool {
-                return a->getKeyFrame() < b->getKeyFrame();
-            });
+    if (!std::is_sorted(columns_.keyFrames_.begin(), columns_.keyFrames_.end())) {
+        std::vector<size_t> order(columns_.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b)->bool {
+                    return columns_.keyFrames_[a] < columns_.keyFrames_[b];
+                });
+        columns_.permute(order);
+        permuteColumn(points_, order);
+        updatePointIndex(0);
+        revision_ = nextRevision();
+    }
+    sorted_ = true;
+    // reordering doesn't change the curve, cached frames stay valid
+    evaluatorDirty_ = true;
     return true;
 }
 
+size_t Curve::getPointSize() const {
+    return columns_.size();
+}
+
+void Curve::reservePoint(size_t size) {
+    columns_.reserve(size);
+    points_.reserve(size);
+}
+
+KeySpan<int> Curve::getKeyFrames() const {
+    return KeySpan<int>(columns_.keyFrames_.data(), columns_.size());
+}
+
+KeySpan<EInterPolationType> Curve::getInterPolationTypes() const {
+    return KeySpan<EInterPolationType>(columns_.interPolationTypes_.data(), columns_.size());
+}
+
+KeySpan<double> Curve::getDataValues() const {
+    return KeySpan<double>(columns_.data_.data(), columns_.size());
+}
+
+KeySpan<double> Curve::getLeftTagents() const {
+    return KeySpan<double>(columns_.leftTagents_.data(), columns_.size());
+}
+
+KeySpan<double> Curve::getRightTagents() const {
+    return KeySpan<double>(columns_.rightTagents_.data(), columns_.size());
+}
+
+KeySpan<double> Curve::getLeftKeyFrames() const {
+    return KeySpan<double>(columns_.leftKeyFrames_.data(), columns_.size());
+}
+
+KeySpan<double> Curve::getLeftDataValues() const {
+    return KeySpan<double>(columns_.leftData_.data(), columns_.size());
+}
+
+KeySpan<double> Curve::getRightKeyFrames() const {
+    return KeySpan<double>(columns_.rightKeyFrames_.data(), columns_.size());
+}
+
+KeySpan<double> Curve::getRightDataValues() const {
+    return KeySpan<double>(columns_.rightData_.data(), columns_.size());
+}
+
+PointData Curve::getPointData(size_t index) const {
+    return columns_.row(index);
+}
+
+bool Curve::isSorted() const {
+    return sorted_;
+}
+
 bool Curve::getDataValue(int curFrame, double &value) {
-    std::any any;
-
-    auto pointIt = pointList_.begin();
-    while (pointIt != pointList_.end()) {
-        auto pointItTemp = pointIt;
-        pointIt++;
-        if (pointIt != pointList_.end()) {
-			if (curFrame <= (*pointIt)->getKeyFrame() && curFrame >= (*pointItTemp)->getKeyFrame()) {
-				any = calculateLinerValue((*pointItTemp), (*pointIt), curFrame);
-				if (any.type() == typeid(double)) {
-					value = *any._Cast<double>();
-				}
-				return true;
-            }
-        }
-        if (pointIt == pointList_.end()) {
-			auto pointEnd = pointIt;
-			pointEnd--;
-			if (curFrame > (*pointEnd)->getKeyFrame()) {
-				any = (*pointEnd)->getDataValue();
-                if (any.type() == typeid(double)) {
-                    value = *any._Cast<double>();
-                }
-                return true;
-            }
-        }
-        if (pointItTemp == pointList_.begin()) {
-            if (curFrame < (*pointItTemp)->getKeyFrame()) {
-                any = (*pointItTemp)->getDataValue();
-                if (any.type() == typeid(double)) {
-                    value = *any._Cast<double>();
-                }
-                return true;
-            }
-        }
+    size_t size = columns_.size();
+    if (size == 0) {
+        return false;
+    }
+
+    // first segment [index, index + 1] containing curFrame
+    size_t index = lowerBound(curFrame);
+    if (index == 0 && size > 1 && columns_.keyFrames_[0] == curFrame) {
+        index = 1;
+    }
+    if (index > 0 && index < size) {
+        value = calculateLinerValue(index - 1, index, curFrame);
+        return true;
+    }
+    if (curFrame > columns_.keyFrames_.back()) {
+        value = columns_.data_.back();
+        return true;
     }
-    return false;
+    value = columns_.data_.front();
+    return true;
 }
 
 bool Curve::getStepValue(int curFrame, double &value) {
-    std::any any;
-
-    auto pointIt = pointList_.begin();
-    while (pointIt != pointList_.end()) {
-        auto pointItTemp = pointIt;
-        pointIt++;
-        std::any any;
-        if (pointIt != pointList_.end()) {
-            if (curFrame < (*pointIt)->getKeyFrame()) {
-                any = (*pointItTemp)->getDataValue();
-            } else if (curFrame == (*pointIt)->getKeyFrame()) {
-                any = (*pointIt)->getDataValue();
-            }
-            if (any.type() == typeid(double)) {
-                value = std::any_cast<double>(any);
-                return true;
-            }
-        }
-        if (pointIt == pointList_.end()) {
-            auto pointEnd = pointIt;
-            pointEnd--;
-            if (curFrame > (*pointEnd)->getKeyFrame()) {
-                any = (*pointEnd)->getDataValue();
-                if (any.type() == typeid(double)) {
-                    value = *any._Cast<double>();
-                }
-                return true;
-            }
-        }
-        if (pointItTemp == pointList_.begin()) {
-            if (curFrame < (*pointItTemp)->getKeyFrame()) {
-                any = (*pointItTemp)->getDataValue();
-                if (any.type() == typeid(double)) {
-                    value = *any._Cast<double>();
-                }
-                return true;
-            }
-        }
+    size_t size = columns_.size();
+    if (size == 0) {
+        return false;
     }
-    return false;
+
+    size_t index = lowerBound(curFrame);
+    if (index == 0) {
+        value = columns_.data_.front();
+    } else if (index >= size) {
+        value = columns_.data_.back();
+    } else if (curFrame < columns_.keyFrames_[index]) {
+        value = columns_.data_[index - 1];
+    } else {
+        value = columns_.data_[index];
+    }
+    return true;
 }
 
 bool Curve::getPointType(int curFrame, EInterPolationType &type) {
-    auto pointIt = pointList_.begin();
-    while (pointIt != pointList_.end()) {
-        auto pointItTemp = pointIt;
-        pointIt++;
-        if (pointIt != pointList_.end()) {
-            if (curFrame <= (*pointIt)->getKeyFrame() && curFrame >= (*pointItTemp)->getKeyFrame()) {
-                type = (*pointItTemp)->getInterPolationType();
-                return true;
-            }
-        }
-        if (pointIt == pointList_.end()) {
-            auto pointEnd = pointIt;
-            pointEnd--;
-            if (curFrame > (*pointEnd)->getKeyFrame()) {
-                type = (*pointEnd)->getInterPolationType();
-                return true;
-            }
-        }
-        if (pointItTemp == pointList_.begin()) {
-            if (curFrame < (*pointItTemp)->getKeyFrame()) {
-                type = (*pointItTemp)->getInterPolationType();
-                return true;
-            }
-        }
+    size_t size = columns_.size();
+    if (size == 0) {
+        return false;
+    }
+
+    size_t index = lowerBound(curFrame);
+    if (index == 0 && size > 1 && columns_.keyFrames_[0] == curFrame) {
+        index = 1;
+    }
+    if (index > 0 && index < size) {
+        type = columns_.interPolationTypes_[index - 1];
+    } else if (index >= size) {
+        type = columns_.interPolationTypes_.back();
+    } else {
+        type = columns_.interPolationTypes_.front();
+    }
+    return true;
+}
+
+double Curve::calculateLinerValue(size_t firstIndex, size_t secondIndex, double curFrame) {
+    double firstKeyFrame = columns_.keyFrames_[firstIndex];
+    double secondKeyFrame = columns_.keyFrames_[secondIndex];
+    double firstPointValue = columns_.data_[firstIndex];
+    double secondPointValue = columns_.data_[secondIndex];
+    if (secondKeyFrame == firstKeyFrame) {
+        return secondPointValue;
     }
-    return false;
+    return (curFrame - firstKeyFrame) / (secondKeyFrame - firstKeyFrame) * (secondPointValue - firstPointValue) + firstPointValue;
 }
 
-double Curve::calculateLinerValue(Point *firstPoint, Point *secondPoint, double curFrame) {
-    if (firstPoint == nullptr || secondPoint == nullptr) {
+bool Curve::modifyPointKeyFrame(const int &keyFrame, const int &modifyKeyFrame) {
+    if (findPoint(modifyKeyFrame) != npos) {
+        return false;
+    }
+    size_t index = findPoint(keyFrame);
+    if (index == npos) {
         return false;
     }
 
-    EInterPolationType type = secondPoint->getInterPolationType();
-    double firstPointValue{0};
-    double secondPointValue{0};
-    if (firstPoint->getDataValue().has_value() && secondPoint->getDataValue().has_value()) {
-        if (firstPoint->getDataValue().type() == typeid(double)) {
-            firstPointValue = std::any_cast<double>(firstPoint->getDataValue());
-            secondPointValue = std::any_cast<double>(secondPoint->getDataValue());
-        } else if (firstPoint->getDataValue().type() == typeid(float)) {
-            firstPointValue = std::any_cast<float>(firstPoint->getDataValue());
-            secondPointValue = std::any_cast<float>(secondPoint->getDataValue());
-        }
+    PointData pointData = columns_.row(index);
+    Point *point = points_[index];
+    eraseRow(index);
+    pointData.keyFrame_ = modifyKeyFrame;
+    insertRow(lowerBound(modifyKeyFrame), pointData, point);
+    return true;
+}
+
+bool Curve::evaluate(double curFrame, double &value) {
+    return getEvaluator().evaluate(curFrame, value);
+}
+
+void Curve::invalidate() {
+    invalidateRange(INT_MIN, INT_MAX);
+}
+
+const CurveEvaluator &Curve::getEvaluator() {
+    if (evaluatorDirty_) {
+        evaluator_.compile(*this);
+        evaluatorDirty_ = false;
     }
-    double t = (curFrame - firstPoint->getKeyFrame()) / (secondPoint->getKeyFrame() - firstPoint->getKeyFrame()) * (secondPointValue - firstPointValue) + firstPointValue;
-    return t;
-//    switch (type) {
-//    case LINER: {
-//        return 0;
-//    }
-//    case HERMIT_SPLINE: {
-//		return 0;
-//    }
-//    case BESIER_SPLINE: {
-//		return 0;
-//    }
-//	default:
-//		return 0;
-//    }
+    return evaluator_;
 }
 
-bool Curve::modifyPointKeyFrame(const int &keyFrame, const int &modifyKeyFrame) {
-    Point* point{nullptr};
+bool Curve::getFrameValue(int curFrame, double &value) {
+    if (frameCache_.lookup(curFrame, value)) {
+        return true;
+    }
+    if (!getEvaluator().evaluate(curFrame, value)) {
+        return false;
+    }
+    frameCache_.store(curFrame, value);
+    return true;
+}
 
-    if (!pointList_.empty()) {
-        auto it = pointList_.begin();
-        while (it != pointList_.end()) {
-            if ((*it)->getKeyFrame() == keyFrame) {
-                point = (*it);
-            }
-            if ((*it)->getKeyFrame() == modifyKeyFrame) {
-                return false;
-            }
-            it++;
+uint64_t Curve::getRevision() const {
+    return revision_;
+}
+
+void Curve::restoreRevision(uint64_t revision) {
+    revision_ = revision;
+}
+
+CurveFrameCache &Curve::getFrameCache() {
+    return frameCache_;
+}
+
+size_t Curve::findPoint(int keyFrame) const {
+    if (sorted_) {
+        size_t index = lowerBound(keyFrame);
+        if (index < columns_.size() && columns_.keyFrames_[index] == keyFrame) {
+            return index;
         }
+        return npos;
     }
+    auto it = std::find(columns_.keyFrames_.begin(), columns_.keyFrames_.end(), keyFrame);
+    if (it == columns_.keyFrames_.end()) {
+        return npos;
+    }
+    return std::distance(columns_.keyFrames_.begin(), it);
+}
+
+size_t Curve::lowerBound(int keyFrame) const {
+    const auto &keyFrames = columns_.keyFrames_;
+    if (sorted_) {
+        return std::distance(keyFrames.begin(), std::lower_bound(keyFrames.begin(), keyFrames.end(), keyFrame));
+    }
+    // keys are being moved by the editor, keep the list scan until sortPoint is called
+    auto it = std::find_if(keyFrames.begin(), keyFrames.end(), [keyFrame](int frame) {
+        return frame >= keyFrame;
+    });
+    return std::distance(keyFrames.begin(), it);
+}
+
+void Curve::insertRow(size_t index, const PointData &pointData, Point *point) {
+    columns_.insert(index, pointData);
+    points_.insert(points_.begin() + index, point);
     if (point) {
-        pointList_.remove(point);
-		point->setKeyFrame(modifyKeyFrame);
-        insertPoint(point);
-        return true;
+        point->curve_ = this;
+    } else {
+        pointListComplete_ = false;
+    }
+    updatePointIndex(index);
+    invalidateKey(index);
+}
+
+void Curve::eraseRow(size_t index) {
+    invalidateKey(index);
+    columns_.erase(index);
+    points_.erase(points_.begin() + index);
+    updatePointIndex(index);
+}
+
+void Curve::updatePointIndex(size_t begin) {
+    for (size_t index = begin; index < points_.size(); index++) {
+        if (points_[index]) {
+            points_[index]->index_ = index;
+        }
+    }
+}
+
+void Curve::setPointKeyFrame(size_t index, int keyFrame) {
+    auto &keyFrames = columns_.keyFrames_;
+    invalidateKey(index);
+    keyFrames[index] = keyFrame;
+    if ((index > 0 && keyFrames[index - 1] > keyFrame) || (index + 1 < keyFrames.size() && keyFrames[index + 1] < keyFrame)) {
+        sorted_ = false;
+    }
+    invalidateKey(index);
+}
+
+void Curve::keyFrameRange(size_t index, int &firstFrame, int &lastFrame) const {
+    const auto &keyFrames = columns_.keyFrames_;
+    firstFrame = INT_MIN;
+    lastFrame = INT_MAX;
+    if (!sorted_ || index >= keyFrames.size()) {
+        return;
+    }
+    // keys sharing the frame are compiled into one, they influence the same segments
+    size_t first = index;
+    while (first > 0 && keyFrames[first - 1] == keyFrames[index]) {
+        first--;
+    }
+    size_t last = index;
+    while (last + 1 < keyFrames.size() && keyFrames[last + 1] == keyFrames[index]) {
+        last++;
     }
-    return false;
+    if (first > 0) {
+        firstFrame = keyFrames[first - 1];
+    }
+    if (last + 1 < keyFrames.size()) {
+        lastFrame = keyFrames[last + 1];
+    }
+}
+
+void Curve::invalidateKey(size_t index) {
+    int firstFrame{INT_MIN}, lastFrame{INT_MAX};
+    keyFrameRange(index, firstFrame, lastFrame);
+    invalidateRange(firstFrame, lastFrame);
+}
+
+void Curve::invalidateRange(int firstFrame, int lastFrame) {
+    revision_ = nextRevision();
+    evaluatorDirty_ = true;
+    frameCache_.invalidate(firstFrame, lastFrame);
 }
 }
@@ -0,0 +1,218 @@
+#include "CurveData/CurveEvaluator.h"
+#include "CurveData/CurveData.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <numeric>
+
+namespace raco::guiData {
+
+namespace {
+// worker points which were never set by the curve editor keep INT_MIN
+bool isWorkerPointValid(double keyFrame) {
+    return keyFrame > static_cast<double>(INT_MIN);
+}
+
+double evaluatePolynomial(const double coeff[4], double t) {
+    return ((coeff[0] * t + coeff[1]) * t + coeff[2]) * t + coeff[3];
+}
+
+void bezierCoefficient(double p0, double p1, double p2, double p3, double coeff[4]) {
+    coeff[0] = p3 - p0 + 3.0 * (p1 - p2);
+    coeff[1] = 3.0 * (p0 - 2.0 * p1 + p2);
+    coeff[2] = 3.0 * (p1 - p0);
+    coeff[3] = p0;
+}
+
+void hermiteCoefficient(double p0, double p1, double m0, double m1, double coeff[4]) {
+    coeff[0] = 2.0 * p0 + m0 - 2.0 * p1 + m1;
+    coeff[1] = -3.0 * p0 - 2.0 * m0 + 3.0 * p1 - m1;
+    coeff[2] = m0;
+    coeff[3] = p0;
+}
+}
+
+void CurveEvaluator::compile(const Curve &curve) {
+    clear();
+    size_t size = curve.getPointSize();
+    keyFrames_.reserve(size);
+    keyValues_.reserve(size);
+    segments_.reserve(size);
+
+    KeySpan<int> keyFrames = curve.getKeyFrames();
+    KeySpan<EInterPolationType> types = curve.getInterPolationTypes();
+    KeySpan<double> values = curve.getDataValues();
+    KeySpan<double> leftKeyFrames = curve.getLeftKeyFrames();
+    KeySpan<double> leftValues = curve.getLeftDataValues();
+    KeySpan<double> rightKeyFrames = curve.getRightKeyFrames();
+    KeySpan<double> rightValues = curve.getRightDataValues();
+
+    // keys are compiled in frame order even while the editor moves them around
+    std::vector<size_t> order(size);
+    std::iota(order.begin(), order.end(), 0);
+    if (!curve.isSorted()) {
+        std::stable_sort(order.begin(), order.end(), [&keyFrames](size_t a, size_t b) {
+            return keyFrames[a] < keyFrames[b];
+        });
+    }
+
+    size_t last{0};
+    for (size_t i{0}; i < size; i++) {
+        size_t index = order[i];
+        double keyFrame = keyFrames[index];
+        double value = values[index];
+        // keys sharing one frame collapse to the last one, zero length segments can't be sampled
+        if (i > 0 && keyFrames[last] == keyFrames[index]) {
+            keyValues_.back() = value;
+            last = index;
+            continue;
+        }
+        if (i > 0) {
+            Segment segment;
+            segment.type = types[last];
+
+            double frame0 = keyFrames_.back();
+            double value0 = keyValues_.back();
+            double length = keyFrame - frame0;
+
+            switch (segment.type) {
+            case EInterPolationType::STEP: {
+                segment.valueCoeff[3] = value0;
+                break;
+            }
+            case EInterPolationType::BESIER_SPLINE: {
+                // worker points are pulled back onto the segment the same way VisualCurveWidget draws them
+                double rightFrame = frame0, rightValue = value0;
+                if (isWorkerPointValid(rightKeyFrames[last])) {
+                    rightFrame = rightKeyFrames[last];
+                    rightValue = rightValues[last];
+                    if (rightFrame > keyFrame) {
+                        rightValue = value0 + length / (rightFrame - frame0) * (rightValue - value0);
+                        rightFrame = keyFrame;
+                    }
+                }
+                double leftFrame = keyFrame, leftValue = value;
+                if (isWorkerPointValid(leftKeyFrames[index])) {
+                    leftFrame = leftKeyFrames[index];
+                    leftValue = leftValues[index];
+                    if (leftFrame < frame0) {
+                        leftValue = value + length / (keyFrame - leftFrame) * (leftValue - value);
+                        leftFrame = frame0;
+                    }
+                }
+                rightFrame = std::clamp(rightFrame, frame0, keyFrame);
+                leftFrame = std::clamp(leftFrame, frame0, keyFrame);
+                bezierCoefficient(0.0, (rightFrame - frame0) / length, (leftFrame - frame0) / length, 1.0, segment.frameCoeff);
+                bezierCoefficient(value0, rightValue, leftValue, value, segment.valueCoeff);
+                break;
+            }
+            case EInterPolationType::HERMIT_SPLINE: {
+                // tangents are limited to three times the segment length like in VisualCurveWidget
+                double tangent0{0.0}, tangent1{0.0};
+                if (isWorkerPointValid(rightKeyFrames[last])) {
+                    double rightLength = rightKeyFrames[last] - frame0;
+                    tangent0 = rightValues[last] - value0;
+                    if (rightLength > 3.0 * length) {
+                        tangent0 *= 3.0 * length / rightLength;
+                    }
+                }
+                if (isWorkerPointValid(leftKeyFrames[index])) {
+                    double leftLength = keyFrame - leftKeyFrames[index];
+                    tangent1 = leftValues[index] - value;
+                    if (leftLength > 3.0 * length) {
+                        tangent1 *= 3.0 * length / leftLength;
+                    }
+                }
+                hermiteCoefficient(value0, value, tangent0, tangent1, segment.valueCoeff);
+                break;
+            }
+            default: {
+                segment.valueCoeff[2] = value - value0;
+                segment.valueCoeff[3] = value0;
+                break;
+            }
+            }
+            segments_.push_back(segment);
+        }
+        keyFrames_.push_back(keyFrame);
+        keyValues_.push_back(value);
+        last = index;
+    }
+}
+
+void CurveEvaluator::clear() {
+    keyFrames_.clear();
+    keyValues_.clear();
+    segments_.clear();
+}
+
+bool CurveEvaluator::empty() const {
+    return keyFrames_.empty();
+}
+
+bool CurveEvaluator::evaluate(double frame, double &value) const {
+    if (keyFrames_.empty()) {
+        return false;
+    }
+    if (frame <= keyFrames_.front()) {
+        value = keyValues_.front();
+        return true;
+    }
+    if (frame >= keyFrames_.back()) {
+        value = keyValues_.back();
+        return true;
+    }
+
+    auto it = std::upper_bound(keyFrames_.begin(), keyFrames_.end(), frame);
+    size_t index = std::distance(keyFrames_.begin(), it) - 1;
+    if (frame == keyFrames_[index]) {
+        value = keyValues_[index];
+        return true;
+    }
+
+    const Segment &segment = segments_[index];
+    double t = (frame - keyFrames_[index]) / (keyFrames_[index + 1] - keyFrames_[index]);
+    if (segment.type == EInterPolationType::BESIER_SPLINE) {
+        t = solveBezierTime(segment, t, t);
+    }
+    value = evaluatePolynomial(segment.valueCoeff, t);
+    return true;
+}
+
+double CurveEvaluator::solveBezierTime(const Segment &segment, double x, double t) const {
+    // newton iteration on the monotonic frame polynomial, falling back to bisection
+    const double epsilon = 1e-9;
+    const double *coeff = segment.frameCoeff;
+    for (int i{0}; i < 8; i++) {
+        double error = evaluatePolynomial(coeff, t) - x;
+        if (std::abs(error) < epsilon) {
+            return t;
+        }
+        double derivative = (3.0 * coeff[0] * t + 2.0 * coeff[1]) * t + coeff[2];
+        if (std::abs(derivative) < epsilon) {
+            break;
+        }
+        t -= error / derivative;
+        if (t < 0.0 || t > 1.0) {
+            break;
+        }
+    }
+
+    double low{0.0}, high{1.0};
+    t = x;
+    for (int i{0}; i < 64; i++) {
+        double error = evaluatePolynomial(coeff, t) - x;
+        if (std::abs(error) < epsilon) {
+            break;
+        }
+        if (error > 0.0) {
+            high = t;
+        } else {
+            low = t;
+        }
+        t = (low + high) * 0.5;
+    }
+    return t;
+}
+}
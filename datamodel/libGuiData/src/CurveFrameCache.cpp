@@ -0,0 +1,181 @@
+#include "CurveData/CurveFrameCache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_set>
+
+namespace raco::guiData {
+
+namespace {
+std::atomic<uint64_t> cacheHits{0};
+std::atomic<uint64_t> cacheMisses{0};
+std::atomic<uint64_t> cacheEvictions{0};
+std::atomic<uint64_t> cacheUseClock{0};
+std::atomic<size_t> cacheMemoryUsage{0};
+std::atomic<size_t> cacheMemoryBudget{64 * 1024 * 1024};
+
+// caches which hold memory, candidates for eviction
+std::mutex cacheRegistryMutex;
+std::unordered_set<CurveFrameCache *> cacheRegistry;
+
+// frames added in front of or behind the window when it has to grow, playback walks frame by frame
+const int64_t windowGrowth = 64;
+// longest window of one cache, a scrub far along the timeline doesn't span the gap
+const int64_t maxWindowFrames = 4096;
+const size_t bytesPerFrame = sizeof(double) + sizeof(uint8_t);
+}
+
+CurveFrameCache::CurveFrameCache(const CurveFrameCache &other) {
+}
+
+CurveFrameCache &CurveFrameCache::operator=(const CurveFrameCache &other) {
+    if (this != &other) {
+        clear();
+    }
+    return *this;
+}
+
+CurveFrameCache::~CurveFrameCache() {
+    clear();
+}
+
+bool CurveFrameCache::lookup(int frame, double &value) {
+    int64_t index = static_cast<int64_t>(frame) - firstFrame_;
+    if (index >= 0 && index < static_cast<int64_t>(valid_.size()) && valid_[index]) {
+        value = values_[index];
+        lastUse_ = cacheUseClock.fetch_add(1, std::memory_order_relaxed) + 1;
+        cacheHits.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    cacheMisses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void CurveFrameCache::store(int frame, double value) {
+    int64_t index = static_cast<int64_t>(frame) - firstFrame_;
+    if (index < 0 || index >= static_cast<int64_t>(valid_.size())) {
+        if (!reserveWindow(frame, frame)) {
+            return;
+        }
+        index = static_cast<int64_t>(frame) - firstFrame_;
+    }
+    values_[index] = value;
+    valid_[index] = 1;
+    lastUse_ = cacheUseClock.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+void CurveFrameCache::invalidate(int firstFrame, int lastFrame) {
+    if (valid_.empty()) {
+        return;
+    }
+    int64_t begin = std::max<int64_t>(static_cast<int64_t>(firstFrame) - firstFrame_, 0);
+    int64_t end = std::min<int64_t>(static_cast<int64_t>(lastFrame) - firstFrame_ + 1, static_cast<int64_t>(valid_.size()));
+    if (begin < end) {
+        std::fill(valid_.begin() + begin, valid_.begin() + end, 0);
+    }
+}
+
+void CurveFrameCache::clear() {
+    if (valid_.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(cacheRegistryMutex);
+    cacheRegistry.erase(this);
+    release();
+}
+
+size_t CurveFrameCache::memoryUsage() const {
+    return valid_.size() * bytesPerFrame;
+}
+
+void CurveFrameCache::setMemoryBudget(size_t bytes) {
+    cacheMemoryBudget = bytes;
+}
+
+CurveFrameCache::Statistics CurveFrameCache::statistics() {
+    Statistics statistics;
+    statistics.hits_ = cacheHits;
+    statistics.misses_ = cacheMisses;
+    statistics.evictions_ = cacheEvictions;
+    statistics.memoryUsage_ = cacheMemoryUsage;
+    statistics.memoryBudget_ = cacheMemoryBudget;
+    return statistics;
+}
+
+void CurveFrameCache::resetStatistics() {
+    cacheHits = 0;
+    cacheMisses = 0;
+    cacheEvictions = 0;
+}
+
+bool CurveFrameCache::reserveWindow(int firstFrame, int lastFrame) {
+    int64_t first = firstFrame;
+    int64_t last = lastFrame;
+    bool keepValues = !valid_.empty();
+    if (keepValues) {
+        int64_t oldFirst = firstFrame_;
+        int64_t oldLast = oldFirst + static_cast<int64_t>(valid_.size()) - 1;
+        first = first < oldFirst ? first - windowGrowth : oldFirst;
+        last = last > oldLast ? last + windowGrowth : oldLast;
+        if (last - first + 1 > maxWindowFrames) {
+            // start a new window around the requested frames, the old values are dropped
+            keepValues = false;
+            first = static_cast<int64_t>(firstFrame) - windowGrowth;
+            last = static_cast<int64_t>(lastFrame) + windowGrowth;
+        }
+    }
+    first = std::max<int64_t>(first, INT32_MIN);
+    last = std::min<int64_t>(last, INT32_MAX);
+
+    size_t size = static_cast<size_t>(last - first + 1);
+    size_t oldBytes = memoryUsage();
+    size_t newBytes = size * bytesPerFrame;
+
+    std::lock_guard<std::mutex> lock(cacheRegistryMutex);
+    if (newBytes > oldBytes && !evict(newBytes - oldBytes)) {
+        return false;
+    }
+
+    std::vector<double> values(size, 0.0);
+    std::vector<uint8_t> valid(size, 0);
+    if (keepValues) {
+        size_t offset = static_cast<size_t>(static_cast<int64_t>(firstFrame_) - first);
+        std::copy(values_.begin(), values_.end(), values.begin() + offset);
+        std::copy(valid_.begin(), valid_.end(), valid.begin() + offset);
+    }
+    values_ = std::move(values);
+    valid_ = std::move(valid);
+    firstFrame_ = static_cast<int>(first);
+    cacheMemoryUsage.fetch_add(newBytes, std::memory_order_relaxed);
+    cacheMemoryUsage.fetch_sub(oldBytes, std::memory_order_relaxed);
+    cacheRegistry.insert(this);
+    return true;
+}
+
+void CurveFrameCache::release() {
+    cacheMemoryUsage.fetch_sub(memoryUsage(), std::memory_order_relaxed);
+    firstFrame_ = 0;
+    values_ = std::vector<double>();
+    valid_ = std::vector<uint8_t>();
+}
+
+bool CurveFrameCache::evict(size_t bytes) {
+    size_t budget = cacheMemoryBudget.load(std::memory_order_relaxed);
+    while (cacheMemoryUsage.load(std::memory_order_relaxed) + bytes > budget) {
+        CurveFrameCache *victim{nullptr};
+        for (auto *cache : cacheRegistry) {
+            if (cache != this && (!victim || cache->lastUse_ < victim->lastUse_)) {
+                victim = cache;
+            }
+        }
+        if (!victim) {
+            return false;
+        }
+        cacheRegistry.erase(victim);
+        victim->release();
+        cacheEvictions.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+}
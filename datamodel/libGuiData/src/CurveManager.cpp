@@ -12,17 +12,18 @@ std::list<STRUCT_CURVE> CurveManager::convertCurveData() {
         STRUCT_CURVE tempCurve;
         tempCurve.curveName_ = curve->getCurveName();
         tempCurve.dataType_ = curve->getDataType();
-        for (auto point : curve->getPointList()) {
+        for (size_t index{0}; index < curve->getPointSize(); index++) {
+            PointData point = curve->getPointData(index);
             STRUCT_POINT tempPoint;
-            tempPoint.keyFrame_ = point->getKeyFrame();
-            tempPoint.leftKeyFrame_ = point->getLeftKeyFrame();
-            tempPoint.rightKeyFrame_ = point->getRightKeyFrame();
-            tempPoint.interPolationType_ = point->getInterPolationType();
-            tempPoint.data_ = point->getDataValue();
-            tempPoint.leftData_ = point->getLeftData();
-            tempPoint.rightData_ = point->getRightData();
-            tempPoint.leftTagent_ = point->getLeftTagent();
-            tempPoint.rightTagent_ = point->getRightTagent();
+            tempPoint.keyFrame_ = point.keyFrame_;
+            tempPoint.leftKeyFrame_ = point.leftKeyFrame_;
+            tempPoint.rightKeyFrame_ = point.rightKeyFrame_;
+            tempPoint.interPolationType_ = point.interPolationType_;
+            tempPoint.data_ = point.data_;
+            tempPoint.leftData_ = point.leftData_;
+            tempPoint.rightData_ = point.rightData_;
+            tempPoint.leftTagent_ = point.leftTagent_;
+            tempPoint.rightTagent_ = point.rightTagent_;
             tempCurve.pointList.push_back(tempPoint);
         }
         curveList.push_back(tempCurve);
@@ -55,10 +56,11 @@ void CurveManager::merge(QVariant data) {
             for (const auto &destCurve : list) {
                 Curve *curve = new Curve;
                 mergeCurve(curve, destCurve);
+                curve->reservePoint(destCurve.pointList.size());
                 for (const auto &destPoint : destCurve.pointList) {
-                    Point *point = new Point;
-                    mergePoint(point, destPoint);
-                    curve->insertPoint(point);
+                    Point point;
+                    mergePoint(&point, destPoint);
+                    curve->insertPoint(point.getPointData());
                 }
                 addCurve(curve);
             }
@@ -66,6 +68,68 @@ void CurveManager::merge(QVariant data) {
     }
 }
 
+size_t CurveSnapshot::memoryUsage() const {
+    size_t rowBytes = sizeof(int) + sizeof(EInterPolationType) + 7 * sizeof(double);
+    return sizeof(CurveSnapshot) + curveName_.capacity() + columns_.size() * rowBytes;
+}
+
+std::vector<SharedCurveSnapshot> CurveManager::snapshotCurves(const std::vector<SharedCurveSnapshot> &previous) {
+    std::unordered_map<uint64_t, SharedCurveSnapshot> previousByRevision;
+    for (const auto &snapshot : previous) {
+        previousByRevision.emplace(snapshot->revision_, snapshot);
+    }
+
+    std::vector<SharedCurveSnapshot> snapshots;
+    snapshots.reserve(curveList_.size());
+    for (auto curve : curveList_) {
+        auto it = previousByRevision.find(curve->getRevision());
+        if (it != previousByRevision.end() && it->second->curveName_ == curve->getCurveName() && it->second->dataType_ == curve->getDataType()) {
+            snapshots.push_back(it->second);
+            continue;
+        }
+        auto snapshot = std::make_shared<CurveSnapshot>();
+        snapshot->curveName_ = curve->getCurveName();
+        snapshot->dataType_ = curve->getDataType();
+        snapshot->revision_ = curve->getRevision();
+        snapshot->columns_ = curve->getPointColumns();
+        snapshots.push_back(snapshot);
+    }
+    return snapshots;
+}
+
+void CurveManager::restoreCurves(const std::vector<SharedCurveSnapshot> &snapshots) {
+    if (snapshots.empty()) {
+        return;
+    }
+
+    std::set<std::string> names;
+    for (const auto &snapshot : snapshots) {
+        names.insert(snapshot->curveName_);
+    }
+    for (auto curve : getCurveList()) {
+        if (names.find(curve->getCurveName()) == names.end()) {
+            delCurve(curve->getCurveName());
+        }
+    }
+
+    // curves still there are updated in place, handles to them stay valid
+    for (const auto &snapshot : snapshots) {
+        Curve *curve = getCurve(snapshot->curveName_);
+        if (!curve) {
+            curve = new Curve;
+            curve->setCurveName(snapshot->curveName_);
+            addCurve(curve);
+        }
+        curve->setDataType(snapshot->dataType_);
+        if (curve->getRevision() != snapshot->revision_) {
+            curve->assignPoints(PointColumns(snapshot->columns_));
+            curve->restoreRevision(snapshot->revision_);
+        }
+        // moving the node keeps the list iterators of the slots valid
+        curveList_.splice(curveList_.end(), curveList_, curveSlots_[curveIndex_[snapshot->curveName_]].listIt_);
+    }
+}
+
 CurveManager &CurveManager::GetInstance() {
     // TODO: 在此处插入 return 语句
     static CurveManager Instance;
@@ -85,42 +149,24 @@ bool CurveManager::addCurve(Curve *curve) {
         return false;
     }
 
-    std::string curveName = curve->getCurveName();
-
-    auto it = curveList_.begin();
-    while (it != curveList_.end()) {
-        if ((*it)->getCurveName().compare(curveName) == 0) {
-            return false;
-        }
-        it++;
+    if (curveIndex_.find(curve->getCurveName()) != curveIndex_.end()) {
+        return false;
     }
     curveList_.push_back(curve);
+    insertIndex(curve, std::prev(curveList_.end()));
     return true;
 }
 
 bool CurveManager::takeCurve(const std::string &curveNmae) {
-    auto it = curveList_.begin();
-    while (it != curveList_.end()) {
-        if ((*it)->getCurveName().compare(curveNmae) == 0) {
-            it = curveList_.erase(it);
-            return true;
-        }
-        it++;
-    }
-    return false;
+    return eraseIndex(curveNmae) != nullptr;
 }
 
 bool CurveManager::delCurve(const std::string &curveNmae) {
-    auto it = curveList_.begin();
-    while (it != curveList_.end()) {
-        if ((*it)->getCurveName().compare(curveNmae) == 0) {
-            Curve *curve = *it;
-            it = curveList_.erase(it);
-            delete curve;
-            curve = nullptr;
-            return true;
-        }
-        it++;
+    Curve *curve = eraseIndex(curveNmae);
+    if (curve) {
+        delete curve;
+        curve = nullptr;
+        return true;
     }
     return false;
 }
@@ -128,21 +174,31 @@ bool CurveManager::delCurve(const std::string &curveNmae) {
 std::list<Curve *> CurveManager::search(const std::string &curveNmae) {
     std::list<Curve*> tempCurveList;
 
-    std::regex regex(curveNmae);
-    auto it = curveList_.begin();
-    while (it != curveList_.end()) {
-        if (std::regex_search((*it)->getCurveName(), regex)) {
-            tempCurveList.push_back((*it));
+    // plain names are matched as substrings, patterns are compiled once and reused
+    if (curveNmae.find_first_of("\\^$.|?*+()[]{}") == std::string::npos) {
+        for (auto curve : curveList_) {
+            if (curve->getCurveName().find(curveNmae) != std::string::npos) {
+                tempCurveList.push_back(curve);
+            }
         }
-        it++;
+        return tempCurveList;
     }
 
+    if (searchPattern_ != curveNmae) {
+        searchRegex_ = std::regex(curveNmae);
+        searchPattern_ = curveNmae;
+    }
+    for (auto curve : curveList_) {
+        if (std::regex_search(curve->getCurveName(), searchRegex_)) {
+            tempCurveList.push_back(curve);
+        }
+    }
     return tempCurveList;
 }
 
 bool CurveManager::getCurveValue(std::string curve, int keyFrame, EInterPolationType type, double &value) {
-    if (getCurve(curve)) {
-        Curve* tempCurve = getCurve(curve);
+    Curve* tempCurve = getCurve(curve);
+    if (tempCurve) {
         switch (type) {
         case LINER: {
             if (tempCurve->getDataValue(keyFrame, value)) {
@@ -164,8 +220,8 @@ bool CurveManager::getCurveValue(std::string curve, int keyFrame, EInterPolation
 }
 
 bool CurveManager::getPointType(std::string curve, int keyFrame, EInterPolationType &type) {
-    if (getCurve(curve)) {
-        Curve* tempCurve = getCurve(curve);
+    Curve* tempCurve = getCurve(curve);
+    if (tempCurve) {
         if (tempCurve->getPointType(keyFrame, type)) {
             return true;
         }
@@ -174,48 +230,55 @@ bool CurveManager::getPointType(std::string curve, int keyFrame, EInterPolationT
 }
 
 Curve *CurveManager::getCurve(const std::string &curveName) {
-    Curve* curve{nullptr};
-    auto it = curveList_.begin();
-    while (it != curveList_.end()) {
-        if ((*it)->getCurveName().compare(curveName) == 0) {
-            curve = (*it);
-            break;
-        }
-        it++;
+    auto it = curveIndex_.find(curveName);
+    if (it == curveIndex_.end()) {
+        return nullptr;
     }
-    return curve;
+    return curveSlots_[it->second].curve_;
 }
 
-bool CurveManager::modifyCurveName(const std::string &curveName, const std::string &modifyName) {
-    Curve* curve{nullptr};
-
-    auto it = curveList_.begin();
-    while (it != curveList_.end()) {
-        if ((*it)->getCurveName().compare(curveName) == 0) {
-            curve = (*it);
-        }
-        if ((*it)->getCurveName().compare(modifyName) == 0) {
-            return false;
-        }
-        it++;
+Curve *CurveManager::getCurve(const CurveHandle &handle) {
+    if (handle.index_ >= curveSlots_.size()) {
+        return nullptr;
     }
-    if (curve) {
-        curve->setCurveName(modifyName);
-        return true;
+    const CurveSlot &slot = curveSlots_[handle.index_];
+    if (slot.generation_ != handle.generation_) {
+        return nullptr;
     }
-    return false;
+    return slot.curve_;
 }
 
-bool CurveManager::copyCurve(const std::string &curveName) {
-    Curve* curve{nullptr};
+CurveHandle CurveManager::getCurveHandle(const std::string &curveName) {
+    CurveHandle handle;
+    auto it = curveIndex_.find(curveName);
+    if (it != curveIndex_.end()) {
+        handle.index_ = it->second;
+        handle.generation_ = curveSlots_[it->second].generation_;
+    }
+    return handle;
+}
 
-    auto it = curveList_.begin();
-    while (it != curveList_.end()) {
-        if ((*it)->getCurveName().compare(curveName) == 0) {
-            curve = (*it);
-        }
-        it++;
+bool CurveManager::modifyCurveName(const std::string &curveName, const std::string &modifyName) {
+    if (hasCurve(modifyName)) {
+        return false;
+    }
+    auto it = curveIndex_.find(curveName);
+    if (it == curveIndex_.end()) {
+        return false;
     }
+
+    size_t index = it->second;
+    CurveSlot &slot = curveSlots_[index];
+    curveIndex_.erase(it);
+    slot.curve_->setCurveName(modifyName);
+    // handles cached under the old name have to be resolved again
+    slot.generation_++;
+    curveIndex_.emplace(modifyName, index);
+    return true;
+}
+
+bool CurveManager::copyCurve(const std::string &curveName) {
+    Curve* curve = getCurve(curveName);
     if (curve) {
         Curve* cpCurve = new Curve();
         std::string copyCurveName = curveName + "_cp";
@@ -227,14 +290,9 @@ bool CurveManager::copyCurve(const std::string &curveName) {
         }
         cpCurve->setCurveName(copyCurveName);
         cpCurve->setDataType(curve->getDataType());
-        for (auto it : curve->getPointList()) {
-            Point *cpPoint = new Point;
-            cpPoint->setDataValue(it->getDataValue());
-            cpPoint->setKeyFrame(it->getKeyFrame());
-            cpPoint->setInterPolationType(it->getInterPolationType());
-            cpPoint->setLeftTagent(it->getLeftTagent());
-            cpPoint->setRightTagent(it->getRightTagent());
-            cpCurve->insertPoint(cpPoint);
+        cpCurve->reservePoint(curve->getPointSize());
+        for (size_t index{0}; index < curve->getPointSize(); index++) {
+            cpCurve->insertPoint(curve->getPointData(index));
         }
         addCurve(cpCurve);
         return true;
@@ -243,14 +301,7 @@ bool CurveManager::copyCurve(const std::string &curveName) {
 }
 
 bool CurveManager::hasCurve(const std::string &curveName) {
-    auto it = curveList_.begin();
-    while (it != curveList_.end()) {
-        if ((*it)->getCurveName().compare(curveName) == 0) {
-            return true;
-        }
-        it++;
-    }
-    return false;
+    return curveIndex_.find(curveName) != curveIndex_.end();
 }
 
 bool CurveManager::clearCurve() {
@@ -259,10 +310,48 @@ bool CurveManager::clearCurve() {
         it = nullptr;
     }
     curveList_.clear();
+    // keep the slots so that handles of deleted curves never alias new curves
+    freeSlots_.clear();
+    for (size_t index{0}; index < curveSlots_.size(); index++) {
+        curveSlots_[index].curve_ = nullptr;
+        curveSlots_[index].generation_++;
+        freeSlots_.push_back(index);
+    }
+    curveIndex_.clear();
     return true;
 }
 
 std::list<Curve *> CurveManager::getCurveList() {
     return curveList_;
 }
+
+void CurveManager::insertIndex(Curve *curve, std::list<Curve *>::iterator listIt) {
+    size_t index = curveSlots_.size();
+    if (!freeSlots_.empty()) {
+        index = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        curveSlots_.emplace_back();
+    }
+    CurveSlot &slot = curveSlots_[index];
+    slot.curve_ = curve;
+    slot.listIt_ = listIt;
+    curveIndex_.emplace(curve->getCurveName(), index);
+}
+
+Curve *CurveManager::eraseIndex(const std::string &curveName) {
+    auto it = curveIndex_.find(curveName);
+    if (it == curveIndex_.end()) {
+        return nullptr;
+    }
+    size_t index = it->second;
+    CurveSlot &slot = curveSlots_[index];
+    Curve *curve = slot.curve_;
+    curveList_.erase(slot.listIt_);
+    slot.curve_ = nullptr;
+    slot.generation_++;
+    freeSlots_.push_back(index);
+    curveIndex_.erase(it);
+    return curve;
+}
 }
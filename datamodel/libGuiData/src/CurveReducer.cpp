@@ -0,0 +1,190 @@
+#include "CurveData/CurveReducer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace raco::guiData {
+
+namespace {
+// cubic through two keys with the tangents given as value change per frame
+double hermiteValue(double value0, double value1, double tangent0, double tangent1, double length, double t) {
+    double t2 = t * t;
+    double t3 = t2 * t;
+    return (2.0 * t3 - 3.0 * t2 + 1.0) * value0 + (t3 - 2.0 * t2 + t) * tangent0 * length
+        + (-2.0 * t3 + 3.0 * t2) * value1 + (t3 - t2) * tangent1 * length;
+}
+}
+
+CurveReducer::CurveReducer(double tolerance) : tolerance_{std::max(tolerance, 0.0)} {
+}
+
+void CurveReducer::setTolerance(double tolerance) {
+    tolerance_ = std::max(tolerance, 0.0);
+}
+
+double CurveReducer::getTolerance() const {
+    return tolerance_;
+}
+
+size_t CurveReducer::reduce(PointColumns &columns) const {
+    size_t size = columns.size();
+    if (size < 3 || tolerance_ <= 0.0) {
+        return 0;
+    }
+    const auto &keyFrames = columns.keyFrames_;
+    const auto &types = columns.interPolationTypes_;
+    const auto &values = columns.data_;
+    std::vector<bool> keep(size, true);
+
+    size_t index{0};
+    while (index + 1 < size) {
+        // repeated step keys: the previous step already holds the value
+        if (types[index] == STEP) {
+            size_t next = index + 1;
+            while (next + 1 < size && types[next] == STEP && keyFrames[next] != keyFrames[index]
+                   && std::abs(values[next] - values[index]) <= tolerance_) {
+                keep[next] = false;
+                next++;
+            }
+            index = next;
+            continue;
+        }
+        if (types[index] != LINER) {
+            index++;
+            continue;
+        }
+        size_t last = index;
+        while (last + 1 < size && types[last] == LINER && keyFrames[last + 1] > keyFrames[last]) {
+            last++;
+        }
+        if (last > index + 1) {
+            reduceLinerRun(columns, index, last, keep);
+        }
+        index = std::max(last, index + 1);
+    }
+
+    std::vector<size_t> order;
+    order.reserve(size);
+    for (size_t i{0}; i < size; i++) {
+        if (keep[i]) {
+            order.push_back(i);
+        }
+    }
+    if (order.size() == size) {
+        return 0;
+    }
+    columns.permute(order);
+    return size - order.size();
+}
+
+size_t CurveReducer::reduce(Curve &curve) const {
+    if (tolerance_ <= 0.0) {
+        return 0;
+    }
+    curve.sortPoint();
+    PointColumns columns = curve.getPointColumns();
+    size_t removed = reduce(columns);
+    if (removed > 0) {
+        curve.assignPoints(std::move(columns));
+    }
+    return removed;
+}
+
+void CurveReducer::reduceLinerRun(PointColumns &columns, size_t first, size_t last, std::vector<bool> &keep) const {
+    const auto &keyFrames = columns.keyFrames_;
+    const auto &values = columns.data_;
+
+    // slopes of the dense polyline, one sided at the ends of the run
+    std::vector<double> tangents(last - first + 1);
+    for (size_t i = first; i <= last; i++) {
+        size_t prev = i > first ? i - 1 : i;
+        size_t next = i < last ? i + 1 : i;
+        tangents[i - first] = (values[next] - values[prev]) / static_cast<double>(keyFrames[next] - keyFrames[prev]);
+    }
+
+    size_t start = first;
+    while (start < last) {
+        // grow the segment exponentially, then narrow down on the longest one that still fits
+        size_t good = start + 1;
+        FitType goodType = FitType::LINER;
+        size_t bad = last + 1;
+        for (size_t step = 2; start + step <= last; step *= 2) {
+            FitType type = fit(columns, tangents, first, start, start + step);
+            if (type == FitType::NONE) {
+                bad = start + step;
+                break;
+            }
+            good = start + step;
+            goodType = type;
+        }
+        if (bad == last + 1 && good < last) {
+            FitType type = fit(columns, tangents, first, start, last);
+            if (type != FitType::NONE) {
+                good = last;
+                goodType = type;
+            } else {
+                bad = last;
+            }
+        }
+        while (bad - good > 1) {
+            size_t middle = good + (bad - good) / 2;
+            FitType type = fit(columns, tangents, first, start, middle);
+            if (type == FitType::NONE) {
+                bad = middle;
+            } else {
+                good = middle;
+                goodType = type;
+            }
+        }
+
+        for (size_t i = start + 1; i < good; i++) {
+            keep[i] = false;
+        }
+        if (goodType == FitType::BESIER) {
+            // handles at a third of the segment turn the hermite tangents into a bezier segment
+            double length = static_cast<double>(keyFrames[good] - keyFrames[start]);
+            columns.interPolationTypes_[start] = BESIER_SPLINE;
+            columns.rightKeyFrames_[start] = keyFrames[start] + length / 3.0;
+            columns.rightData_[start] = values[start] + tangents[start - first] * length / 3.0;
+            columns.leftKeyFrames_[good] = keyFrames[good] - length / 3.0;
+            columns.leftData_[good] = values[good] - tangents[good - first] * length / 3.0;
+        }
+        start = good;
+    }
+}
+
+CurveReducer::FitType CurveReducer::fit(const PointColumns &columns, const std::vector<double> &tangents, size_t runFirst, size_t first, size_t last) const {
+    const auto &keyFrames = columns.keyFrames_;
+    const auto &values = columns.data_;
+    double frame0 = keyFrames[first];
+    double value0 = values[first];
+    double value1 = values[last];
+    double length = keyFrames[last] - frame0;
+    double slope = (value1 - value0) / length;
+
+    // the dense curve is linear between its keys, so the keys are the worst case for a straight line
+    bool liner = true;
+    for (size_t i = first + 1; i < last && liner; i++) {
+        liner = std::abs(value0 + slope * (keyFrames[i] - frame0) - values[i]) <= tolerance_;
+    }
+    if (liner) {
+        return FitType::LINER;
+    }
+
+    // a cubic can bend away from the polyline between the keys, check the middle of every segment too
+    double tangent0 = tangents[first - runFirst];
+    double tangent1 = tangents[last - runFirst];
+    for (size_t i = first; i < last; i++) {
+        double t = (keyFrames[i] - frame0) / length;
+        if (i > first && std::abs(hermiteValue(value0, value1, tangent0, tangent1, length, t) - values[i]) > tolerance_) {
+            return FitType::NONE;
+        }
+        double middle = (keyFrames[i] + keyFrames[i + 1]) * 0.5;
+        t = (middle - frame0) / length;
+        if (std::abs(hermiteValue(value0, value1, tangent0, tangent1, length, t) - (values[i] + values[i + 1]) * 0.5) > tolerance_) {
+            return FitType::NONE;
+        }
+    }
+    return FitType::BESIER;
+}
+}
@@ -0,0 +1,161 @@
+#include "CurveData/CurveSampler.h"
+#include "CurveData/CurveEvaluator.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace raco::guiData {
+
+namespace {
+double sampleCurve(const CurveEvaluator *curve, double frame) {
+    double value{0.0};
+    if (curve && curve->evaluate(frame, value)) {
+        return value;
+    }
+    return std::numeric_limits<double>::quiet_NaN();
+}
+}
+
+CurveSampler::CurveSampler(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // the calling thread takes part in every run, so it counts as one of the threads
+    for (size_t i{1}; i < threadCount; i++) {
+        workers_.emplace_back(&CurveSampler::workerLoop, this);
+    }
+}
+
+CurveSampler::~CurveSampler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wakeCondition_.notify_all();
+    for (auto &worker : workers_) {
+        worker.join();
+    }
+}
+
+size_t CurveSampler::threadCount() const {
+    return workers_.size() + 1;
+}
+
+void CurveSampler::setParallelThreshold(size_t threshold) {
+    parallelThreshold_ = std::max<size_t>(threshold, 1);
+}
+
+void CurveSampler::sampleFrame(const std::vector<const CurveEvaluator *> &curves, double frame, std::vector<double> &values) {
+    size_t size = curves.size();
+    values.resize(size);
+
+    size_t chunks = 1;
+    if (!workers_.empty() && size >= parallelThreshold_) {
+        chunks = std::min(threadCount(), (size + parallelThreshold_ - 1) / parallelThreshold_);
+    }
+    if (chunks <= 1) {
+        for (size_t i{0}; i < size; i++) {
+            values[i] = sampleCurve(curves[i], frame);
+        }
+        return;
+    }
+
+    if (chunkValues_.size() < chunks) {
+        chunkValues_.resize(chunks);
+    }
+    run(chunks, [&](size_t chunk) {
+        size_t begin = size * chunk / chunks;
+        size_t end = size * (chunk + 1) / chunks;
+        std::vector<double> &buffer = chunkValues_[chunk];
+        buffer.clear();
+        for (size_t i = begin; i < end; i++) {
+            buffer.push_back(sampleCurve(curves[i], frame));
+        }
+    });
+
+    auto out = values.begin();
+    for (size_t chunk{0}; chunk < chunks; chunk++) {
+        out = std::copy(chunkValues_[chunk].begin(), chunkValues_[chunk].end(), out);
+    }
+}
+
+void CurveSampler::sampleRange(const std::vector<const CurveEvaluator *> &curves, int firstFrame, int lastFrame, std::vector<double> &values) {
+    values.clear();
+    if (lastFrame < firstFrame || curves.empty()) {
+        return;
+    }
+    size_t size = curves.size();
+    size_t frames = static_cast<size_t>(static_cast<int64_t>(lastFrame) - firstFrame) + 1;
+    values.resize(frames * size);
+
+    // every frame owns one row of the output, chunks of frames never share a row
+    size_t chunks = 1;
+    if (!workers_.empty() && frames * size >= parallelThreshold_) {
+        chunks = std::min(frames, threadCount() * 4);
+    }
+    run(chunks, [&](size_t chunk) {
+        size_t begin = frames * chunk / chunks;
+        size_t end = frames * (chunk + 1) / chunks;
+        for (size_t frame = begin; frame < end; frame++) {
+            double *row = values.data() + frame * size;
+            double keyFrame = static_cast<double>(firstFrame) + static_cast<double>(frame);
+            for (size_t i{0}; i < size; i++) {
+                row[i] = sampleCurve(curves[i], keyFrame);
+            }
+        }
+    });
+}
+
+void CurveSampler::run(size_t taskCount, const std::function<void(size_t)> &task) {
+    if (workers_.empty() || taskCount <= 1) {
+        for (size_t i{0}; i < taskCount; i++) {
+            task(i);
+        }
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    task_ = &task;
+    taskCount_ = taskCount;
+    nextTask_ = 0;
+    finishedTasks_ = 0;
+    ++generation_;
+    wakeCondition_.notify_all();
+
+    runTasks(lock);
+    doneCondition_.wait(lock, [this]() {
+        return finishedTasks_ == taskCount_;
+    });
+    task_ = nullptr;
+    taskCount_ = 0;
+}
+
+void CurveSampler::runTasks(std::unique_lock<std::mutex> &lock) {
+    while (task_ && nextTask_ < taskCount_) {
+        const std::function<void(size_t)> *task = task_;
+        size_t index = nextTask_++;
+        lock.unlock();
+        (*task)(index);
+        lock.lock();
+        if (++finishedTasks_ == taskCount_) {
+            doneCondition_.notify_all();
+        }
+    }
+}
+
+void CurveSampler::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    unsigned long long generation = generation_;
+    while (true) {
+        wakeCondition_.wait(lock, [this, generation]() {
+            return stop_ || generation_ != generation;
+        });
+        if (stop_) {
+            return;
+        }
+        generation = generation_;
+        runTasks(lock);
+    }
+}
+}
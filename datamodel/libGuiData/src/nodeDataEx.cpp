@@ -1,24 +1,73 @@
 #include "NodeData/nodeDataEx.h"
+#include "NodeData/nodeManager.h"
+
+#include <atomic>
 
 namespace raco::guiData {
 
+namespace {
+std::atomic<uint64_t> curveBindingGeneration{0};
+}
+
 CurveBinding::CurveBinding() {
+    touch();
+}
+
+CurveBinding::CurveBinding(const CurveBinding &other) : bindingMap_(other.bindingMap_) {
+    touch();
+}
+
+CurveBinding::CurveBinding(CurveBinding &&other) : bindingMap_(std::move(other.bindingMap_)) {
+    touch();
+}
+
+CurveBinding &CurveBinding::operator=(const CurveBinding &other) {
+    bindingMap_ = other.bindingMap_;
+    touch();
+    return *this;
+}
+
+CurveBinding &CurveBinding::operator=(CurveBinding &&other) {
+    bindingMap_ = std::move(other.bindingMap_);
+    touch();
+    return *this;
 }
 
 CurveBinding::~CurveBinding() {
+    touch();
     bindingMap_.clear();
 }
 
-std::map < std::string, std::map<std::string, std::string>> &CurveBinding::bindingMap() {
+const std::map<std::string, std::map<std::string, std::string>> &CurveBinding::bindingMap() const {
     return bindingMap_;
 }
 
+uint64_t CurveBinding::generation() {
+    return curveBindingGeneration.load(std::memory_order_relaxed);
+}
+
+void CurveBinding::touch() {
+    // the index knows the bindings in the node tree by address, it has to be rebuilt
+    curveBindingGeneration.fetch_add(1, std::memory_order_relaxed);
+}
+
+void CurveBinding::bindingInserted(const std::string &sampleProp, const std::string &property, const std::string &curve) {
+    NodeDataManager::GetInstance().curveBindingInserted(this, sampleProp, property, curve);
+}
+
+void CurveBinding::bindingDeleted(const std::string &sampleProp, const std::string &property, const std::string &curve) {
+    NodeDataManager::GetInstance().curveBindingDeleted(this, sampleProp, property, curve);
+}
+
 bool CurveBinding::insertAnimation(std::string &sampleProp, std::map<std::string, std::string> &bindingData) {
     auto ret = bindingMap_.emplace(sampleProp, bindingData);
     if (ret.second == false) {
         std::cout << "element [" << sampleProp << "] already existed";
         return false;
     }
+    for (const auto &prop : bindingData) {
+        bindingInserted(sampleProp, prop.first, prop.second);
+    }
     return true ;
 }
 
@@ -28,6 +77,9 @@ bool CurveBinding::deleteAnimation(std::string &sampleProp) {
         std::cout << "can't find [" << sampleProp << "] !\n";
         return false;
     }
+    for (const auto &prop : iter->second) {
+        bindingDeleted(sampleProp, prop.first, prop.second);
+    }
     bindingMap_.erase(iter);
     return true;
 }
@@ -38,9 +90,13 @@ bool CurveBinding::insertBindingDataItem(const std::string &sampleProp, const st
         std::map<std::string, std::string> bindingDataMap;
         bindingDataMap.emplace(property, curve);
         bindingMap_.emplace(sampleProp, bindingDataMap);
+        bindingInserted(sampleProp, property, curve);
 		return true;
     }
-    iter->second.emplace(property, curve);
+    // a property already bound keeps its curve
+    if (iter->second.emplace(property, curve).second) {
+        bindingInserted(sampleProp, property, curve);
+    }
     return true;
 }
 
@@ -53,6 +109,7 @@ bool CurveBinding::deleteBindingDataItem(const std::string& sampleProp, const st
     if (propIt == iter->second.end()) {
         return false;
     }
+    bindingDeleted(sampleProp, property, propIt->second);
     iter->second.erase(propIt);
     return true;
 }
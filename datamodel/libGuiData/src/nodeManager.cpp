@@ -1,5 +1,7 @@
 #include "NodeData/nodeManager.h"
 
+#include <algorithm>
+
 
 namespace raco::guiData {
 NodeDataManager& NodeDataManager::GetInstance() {
@@ -139,13 +141,11 @@ void NodeDataManager::preOrderReverse(NodeData* pNode,  std::function<void(NodeD
 }
 
 void NodeDataManager::delCurveBindingByName(std::string curveName) {
-    if (!root_.childMapRef().size())
-        return;
-    std::cout << " preOrderReverse: ";
-    delOneCurveBindingByName(&root_, curveName);
-    if (activeNode_)
-        std::cout << "   ->" << activeNode_->objectID();
-    std::cout << std::endl;
+    // deleting invalidates the index, work on a copy
+    std::vector<CurveBindingItem> bindings = getCurveBindings(curveName);
+    for (const auto& item : bindings) {
+        item.node_->NodeExtendRef().curveBindingRef().deleteBindingDataItem(item.sampleProperty_, item.property_, curveName);
+    }
 }
 
 void NodeDataManager::delOneCurveBindingByName(NodeData* pNode, std::string curveName) {
@@ -164,4 +164,67 @@ void NodeDataManager::delOneCurveBindingByName(NodeData* pNode, std::string curv
         delOneCurveBindingByName(&(it->second), curveName);
     }
 }
+
+const std::vector<CurveBindingItem>& NodeDataManager::getCurveBindings(const std::string& curveName) {
+    if (!isCurveBindingIndexValid()) {
+        curveBindingIndex_.clear();
+        curveBindingOwners_.clear();
+        indexCurveBindings(&root_);
+        curveBindingIndexGeneration_ = CurveBinding::generation();
+    }
+    static const std::vector<CurveBindingItem> noBindings;
+    auto it = curveBindingIndex_.find(curveName);
+    return it != curveBindingIndex_.end() ? it->second : noBindings;
+}
+
+bool NodeDataManager::isCurveBindingIndexValid() const {
+    return curveBindingIndexGeneration_ == CurveBinding::generation();
+}
+
+void NodeDataManager::indexCurveBindings(NodeData* pNode) {
+    const CurveBinding& binding = pNode->NodeExtendRef().curveBindingRef();
+    curveBindingOwners_[&binding] = pNode;
+    for (const auto& an : binding.bindingMap()) {
+        for (const auto& prop : an.second) {
+            curveBindingIndex_[prop.second].push_back(CurveBindingItem{pNode, an.first, prop.first});
+        }
+    }
+    for (auto it = pNode->childMapRef().begin(); it != pNode->childMapRef().end(); ++it) {
+        indexCurveBindings(&(it->second));
+    }
+}
+
+void NodeDataManager::curveBindingInserted(const CurveBinding* binding, const std::string& sampleProp, const std::string& property, const std::string& curve) {
+    if (!isCurveBindingIndexValid()) {
+        return;
+    }
+    auto owner = curveBindingOwners_.find(binding);
+    if (owner == curveBindingOwners_.end()) {
+        return;
+    }
+    // keep the bindings of one node next to each other
+    auto& items = curveBindingIndex_[curve];
+    auto last = std::find_if(items.rbegin(), items.rend(), [&owner](const CurveBindingItem& item) {
+        return item.node_ == owner->second;
+    });
+    items.insert(last != items.rend() ? last.base() : items.end(), CurveBindingItem{owner->second, sampleProp, property});
+}
+
+void NodeDataManager::curveBindingDeleted(const CurveBinding* binding, const std::string& sampleProp, const std::string& property, const std::string& curve) {
+    if (!isCurveBindingIndexValid()) {
+        return;
+    }
+    auto owner = curveBindingOwners_.find(binding);
+    auto itemsIt = curveBindingIndex_.find(curve);
+    if (owner == curveBindingOwners_.end() || itemsIt == curveBindingIndex_.end()) {
+        return;
+    }
+    auto& items = itemsIt->second;
+    items.erase(std::remove_if(items.begin(), items.end(), [&](const CurveBindingItem& item) {
+        return item.node_ == owner->second && item.sampleProperty_ == sampleProp && item.property_ == property;
+    }), items.end());
+    if (items.empty()) {
+        curveBindingIndex_.erase(itemsIt);
+    }
+}
 }
@@ -0,0 +1,131 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <gtest/gtest.h>
+
+#include "CurveData/CurveData.h"
+#include "CurveData/CurveFrameCache.h"
+
+using namespace raco::guiData;
+
+class CurveFrameCacheTest : public testing::Test {
+protected:
+    void SetUp() override {
+        CurveFrameCache::resetStatistics();
+    }
+
+    void TearDown() override {
+        CurveFrameCache::setMemoryBudget(64 * 1024 * 1024);
+    }
+
+    // bytes one cached frame occupies
+    static constexpr size_t frameBytes = sizeof(double) + sizeof(uint8_t);
+};
+
+TEST_F(CurveFrameCacheTest, pointEdit_invalidatesOnlyNeighbouringSegments) {
+    Curve curve;
+    for (int keyFrame : {0, 10, 20, 30, 40}) {
+        PointData point;
+        point.keyFrame_ = keyFrame;
+        point.data_ = keyFrame;
+        curve.insertPoint(point);
+    }
+    double value{0.0};
+    for (int frame{0}; frame <= 40; frame++) {
+        ASSERT_TRUE(curve.getFrameValue(frame, value));
+    }
+
+    curve.getPoint(20)->setDataValue(100.0);
+
+    for (int frame{0}; frame <= 40; frame++) {
+        bool cached = curve.getFrameCache().lookup(frame, value);
+        if (frame >= 10 && frame <= 30) {
+            EXPECT_FALSE(cached) << "frame " << frame;
+        } else {
+            EXPECT_TRUE(cached) << "frame " << frame;
+            EXPECT_EQ(static_cast<double>(frame), value) << "frame " << frame;
+        }
+    }
+    ASSERT_TRUE(curve.getFrameValue(20, value));
+    EXPECT_EQ(100.0, value);
+    ASSERT_TRUE(curve.getFrameValue(15, value));
+    EXPECT_EQ(55.0, value);
+}
+
+TEST_F(CurveFrameCacheTest, firstKeyEdit_keepsFramesAfterNextKey) {
+    Curve curve;
+    for (int keyFrame : {0, 10, 20}) {
+        PointData point;
+        point.keyFrame_ = keyFrame;
+        point.data_ = keyFrame;
+        curve.insertPoint(point);
+    }
+    double value{0.0};
+    for (int frame{-5}; frame <= 25; frame++) {
+        ASSERT_TRUE(curve.getFrameValue(frame, value));
+    }
+
+    curve.getPoint(0)->setDataValue(-10.0);
+
+    EXPECT_FALSE(curve.getFrameCache().lookup(-5, value));
+    EXPECT_FALSE(curve.getFrameCache().lookup(10, value));
+    EXPECT_TRUE(curve.getFrameCache().lookup(11, value));
+    EXPECT_TRUE(curve.getFrameCache().lookup(25, value));
+}
+
+TEST_F(CurveFrameCacheTest, budget_evictsLeastRecentlyUsedCache) {
+    CurveFrameCache::setMemoryBudget(2 * frameBytes + 1);
+    CurveFrameCache first;
+    CurveFrameCache second;
+    CurveFrameCache third;
+    double value{0.0};
+
+    first.store(0, 1.0);
+    second.store(0, 2.0);
+    EXPECT_EQ(2 * frameBytes, CurveFrameCache::statistics().memoryUsage_);
+
+    // first is the oldest one and makes room for third
+    third.store(0, 3.0);
+    EXPECT_EQ(0u, first.memoryUsage());
+    EXPECT_FALSE(first.lookup(0, value));
+    ASSERT_TRUE(second.lookup(0, value));
+    EXPECT_EQ(2.0, value);
+
+    // second was used last, so third is evicted now
+    first.store(0, 1.0);
+    EXPECT_EQ(0u, third.memoryUsage());
+    EXPECT_TRUE(first.lookup(0, value));
+    EXPECT_TRUE(second.lookup(0, value));
+
+    CurveFrameCache::Statistics statistics = CurveFrameCache::statistics();
+    EXPECT_EQ(2u, statistics.evictions_);
+    EXPECT_LE(statistics.memoryUsage_, statistics.memoryBudget_);
+}
+
+TEST_F(CurveFrameCacheTest, budget_tooSmallForOneFrame) {
+    CurveFrameCache::setMemoryBudget(frameBytes - 1);
+    CurveFrameCache cache;
+    double value{0.0};
+
+    cache.store(5, 1.0);
+    EXPECT_FALSE(cache.lookup(5, value));
+    EXPECT_EQ(0u, cache.memoryUsage());
+}
+
+TEST_F(CurveFrameCacheTest, clear_returnsMemory) {
+    size_t before = CurveFrameCache::statistics().memoryUsage_;
+    {
+        CurveFrameCache cache;
+        for (int frame{0}; frame < 100; frame++) {
+            cache.store(frame, frame);
+        }
+        EXPECT_EQ(before + cache.memoryUsage(), CurveFrameCache::statistics().memoryUsage_);
+    }
+    EXPECT_EQ(before, CurveFrameCache::statistics().memoryUsage_);
+}
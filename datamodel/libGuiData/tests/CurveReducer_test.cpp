@@ -0,0 +1,99 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <gtest/gtest.h>
+
+#include "CurveData/CurveData.h"
+#include "CurveData/CurveReducer.h"
+
+#include <cmath>
+#include <functional>
+
+using namespace raco::guiData;
+
+class CurveReducerTest : public testing::Test {
+protected:
+    // linear keys at every frame in [firstFrame, lastFrame], like a baked glTF channel
+    PointColumns denseKeys(int firstFrame, int lastFrame, const std::function<double(int)>& value) {
+        PointColumns columns;
+        for (int frame = firstFrame; frame <= lastFrame; frame++) {
+            PointData point;
+            point.keyFrame_ = frame;
+            point.interPolationType_ = LINER;
+            point.data_ = value(frame);
+            columns.append(point);
+        }
+        return columns;
+    }
+};
+
+TEST_F(CurveReducerTest, denseLinearKeys_reduceToEndpoints) {
+    PointColumns columns = denseKeys(0, 100, [](int frame) { return 2.0 * frame + 1.0; });
+    CurveReducer reducer(0.0001);
+
+    EXPECT_EQ(99u, reducer.reduce(columns));
+    ASSERT_EQ(2u, columns.size());
+    EXPECT_EQ(0, columns.keyFrames_[0]);
+    EXPECT_EQ(100, columns.keyFrames_[1]);
+    EXPECT_EQ(1.0, columns.data_[0]);
+    EXPECT_EQ(201.0, columns.data_[1]);
+    EXPECT_EQ(LINER, columns.interPolationTypes_[0]);
+}
+
+TEST_F(CurveReducerTest, reducedCurve_staysWithinTolerance) {
+    auto value = [](int frame) { return std::sin(frame * 0.05) * 10.0 + (frame > 120 ? 3.0 : 0.0); };
+    const double tolerance = 0.01;
+    PointColumns columns = denseKeys(0, 240, value);
+    CurveReducer reducer(tolerance);
+
+    size_t removed = reducer.reduce(columns);
+    EXPECT_GT(removed, 0u);
+    EXPECT_EQ(241u, columns.size() + removed);
+
+    Curve curve;
+    curve.assignPoints(std::move(columns));
+    for (int frame{0}; frame <= 240; frame++) {
+        double reduced{0.0};
+        ASSERT_TRUE(curve.evaluate(frame, reduced));
+        EXPECT_NEAR(value(frame), reduced, tolerance + 1e-9) << "frame " << frame;
+        if (frame < 240) {
+            // the original curve is linear between its keys
+            ASSERT_TRUE(curve.evaluate(frame + 0.5, reduced));
+            EXPECT_NEAR((value(frame) + value(frame + 1)) * 0.5, reduced, tolerance + 1e-9) << "frame " << frame + 0.5;
+        }
+    }
+}
+
+TEST_F(CurveReducerTest, zeroTolerance_keepsEveryKey) {
+    PointColumns columns = denseKeys(0, 50, [](int) { return 3.0; });
+    PointColumns original = columns;
+    CurveReducer reducer(0.0);
+
+    EXPECT_EQ(0u, reducer.reduce(columns));
+    EXPECT_EQ(original.keyFrames_, columns.keyFrames_);
+    EXPECT_EQ(original.interPolationTypes_, columns.interPolationTypes_);
+    EXPECT_EQ(original.data_, columns.data_);
+
+    Curve curve;
+    curve.assignPoints(std::move(columns));
+    uint64_t revision = curve.getRevision();
+    EXPECT_EQ(0u, reducer.reduce(curve));
+    EXPECT_EQ(51u, curve.getPointSize());
+    EXPECT_EQ(revision, curve.getRevision());
+}
+
+TEST_F(CurveReducerTest, repeatedStepKeys_areDropped) {
+    PointColumns columns = denseKeys(0, 9, [](int frame) { return frame < 5 ? 1.0 : 2.0; });
+    std::fill(columns.interPolationTypes_.begin(), columns.interPolationTypes_.end(), STEP);
+    CurveReducer reducer(0.0001);
+
+    reducer.reduce(columns);
+    std::vector<int> expected{0, 5, 9};
+    EXPECT_EQ(expected, columns.keyFrames_);
+}
@@ -0,0 +1,120 @@
+/*
+ * SPDX-License-Identifier: MPL-2.0
+ *
+ * This file is part of Ramses Composer
+ * (see https://github.com/GENIVI/ramses-composer).
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+#include <gtest/gtest.h>
+
+#include "CurveData/CurveData.h"
+#include "CurveData/CurveSampler.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace raco::guiData;
+
+class CurveSamplerTest : public testing::Test {
+protected:
+    void SetUp() override {
+        // enough curves to be split over the workers, every interpolation type and one curve without keys
+        for (size_t index{0}; index < 200; index++) {
+            auto curve = std::make_unique<Curve>();
+            if (index % 50 != 49) {
+                for (int key{0}; key < 8; key++) {
+                    PointData point;
+                    point.keyFrame_ = key * 10 + static_cast<int>(index % 7);
+                    point.interPolationType_ = static_cast<EInterPolationType>((index + key) % 4);
+                    point.data_ = std::sin(static_cast<double>(index + key));
+                    point.leftKeyFrame_ = point.keyFrame_ - 3.0;
+                    point.leftData_ = point.data_ - 0.5;
+                    point.rightKeyFrame_ = point.keyFrame_ + 3.0;
+                    point.rightData_ = point.data_ + 0.5;
+                    curve->insertPoint(point);
+                }
+            }
+            evaluators_.push_back(&curve->getEvaluator());
+            curves_.push_back(std::move(curve));
+        }
+    }
+
+    void expectSameValues(const std::vector<double>& expected, const std::vector<double>& actual) {
+        ASSERT_EQ(expected.size(), actual.size());
+        for (size_t index{0}; index < expected.size(); index++) {
+            if (std::isnan(expected[index])) {
+                EXPECT_TRUE(std::isnan(actual[index])) << "index " << index;
+            } else {
+                EXPECT_EQ(expected[index], actual[index]) << "index " << index;
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<Curve>> curves_;
+    std::vector<const CurveEvaluator*> evaluators_;
+};
+
+TEST_F(CurveSamplerTest, sampleFrame_parallelMatchesSerial) {
+    CurveSampler serial(1);
+    CurveSampler parallel(4);
+    parallel.setParallelThreshold(16);
+    ASSERT_EQ(1u, serial.threadCount());
+    ASSERT_EQ(4u, parallel.threadCount());
+
+    std::vector<double> expected;
+    std::vector<double> actual;
+    for (double frame : {-5.0, 0.0, 12.5, 37.0, 80.0}) {
+        serial.sampleFrame(evaluators_, frame, expected);
+        parallel.sampleFrame(evaluators_, frame, actual);
+        expectSameValues(expected, actual);
+    }
+    EXPECT_TRUE(std::isnan(actual[49]));
+}
+
+TEST_F(CurveSamplerTest, sampleRange_parallelMatchesSerial) {
+    CurveSampler serial(1);
+    CurveSampler parallel(4);
+
+    std::vector<double> expected;
+    std::vector<double> actual;
+    serial.sampleRange(evaluators_, -10, 90, expected);
+    parallel.sampleRange(evaluators_, -10, 90, actual);
+    ASSERT_EQ(101u * evaluators_.size(), actual.size());
+    expectSameValues(expected, actual);
+}
+
+TEST_F(CurveSamplerTest, sampleRange_rowsMatchSampleFrame) {
+    CurveSampler sampler(4);
+    sampler.setParallelThreshold(16);
+
+    std::vector<double> range;
+    sampler.sampleRange(evaluators_, 20, 30, range);
+    std::vector<double> frame;
+    std::vector<double> row;
+    for (int keyFrame{20}; keyFrame <= 30; keyFrame++) {
+        sampler.sampleFrame(evaluators_, keyFrame, frame);
+        auto begin = range.begin() + (keyFrame - 20) * evaluators_.size();
+        row.assign(begin, begin + evaluators_.size());
+        expectSameValues(frame, row);
+    }
+}
+
+TEST_F(CurveSamplerTest, sampleRange_leavesFrameCachesEmpty) {
+    CurveSampler sampler(4);
+    std::vector<double> values;
+    sampler.sampleRange(evaluators_, 0, 50, values);
+
+    for (const auto& curve : curves_) {
+        EXPECT_EQ(0u, curve->getFrameCache().memoryUsage());
+    }
+}
+
+TEST_F(CurveSamplerTest, sampleRange_emptyRange) {
+    CurveSampler sampler(4);
+    std::vector<double> values{1.0, 2.0};
+    sampler.sampleRange(evaluators_, 10, 9, values);
+    EXPECT_TRUE(values.empty());
+}
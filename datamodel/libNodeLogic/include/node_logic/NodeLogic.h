@@ -3,11 +3,14 @@
 
 #include <QObject>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 #include "core/CommandInterface.h"
 #include "property_browser/PropertyBrowserItem.h"
 #include "NodeData/nodeManager.h"
 #include "CurveData/CurveManager.h"
+#include "CurveData/CurveSampler.h"
 #include "signal/SignalProxy.h"
 #include <QDebug>
 #include <QMutex>
@@ -39,14 +42,23 @@ public:
     bool getHandleFromObjectID(const std::string &objectID, raco::core::ValueHandle &handle);
     bool hasHandleFromObjectID(const std::string &objectID);
 
-    void preOrderReverse(NodeData *pNode, const int &keyFrame, const std::string &sampleProperty);
-    void setPropertyByCurveBinding(const std::string &objecID, const std::map<std::string, std::string> &map, const int &keyFrame);
-    bool getKeyValue(std::string curve, EInterPolationType type, int keyFrame, double& value);
+    // collect the curve bindings of pNode and its children into the sample plan
+    void preOrderReverse(NodeData *pNode, const std::string &sampleProperty);
+    void collectCurveBinding(const std::string &objecID, const std::map<std::string, std::string> &map);
+    // sample the bindings of the active animation for every frame in [firstFrame, lastFrame] in parallel,
+    // values[(frame - firstFrame) * handles.size() + i] belongs to handles[i], NaN where the curve has no keys.
+    // Both buffers are owned by the caller, the curve frame caches are left untouched.
+    void sampleKeyFrameRange(int firstFrame, int lastFrame, std::vector<core::ValueHandle> &handles, std::vector<double> &values);
+    // resolve property of the object by name, later calls return the cached handle as long as it still refers to the property
+    bool getPropertyHandle(const std::string &objectID, const core::ValueHandle &objectHandle, const std::string &property, core::ValueHandle &handle);
+    bool getKeyValue(const std::string &curve, int keyFrame, double& value);
     void delNodeBindingByCurveName(std::string curveName);
 
 public Q_SLOTS:
     void slotUpdateActiveAnimation(QString animation);
     void slotUpdateKeyFrame(int keyFrame);
+    // re-apply only the properties bound to curve in the active animation
+    void slotUpdateCurveKeyFrame(const std::string &curve, int keyFrame);
     void slotResetNodeData();
     void slotUpdateMeshNodeTranslation(const std::string &objectID, const double &transX, const double &transY, const double &transZ);
     void slotUpdateMeshNodeRotation(const std::string &objectID, const double &rotatX, const double &rotatY, const double &rotatZ);
@@ -57,8 +69,35 @@ signals:
 	void sig_initCurveBindingWidget__NodePro();
 
 private:
+    struct CachedPropertyHandle {
+        core::ValueHandle handle_;
+        std::string propertyPath_;
+    };
+    // handles are index paths: undo/redo or rebuilt property tables can move them to another property or past the end
+    bool isCachedHandleValid(const CachedPropertyHandle &cached, const core::ValueHandle &objectHandle) const;
+    void setValues(const std::vector<std::pair<core::ValueHandle, double>> &values);
+    // curve bound under curveName, resolved by name only when the cached handle went stale; needs handleMapMutex_
+    Curve *getBoundCurve(const std::string &curveName);
+
     QMutex handleMapMutex_;
 	std::map<std::string, core::ValueHandle> nodeObjectIDHandleReMap_;
+    // <objectID, property> -> resolved property handle and its property path
+    std::map<std::pair<std::string, std::string>, CachedPropertyHandle> propertyHandleReMap_;
+    // curve name -> registry handle, renaming or removing the curve makes the handle stale
+    std::unordered_map<std::string, CurveHandle> curveHandleReMap_;
+    // sample plan of the active animation: one property handle and compiled curve per binding
+    std::vector<core::ValueHandle> sampleHandles_;
+    std::vector<Curve *> sampleCurves_;
+    std::vector<const CurveEvaluator *> sampleEvaluators_;
+    std::vector<std::string> sampleNodes_;
+    // samples of the current frame, written with one setValues call
+    std::vector<double> sampleBuffer_;
+    // bindings whose frame isn't cached yet
+    std::vector<size_t> missIndices_;
+    std::vector<const CurveEvaluator *> missEvaluators_;
+    std::vector<double> missValues_;
+    std::vector<std::pair<core::ValueHandle, double>> sampleValues_;
+    CurveSampler curveSampler_;
 	raco::core::CommandInterface *commandInterface_;
     QString curAnimation_;
 };
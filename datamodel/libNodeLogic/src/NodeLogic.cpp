@@ -1,13 +1,14 @@
 #include "node_logic/NodeLogic.h"
 #include "PropertyData/PropertyType.h"
-#include "time_axis/TimeAxisCommon.h"
-#include "VisualCurveData/VisualCurvePosManager.h"
+#include "log_system/log.h"
 #include <QDebug>
+#include <cmath>
 
 namespace raco::node_logic {
 NodeLogic::NodeLogic(raco::core::CommandInterface *commandInterface, QObject *parent)
     : QObject{parent}, commandInterface_{commandInterface} {
     connect(&signalProxy::GetInstance(), &signalProxy::sigUpdateKeyFram_From_AnimationLogic, this, &NodeLogic::slotUpdateKeyFrame);
+    connect(&signalProxy::GetInstance(), &signalProxy::sigUpdateCurveKeyFrame_From_CurveUI, this, &NodeLogic::slotUpdateCurveKeyFrame);
     connect(&signalProxy::GetInstance(), &signalProxy::sigUpdateActiveAnimation_From_AnimationLogic, this, &NodeLogic::slotUpdateActiveAnimation);
     connect(&signalProxy::GetInstance(), &signalProxy::sigResetAllData_From_MainWindow, this, &NodeLogic::slotResetNodeData,Qt::DirectConnection);
     connect(&signalProxy::GetInstance(), &signalProxy::sigUpdateMeshNodeTransProperty, this, &NodeLogic::slotUpdateMeshNodeTranslation);
@@ -90,6 +91,7 @@ void NodeLogic::setNodeNameHandleReMap(std::map<std::string, core::ValueHandle>
     QMutexLocker locker(&handleMapMutex_);
 	nodeObjectIDHandleReMap_.clear();
     nodeObjectIDHandleReMap_ = std::move(nodeNameHandleReMap);
+    propertyHandleReMap_.clear();
 }
 
 bool NodeLogic::getHandleFromObjectID(const std::string &objectID, core::ValueHandle &handle) {
@@ -156,168 +158,229 @@ void NodeLogic::initBasicProperty(raco::core::ValueHandle valueHandle, NodeData
 }
 
 void NodeLogic::slotUpdateActiveAnimation(QString animation) {
+    if (animation != curAnimation_) {
+        CurveFrameCache::Statistics statistics = CurveFrameCache::statistics();
+        if (statistics.hits_ + statistics.misses_ > 0) {
+            LOG_DEBUG(raco::log_system::COMMON, "Curve frame cache of {}: {} hits, {} misses, {} evictions, {} of {} bytes", curAnimation_.toStdString(),
+                statistics.hits_, statistics.misses_, statistics.evictions_, statistics.memoryUsage_, statistics.memoryBudget_);
+        }
+        CurveFrameCache::resetStatistics();
+    }
     curAnimation_ = animation;
 }
 
-void NodeLogic::preOrderReverse(NodeData *pNode, const int &keyFrame, const std::string &sampleProperty) {
+void NodeLogic::preOrderReverse(NodeData *pNode, const std::string &sampleProperty) {
     if (!pNode)
         return;
 
     if (pNode->getBindingySize() != 0) {
-        std::map<std::string, std::string> bindingDataMap;
-        pNode->NodeExtendRef().curveBindingRef().getPropCurve(sampleProperty, bindingDataMap);
-
-        // TODO SETPROPERTY
-        setPropertyByCurveBinding(pNode->objectID(), bindingDataMap, keyFrame);
-        raco::signal::signalProxy::GetInstance().sigUpdateMeshModelMatrix(pNode->objectID());
+        auto &bindingMap = pNode->NodeExtendRef().curveBindingRef().bindingMap();
+        auto bindingIt = bindingMap.find(sampleProperty);
+        if (bindingIt != bindingMap.end() && !bindingIt->second.empty()) {
+            collectCurveBinding(pNode->objectID(), bindingIt->second);
+            sampleNodes_.push_back(pNode->objectID());
+        }
     }
     for (auto it = pNode->childMapRef().begin(); it != pNode->childMapRef().end(); ++it) {
-        preOrderReverse(&(it->second), keyFrame, sampleProperty);
+        preOrderReverse(&(it->second), sampleProperty);
     }
 }
 
-void NodeLogic::setPropertyByCurveBinding(const std::string &objecID, const std::map<std::string, std::string> &map, const int &keyFrame) {
+void NodeLogic::collectCurveBinding(const std::string &objecID, const std::map<std::string, std::string> &map) {
     QMutexLocker locker(&handleMapMutex_);
     auto iter = nodeObjectIDHandleReMap_.find(objecID);
     if (iter != nodeObjectIDHandleReMap_.end()) {
         for (const auto &bindingIt : map) {
-            if (CurveManager::GetInstance().getCurve(bindingIt.second)) {
-                double value{0};
-                EInterPolationType type;
-                if (CurveManager::GetInstance().getPointType(bindingIt.second, keyFrame, type)) {
-                    if (getKeyValue(bindingIt.second, type, keyFrame, value)) {
-                        setProperty(iter->second, bindingIt.first, value);
-                    }
-                }
+            core::ValueHandle handle;
+            Curve *curve = getBoundCurve(bindingIt.second);
+            if (curve && getPropertyHandle(objecID, iter->second, bindingIt.first, handle)) {
+                sampleHandles_.push_back(handle);
+                sampleCurves_.push_back(curve);
+                sampleEvaluators_.push_back(&curve->getEvaluator());
             }
         }
     }
 }
 
+bool NodeLogic::getPropertyHandle(const std::string &objectID, const core::ValueHandle &objectHandle, const std::string &property, core::ValueHandle &handle) {
+    if (!objectHandle || !commandInterface_ || !commandInterface_->project()->isInstance(objectHandle.rootObject())) {
+        return false;
+    }
+    auto key = std::make_pair(objectID, property);
+    auto it = propertyHandleReMap_.find(key);
+    if (it != propertyHandleReMap_.end() && isCachedHandleValid(it->second, objectHandle)) {
+        handle = it->second.handle_;
+        return true;
+    }
+
+    core::ValueHandle tempHandle = objectHandle;
+    if (!getValueHanlde(property, tempHandle) || tempHandle.type() != data_storage::PrimitiveType::Double) {
+        // not cached, the property may appear with the next change of the object
+        if (it != propertyHandleReMap_.end()) {
+            propertyHandleReMap_.erase(it);
+        }
+        return false;
+    }
+    propertyHandleReMap_[key] = {tempHandle, tempHandle.getPropertyPath()};
+    handle = tempHandle;
+    return true;
+}
+
+bool NodeLogic::isCachedHandleValid(const CachedPropertyHandle &cached, const core::ValueHandle &objectHandle) const {
+    const core::ValueHandle &handle = cached.handle_;
+    // operator bool checks the index path against the current property tables
+    return handle.rootObject() == objectHandle.rootObject() && handle
+        && handle.type() == data_storage::PrimitiveType::Double
+        && handle.getPropertyPath() == cached.propertyPath_;
+}
+
+void NodeLogic::setValues(const std::vector<std::pair<core::ValueHandle, double>> &values) {
+    if (!commandInterface_ || values.empty()) {
+        return;
+    }
+    // called from slots, errors must not propagate into the Qt event loop
+    try {
+        commandInterface_->setValues(values, false);
+    } catch (const std::exception &e) {
+        qWarning() << "NodeLogic: setting animated properties failed:" << e.what();
+        QMutexLocker locker(&handleMapMutex_);
+        propertyHandleReMap_.clear();
+    }
+}
+
+Curve *NodeLogic::getBoundCurve(const std::string &curveName) {
+    CurveManager &curveManager = CurveManager::GetInstance();
+    auto it = curveHandleReMap_.find(curveName);
+    if (it != curveHandleReMap_.end()) {
+        if (Curve *curve = curveManager.getCurve(it->second)) {
+            return curve;
+        }
+    }
+
+    CurveHandle handle = curveManager.getCurveHandle(curveName);
+    if (!handle.isValid()) {
+        // not cached, a curve with this name may be added later
+        if (it != curveHandleReMap_.end()) {
+            curveHandleReMap_.erase(it);
+        }
+        return nullptr;
+    }
+    curveHandleReMap_[curveName] = handle;
+    return curveManager.getCurve(handle);
+}
+
 void NodeLogic::delNodeBindingByCurveName(std::string curveName) {
 	NodeDataManager::GetInstance().delCurveBindingByName(curveName);
 	Q_EMIT sig_initCurveBindingWidget__NodePro();
 }
 
-bool NodeLogic::getKeyValue(std::string curve, EInterPolationType type, int keyFrame, double &value) {
-    int curX = VisualCurvePosManager::GetInstance().getCurX();
-    int curY = VisualCurvePosManager::GetInstance().getCurY();
-    double eachFrameWidth = VisualCurvePosManager::GetInstance().getEachFrameWidth();
-    double eachValueWidth = VisualCurvePosManager::GetInstance().getEachValueWidth();
+bool NodeLogic::getKeyValue(const std::string &curve, int keyFrame, double &value) {
+    Curve *curveData{nullptr};
+    {
+        QMutexLocker locker(&handleMapMutex_);
+        curveData = getBoundCurve(curve);
+    }
+    if (!curveData) {
+        return false;
+    }
+    return curveData->evaluate(keyFrame, value);
+}
 
-    switch (type) {
-    case EInterPolationType::LINER: {
-        CurveManager::GetInstance().getCurveValue(curve, keyFrame, type, value);
-        return true;
+void NodeLogic::slotUpdateKeyFrame(int keyFrame) {
+    sampleHandles_.clear();
+    sampleCurves_.clear();
+    sampleEvaluators_.clear();
+    sampleNodes_.clear();
+    preOrderReverse(&NodeDataManager::GetInstance().root(), curAnimation_.toStdString());
+
+    // cached frames are table lookups, only the missing ones are sampled
+    sampleBuffer_.resize(sampleCurves_.size());
+    missIndices_.clear();
+    missEvaluators_.clear();
+    for (size_t i{0}; i < sampleCurves_.size(); i++) {
+        if (!sampleCurves_[i]->getFrameCache().lookup(keyFrame, sampleBuffer_[i])) {
+            missIndices_.push_back(i);
+            missEvaluators_.push_back(sampleEvaluators_[i]);
+        }
     }
-    case EInterPolationType::BESIER_SPLINE: {
-        if (CurveManager::GetInstance().hasCurve(curve)) {
-            Curve *curveData = CurveManager::GetInstance().getCurve(curve);
-            std::list<Point *> pointList = curveData->getPointList();
-            for (auto it = pointList.begin(); it != pointList.end(); it++) {
-                auto itTemp = it;
-                itTemp++;
-                if (itTemp != pointList.end()) {
-                    Point *point1 = *it;
-                    Point *point2 = *itTemp;
-                    if (point1->getKeyFrame() < keyFrame && point2->getKeyFrame() > keyFrame) {
-                        QList<QPointF> srcPoints, destPoints;
-                        srcPoints.push_back(QPointF(point1->getKeyFrame() * eachFrameWidth, std::any_cast<double>(point1->getDataValue()) * eachValueWidth));
-                        srcPoints.push_back(QPointF(point1->getRightKeyFrame() * eachFrameWidth, std::any_cast<double>(point1->getRightData()) * eachValueWidth));
-                        srcPoints.push_back(QPointF(point2->getLeftKeyFrame() * eachFrameWidth, std::any_cast<double>(point2->getLeftData()) * eachValueWidth));
-                        srcPoints.push_back(QPointF(point2->getKeyFrame() * eachFrameWidth, std::any_cast<double>(point2->getDataValue()) * eachValueWidth));
-
-                        time_axis::createNBezierCurve(srcPoints, destPoints, 0.001);
-
-                        // point border value
-                        double dIndex = (1000.0 / (point2->getKeyFrame() - point1->getKeyFrame()) * (keyFrame - point1->getKeyFrame())) - 1;
-                        int iIndex = dIndex;
-                        if (iIndex >= destPoints.size() - 1) {
-                            iIndex = destPoints.size() - 1;
-                            time_axis::point2Value(eachFrameWidth, eachValueWidth, destPoints[iIndex], value);
-                            return true;
-                        }
-                        if (iIndex < 0) {
-                            iIndex = 0;
-                        }
-
-                        // point value
-                        double offset = dIndex - iIndex;
-                        double lastValue, nextValue;
-                        time_axis::point2Value(eachFrameWidth, eachValueWidth, destPoints[iIndex], lastValue);
-                        time_axis::point2Value(eachFrameWidth, eachValueWidth, destPoints[iIndex + 1], nextValue);
-                        value = (nextValue - lastValue) * offset + lastValue;
-                        return true;
-                    }
-                }
-            }
-            return CurveManager::GetInstance().getCurveValue(curve, keyFrame, EInterPolationType::LINER, value);
+    // curves are compiled while collecting, the workers only read them
+    curveSampler_.sampleFrame(missEvaluators_, keyFrame, missValues_);
+    for (size_t i{0}; i < missIndices_.size(); i++) {
+        size_t index = missIndices_[i];
+        sampleBuffer_[index] = missValues_[i];
+        if (!std::isnan(missValues_[i])) {
+            sampleCurves_[index]->getFrameCache().store(keyFrame, missValues_[i]);
         }
-        break;
     }
-    case EInterPolationType::HERMIT_SPLINE: {
-        if (CurveManager::GetInstance().hasCurve(curve)) {
-            Curve *curveData = CurveManager::GetInstance().getCurve(curve);
-            std::list<Point *> pointList = curveData->getPointList();
-            for (auto it = pointList.begin(); it != pointList.end(); it++) {
-                auto itTemp = it;
-                itTemp++;
-                if (itTemp != pointList.end()) {
-                    Point *point1 = *it;
-                    Point *point2 = *itTemp;
-                    if (point1->getKeyFrame() < keyFrame && point2->getKeyFrame() > keyFrame) {
-                        QList<QPointF> srcPoints, destPoints;
-
-                        srcPoints.push_back(QPointF(point1->getKeyFrame() * eachFrameWidth, std::any_cast<double>(point1->getDataValue()) * eachValueWidth));
-                        srcPoints.push_back(QPointF(point2->getKeyFrame() * eachFrameWidth, std::any_cast<double>(point2->getDataValue()) * eachValueWidth));
-                        srcPoints.push_back(QPointF((point1->getRightKeyFrame() - point1->getKeyFrame()) * eachFrameWidth,
-                                                    (std::any_cast<double>(point1->getRightData()) - std::any_cast<double>(point1->getDataValue())) * eachValueWidth));
-                        srcPoints.push_back(QPointF((point2->getKeyFrame() - point2->getLeftKeyFrame()) * eachFrameWidth,
-                                                    (std::any_cast<double>(point2->getLeftData()) - std::any_cast<double>(point2->getDataValue())) * eachValueWidth));
-
-                        time_axis::createHermiteCurve(srcPoints, destPoints, 0.001);
-
-                        // point border value
-                        double dIndex = (1000.0 / (point2->getKeyFrame() - point1->getKeyFrame()) * (keyFrame - point1->getKeyFrame())) - 1;
-                        int iIndex = dIndex;
-                        if (iIndex >= destPoints.size() - 1) {
-                            iIndex = destPoints.size() - 1;
-                            time_axis::point2Value(eachFrameWidth, eachValueWidth, destPoints[iIndex], value);
-                            return true;
-                        }
-                        if (iIndex < 0) {
-                            iIndex = 0;
-                        }
-
-                        // point value
-                        double offset = dIndex - iIndex;
-                        double lastValue, nextValue;
-                        time_axis::point2Value(eachFrameWidth, eachValueWidth, destPoints[iIndex], lastValue);
-                        time_axis::point2Value(eachFrameWidth, eachValueWidth, destPoints[iIndex + 1], nextValue);
-                        value = (nextValue - lastValue) * offset + lastValue;
-                        return true;
-                    }
-                }
-            }
-            return CurveManager::GetInstance().getCurveValue(curve, keyFrame, EInterPolationType::LINER, value);
+
+    sampleValues_.clear();
+    for (size_t i{0}; i < sampleHandles_.size(); i++) {
+        if (!std::isnan(sampleBuffer_[i])) {
+            sampleValues_.emplace_back(sampleHandles_[i], sampleBuffer_[i]);
         }
-        break;
     }
-    case EInterPolationType::STEP: {
-        CurveManager::GetInstance().getCurveValue(curve, keyFrame, type, value);
-        return true;
+    // all bound properties of the frame go in as one change set
+    setValues(sampleValues_);
+    for (const auto &objectID : sampleNodes_) {
+        raco::signal::signalProxy::GetInstance().sigUpdateMeshModelMatrix(objectID);
     }
+}
+
+void NodeLogic::slotUpdateCurveKeyFrame(const std::string &curve, int keyFrame) {
+    Curve *curveData{nullptr};
+    {
+        QMutexLocker locker(&handleMapMutex_);
+        curveData = getBoundCurve(curve);
+    }
+    double value{0.0};
+    if (!curveData || !curveData->getFrameValue(keyFrame, value)) {
+        return;
+    }
+
+    std::string animation = curAnimation_.toStdString();
+    std::vector<std::string> nodes;
+    sampleValues_.clear();
+    {
+        QMutexLocker locker(&handleMapMutex_);
+        for (const auto &item : NodeDataManager::GetInstance().getCurveBindings(curve)) {
+            if (item.sampleProperty_ != animation) {
+                continue;
+            }
+            const std::string &objectID = item.node_->objectID();
+            auto iter = nodeObjectIDHandleReMap_.find(objectID);
+            core::ValueHandle handle;
+            if (iter != nodeObjectIDHandleReMap_.end() && getPropertyHandle(objectID, iter->second, item.property_, handle)) {
+                sampleValues_.emplace_back(handle, value);
+                // bindings of one node are next to each other in the index
+                if (nodes.empty() || nodes.back() != objectID) {
+                    nodes.push_back(objectID);
+                }
+            }
+        }
     }
 
-    return false;
+    setValues(sampleValues_);
+    for (const auto &objectID : nodes) {
+        raco::signal::signalProxy::GetInstance().sigUpdateMeshModelMatrix(objectID);
+    }
 }
 
-void NodeLogic::slotUpdateKeyFrame(int keyFrame) {
-    preOrderReverse(&NodeDataManager::GetInstance().root(), keyFrame, curAnimation_.toStdString());
+void NodeLogic::sampleKeyFrameRange(int firstFrame, int lastFrame, std::vector<core::ValueHandle> &handles, std::vector<double> &values) {
+    sampleHandles_.clear();
+    sampleCurves_.clear();
+    sampleEvaluators_.clear();
+    sampleNodes_.clear();
+    preOrderReverse(&NodeDataManager::GetInstance().root(), curAnimation_.toStdString());
+
+    handles.assign(sampleHandles_.begin(), sampleHandles_.end());
+    curveSampler_.sampleRange(sampleEvaluators_, firstFrame, lastFrame, values);
 }
 
 void NodeLogic::slotResetNodeData() {
     NodeDataManager::GetInstance().clearNodeData();
+    QMutexLocker locker(&handleMapMutex_);
+    propertyHandleReMap_.clear();
+    curveHandleReMap_.clear();
 }
 
 void NodeLogic::slotUpdateMeshNodeTranslation(const std::string &objectID, const double &transX, const double &transY, const double &transZ) {
@@ -105,6 +105,8 @@ Q_SIGNALS:
     void sigSetVisibleMeshNodeCompleted(const bool &visible, const std::string &objectID);
     //
     void sigSwithOutLineModel(const QString& id);
+    // only the keys of curve changed, the properties bound to other curves keep their values
+    void sigUpdateCurveKeyFrame_From_CurveUI(const std::string &curve, int keyFrame);
 };
 
 }
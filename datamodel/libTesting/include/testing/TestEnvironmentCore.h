@@ -62,10 +62,15 @@ inline void clearQEventLoop() {
 class TestUndoStack : public raco::core::UndoStack {
 public:
 	using Entry = raco::core::UndoStack::Entry;
+	using Snapshot = raco::core::UndoStack::Snapshot;
 
 	std::vector<std::unique_ptr<Entry>>& stack() {
 		return stack_;
 	}
+
+	const Snapshot& currentState() const {
+		return state_;
+	}
 };
 
 class TestObjectFactory : public raco::user_types::UserObjectFactory {
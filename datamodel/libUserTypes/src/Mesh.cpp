@@ -29,7 +29,10 @@ void Mesh::updateFromExternalFile(BaseContext& context) {
 
 	if (validateURI(context, {shared_from_this(), &Mesh::uri_})) {
 		mesh_ = context.meshCache()->loadMesh(desc);
-		if (!mesh_) {
+		if (!mesh_ && context.meshCache()->isMeshLoading(desc.absPath)) {
+			// We get notified through the file change handler when the mesh is ready.
+			context.errors().addError(ErrorCategory::GENERAL, ErrorLevel::INFORMATION, ValueHandle{shared_from_this()}, "Loading mesh file...");
+		} else if (!mesh_) {
 			auto savedErrorString = context.meshCache()->getMeshError(desc.absPath);
 			auto errorMessage = (savedErrorString.empty()) ? "Invalid mesh file." : "Error while importing mesh: " + savedErrorString;
 			context.errors().addError(ErrorCategory::PARSING, ErrorLevel::ERROR, {shared_from_this()}, errorMessage);
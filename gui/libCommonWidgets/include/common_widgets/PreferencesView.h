@@ -38,6 +38,9 @@ public:
 private:
 	QLineEdit* userProjectEdit_;
 	QSpinBox* featureLevelEdit_;
+	QSpinBox* undoMemoryBudgetEdit_;
+	QSpinBox* meshCacheSizeEdit_;
+	QDoubleSpinBox* animationKeyReduceToleranceEdit_;
 };
 
 }  // namespace raco::common_widgets
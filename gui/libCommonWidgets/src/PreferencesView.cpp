@@ -15,6 +15,7 @@
 #include "core/PathManager.h"
 #include "log_system/log.h"
 #include "application/RaCoApplication.h"
+#include "mesh_loader/MeshDiskCache.h"
 
 #include <QDialog>
 #include <QDialogButtonBox>
@@ -72,6 +73,57 @@ PreferencesView::PreferencesView(QWidget* parent) : QDialog{parent} {
 		Q_EMIT dirtyChanged(dirty());
 	});
 
+	undoMemoryBudgetEdit_ = new QSpinBox(this);
+	undoMemoryBudgetEdit_->setRange(0, 1024 * 1024);
+	undoMemoryBudgetEdit_->setSuffix(" MiB");
+	undoMemoryBudgetEdit_->setSpecialValueText("Unlimited");
+	undoMemoryBudgetEdit_->setValue(RaCoPreferences::instance().undoMemoryBudget);
+	undoMemoryBudgetEdit_->setToolTip("Oldest undo steps are dropped when the undo history of a project needs more memory. Applies to projects opened after saving.");
+	formLayout->addRow("Undo Memory Budget", undoMemoryBudgetEdit_);
+
+	QObject::connect(undoMemoryBudgetEdit_, QOverload<int>::of(&QSpinBox::valueChanged), this, [this]() {
+		Q_EMIT dirtyChanged(dirty());
+	});
+
+	{
+		auto container = new QWidget{this};
+		auto containerLayout = new QGridLayout{container};
+		meshCacheSizeEdit_ = new QSpinBox(this);
+		meshCacheSizeEdit_->setRange(0, 1024 * 1024);
+		meshCacheSizeEdit_->setSuffix(" MiB");
+		meshCacheSizeEdit_->setSpecialValueText("Unlimited");
+		meshCacheSizeEdit_->setValue(RaCoPreferences::instance().meshCacheSize);
+		meshCacheSizeEdit_->setToolTip("Least recently used converted meshes are removed from the mesh cache when it gets larger. Applies after restarting the application.");
+		auto clearButton = new QPushButton{"Clear", this};
+		clearButton->setToolTip("Remove all converted meshes from the mesh cache.");
+
+		containerLayout->addWidget(meshCacheSizeEdit_, 0, 0);
+		containerLayout->addWidget(clearButton, 0, 1);
+		containerLayout->setColumnStretch(0, 1);
+		containerLayout->setMargin(0);
+		formLayout->addRow("Mesh Cache Size", container);
+
+		QObject::connect(meshCacheSizeEdit_, QOverload<int>::of(&QSpinBox::valueChanged), this, [this]() {
+			Q_EMIT dirtyChanged(dirty());
+		});
+		QObject::connect(clearButton, &QPushButton::clicked, this, []() {
+			raco::mesh_loader::MeshDiskCache(raco::core::PathManager::meshCacheDirectory().string()).clear();
+		});
+	}
+
+	animationKeyReduceToleranceEdit_ = new QDoubleSpinBox(this);
+	animationKeyReduceToleranceEdit_->setRange(0.0, 1000.0);
+	animationKeyReduceToleranceEdit_->setDecimals(6);
+	animationKeyReduceToleranceEdit_->setSingleStep(0.0001);
+	animationKeyReduceToleranceEdit_->setSpecialValueText("Off");
+	animationKeyReduceToleranceEdit_->setValue(RaCoPreferences::instance().animationKeyReduceTolerance);
+	animationKeyReduceToleranceEdit_->setToolTip("Keys of imported glTF animations are removed where the curve stays within this distance of the original keys. Applies to animations imported after saving.");
+	formLayout->addRow("Animation Key Reduction", animationKeyReduceToleranceEdit_);
+
+	QObject::connect(animationKeyReduceToleranceEdit_, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, [this]() {
+		Q_EMIT dirtyChanged(dirty());
+	});
+
 	auto buttonBox = new QDialogButtonBox{this};
 	auto cancelButton{new QPushButton{"Close", buttonBox}};
 	QObject::connect(cancelButton, &QPushButton::clicked, this, &PreferencesView::close);
@@ -108,6 +160,9 @@ void PreferencesView::save() {
 	
 	prefs.userProjectsDirectory = newUserProjectPathString;
 	prefs.featureLevel = featureLevelEdit_->value();
+	prefs.undoMemoryBudget = undoMemoryBudgetEdit_->value();
+	prefs.meshCacheSize = meshCacheSizeEdit_->value();
+	prefs.animationKeyReduceTolerance = animationKeyReduceToleranceEdit_->value();
 
 	if (!prefs.save()) {
 		LOG_ERROR(raco::log_system::COMMON, "Saving settings failed: {}", raco::core::PathManager::preferenceFilePath().string());
@@ -120,7 +175,10 @@ void PreferencesView::save() {
 bool PreferencesView::dirty() {
 	auto& prefs{RaCoPreferences::instance()};
 	return prefs.userProjectsDirectory != userProjectEdit_->text() ||
-		   prefs.featureLevel != featureLevelEdit_->value();
+		   prefs.featureLevel != featureLevelEdit_->value() ||
+		   prefs.undoMemoryBudget != undoMemoryBudgetEdit_->value() ||
+		   prefs.meshCacheSize != meshCacheSizeEdit_->value() ||
+		   prefs.animationKeyReduceTolerance != animationKeyReduceToleranceEdit_->value();
 }
 
 }  // namespace raco::common_widgets
@@ -280,7 +280,7 @@ void PropertyBrowserWidget::switchNode(std::string objectID) {
 		customWidget_->initPropertyBrowserCustomWidget();
     }
     raco::core::UndoState undoState;
-    undoState.saveCurrentUndoState();
+    undoState.saveCurrentUndoState(commandInterface_->undoStack().currentUndoState());
     std::string description = fmt::format("switch active node to '{}'", nodeData->getName());
     commandInterface_->undoStack().push(description, undoState);
 }
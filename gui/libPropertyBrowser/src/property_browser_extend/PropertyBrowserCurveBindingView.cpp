@@ -195,15 +195,11 @@ void PropertyBrowserCurveBindingView::slotSearchBtnClicked() {
     searchEditor_->setGeoMetry(searchBtn_);
     if (searchEditor_->exec() == QDialog::Accepted) {
         QString search = searchEditor_->getSearchString();
-        std::regex regex(search.toStdString());
 
         resultTree_->setGeoMetry(searchBtn_);
         resultTree_->clear();
-        std::list<Curve*> curveList = CurveManager::GetInstance().getCurveList();
-        for (auto it : curveList) {
-            if (std::regex_search(it->getCurveName(), regex)) {
-                resultTree_->addCurve(QString::fromStdString(it->getCurveName()));
-            }
+        for (auto it : CurveManager::GetInstance().search(search.toStdString())) {
+            resultTree_->addCurve(QString::fromStdString(it->getCurveName()));
         }
         if (resultTree_->exec() == QDialog::Accepted) {
             QString curve = resultTree_->getSelectedCurve();
@@ -222,7 +218,7 @@ void PropertyBrowserCurveBindingView::slotRefrenceBtnClicked() {
 
 void PropertyBrowserCurveBindingView::pushUndoState(std::string description) {
     raco::core::UndoState undoState;
-    undoState.saveCurrentUndoState();
+    undoState.saveCurrentUndoState(commandInterface_->undoStack().currentUndoState());
     commandInterface_->undoStack().push(description, undoState);
 }
 
@@ -78,7 +78,7 @@ void PropertyBrowserCurveBindingWidget::insertData() {
     Q_EMIT signalProxy::GetInstance().sigRepaintTimeAxis_From_NodeUI();
 
     raco::core::UndoState undoState;
-    undoState.saveCurrentUndoState();
+    undoState.saveCurrentUndoState(commandInterface_->undoStack().currentUndoState());
     std::string description = fmt::format("insert curveBinding to '{}'", NodeDataManager::GetInstance().getActiveNode()->getName());
     commandInterface_->undoStack().push(description, undoState);
 }
@@ -105,7 +105,7 @@ void PropertyBrowserCurveBindingWidget::removeData() {
     Q_EMIT signalProxy::GetInstance().sigRepaintTimeAxis_From_NodeUI();
 
     raco::core::UndoState undoState;
-    undoState.saveCurrentUndoState();
+    undoState.saveCurrentUndoState(commandInterface_->undoStack().currentUndoState());
     std::string description = fmt::format("delete '{}' property of curveBinding from '{}'", property, NodeDataManager::GetInstance().getActiveNode()->getName());
     commandInterface_->undoStack().push(description, undoState);
 }
@@ -79,9 +79,7 @@ void KeyFrameManager::refreshKeyFrameList(std::map < std::string, std::map<std::
             std::string curveName = bindingIt.second;
             Curve* curve = CurveManager::GetInstance().getCurve(curveName);
             if (curve) {
-                std::list<Point*> pointList = curve->getPointList();
-                for (Point* point : pointList) {
-                    int keyFrame = point->getKeyFrame();
+                for (int keyFrame : curve->getKeyFrames()) {
                     if (!keyFrameList.contains(keyFrame)) {
                         keyFrameList.insert(keyFrame);
                     }
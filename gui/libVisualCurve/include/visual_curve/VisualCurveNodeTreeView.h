@@ -7,6 +7,7 @@
 #include <QStandardItemModel>
 #include <QMenu>
 #include <QMessageBox>
+#include <QInputDialog>
 #include <QMimeData>
 #include <QMouseEvent>
 #include <QHeaderView>
@@ -19,6 +20,7 @@
 #include "VisualCurveNodeDelegate.h"
 #include "FolderData/FolderDataManager.h"
 #include "CurveData/CurveManager.h"
+#include "CurveData/CurveReducer.h"
 
 using namespace raco::guiData;
 namespace raco::visualCurve {
@@ -63,6 +65,7 @@ public Q_SLOTS:
     void slotSetVisibleOn();
     void slotSetVisibleOff();
     void slotDelete();
+    void slotSimplifyCurve();
     void slotItemChanged(QStandardItem *item);
     void slotCurrentRowChanged(const QModelIndex &index);
     void slotButtonDelegateClicked(const QModelIndex &index);
@@ -92,11 +95,13 @@ private:
     QAction *createFolder_{nullptr};
     QAction *delete_{nullptr};
     QAction *createCurve_{nullptr};
+    QAction *simplifyCurve_{nullptr};
     QMenu *visibleMenu_{nullptr};
     QAction *onAct_{nullptr};
     QAction *offAct_{nullptr};
     FolderDataManager *folderDataMgr_{nullptr};
     std::string selNode_;
+    double simplifyTolerance_{0.001};
     ButtonDelegate *visibleButton_{nullptr};
     raco::core::CommandInterface* commandInterface_{nullptr};
 };
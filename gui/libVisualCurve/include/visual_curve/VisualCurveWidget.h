@@ -3,6 +3,8 @@
 
 #include <QWidget>
 #include <QPainterPath>
+#include <QPolygonF>
+#include <initializer_list>
 #include <QtGlobal>
 #include <QtCore/qmath.h>
 #include <QMenu>
@@ -85,9 +87,15 @@ private:
     // paint liner
     void drawLiner(QPainter &painter, std::string curve, SKeyPoint lastPoint, SKeyPoint nextPoint);
     // paint bezier
-    void drawBezier(QPainter &painter, std::string curve, SKeyPoint lastPoint, SKeyPoint nextPoint, QPair<QPointF, QPointF> lastWorkerPoint, QPair<QPointF, QPointF> nextWorkerPoint);
+    void drawBezier(QPainter &painter, std::string curve, int index, SKeyPoint lastPoint, SKeyPoint nextPoint, QPair<QPointF, QPointF> lastWorkerPoint, QPair<QPointF, QPointF> nextWorkerPoint);
     // paint hermite
-    void drawHermite(QPainter &painter, std::string curve, SKeyPoint lastPoint, SKeyPoint nextPoint, QPair<QPointF, QPointF> lastWorkerPoint, QPair<QPointF, QPointF> nextWorkerPoint);
+    void drawHermite(QPainter &painter, std::string curve, int index, SKeyPoint lastPoint, SKeyPoint nextPoint, QPair<QPointF, QPointF> lastWorkerPoint, QPair<QPointF, QPointF> nextWorkerPoint);
+    // bounding box of the points overlaps the curve area
+    bool isSegmentVisible(std::initializer_list<QPointF> points) const;
+    // tessellated cubic segment relative to lastKey, cached until the segment changes on screen
+    const QPolygonF &segmentPath(const std::string &curve, int index, int type, QPointF lastKey, QPointF firstControl, QPointF secondControl, QPointF nextKey);
+    // paint path moved by offset, without the parts behind the frame number bar
+    void drawClippedPath(QPainter &painter, const QPolygonF &points, QPointF offset);
     // paint step
     void drawStep(QPainter &painter, std::string curve, SKeyPoint lastPoint, SKeyPoint nextPoint);
     // paint worker point
@@ -169,6 +177,15 @@ private:
 
     std::map<std::string, std::string> bindingMap_;
     raco::core::CommandInterface* commandInterface_{nullptr};
+
+    struct SegmentPath {
+        int type{-1};
+        QPointF firstControl;
+        QPointF secondControl;
+        QPointF nextKey;
+        QPolygonF points;
+    };
+    std::map<std::string, std::vector<SegmentPath>> segmentPathCache_;
 private:
     KEY_PRESS_ACT pressAction_{KEY_PRESS_NONE};
     QMenu *menu_{nullptr};
@@ -1202,7 +1202,7 @@ void VisualCurveInfoWidget::recaculateWorkerRightPoint(QPair<QPointF, QPointF> &
 
 void VisualCurveInfoWidget::pushState2UndoStack(std::string description) {
     raco::core::UndoState undoState;
-    undoState.saveCurrentUndoState();
+    undoState.saveCurrentUndoState(commandInterface_->undoStack().currentUndoState());
     commandInterface_->undoStack().push(description, undoState);
 }
 }
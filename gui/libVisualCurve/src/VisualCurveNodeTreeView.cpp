@@ -183,8 +183,7 @@ void TreeModel::setFolderPath(Folder *folder, std::string path) {
         folderDataMgr_->pathFromCurve(it->curve_, folder, curveName);
         std::string oldCurvePath = path + "|" + it->curve_;
         if (CurveManager::GetInstance().getCurve(oldCurvePath)) {
-            Curve *tempCurve = CurveManager::GetInstance().getCurve(oldCurvePath);
-            tempCurve->setCurveName(curveName);
+            CurveManager::GetInstance().modifyCurveName(oldCurvePath, curveName);
             swapCurve(oldCurvePath, curveName);
         }
     }
@@ -204,8 +203,7 @@ bool TreeModel::moveCurveToNode(Folder *srcFolder, STRUCT_CURVE_PROP *srcCurvePr
                 destFolder->insertCurve(srcCurveProp);
                 if (CurveManager::GetInstance().getCurve(srcCurvePath)) {
                     destCurvePath = destCurvePath + "|" + srcCurveProp->curve_;
-                    Curve *curve = CurveManager::GetInstance().getCurve(srcCurvePath);
-                    curve->setCurveName(destCurvePath);
+                    CurveManager::GetInstance().modifyCurveName(srcCurvePath, destCurvePath);
                     swapCurve(srcCurvePath, destCurvePath);
                 }
                 return true;
@@ -219,8 +217,7 @@ bool TreeModel::moveCurveToDefaultNode(Folder *srcFolder, STRUCT_CURVE_PROP *src
     srcFolder->takeCurve(srcCurveProp->curve_);
     folderDataMgr_->getRootFolder()->insertCurve(srcCurveProp);
     if (CurveManager::GetInstance().getCurve(srcCurvePath)) {
-        Curve *curve = CurveManager::GetInstance().getCurve(srcCurvePath);
-        curve->setCurveName(srcCurveProp->curve_);
+        CurveManager::GetInstance().modifyCurveName(srcCurvePath, srcCurveProp->curve_);
         swapCurve(srcCurvePath, srcCurveProp->curve_);
     }
     return true;
@@ -304,12 +301,14 @@ VisualCurveNodeTreeView::VisualCurveNodeTreeView(QWidget *parent, core::CommandI
     createFolder_ = new QAction("Create Node");
     delete_ = new QAction("Delete");
     createCurve_ = new QAction("Create Curve");
+    simplifyCurve_ = new QAction("Simplify Curve");
     setContextMenuPolicy(Qt::CustomContextMenu);
 
     connect(this, &VisualCurveNodeTreeView::customContextMenuRequested, this, &VisualCurveNodeTreeView::slotShowContextMenu);
     connect(createFolder_, &QAction::triggered, this, &VisualCurveNodeTreeView::slotCreateFolder);
     connect(delete_, &QAction::triggered, this, &VisualCurveNodeTreeView::slotDelete);
     connect(createCurve_, &QAction::triggered, this, &VisualCurveNodeTreeView::slotCreateCurve);
+    connect(simplifyCurve_, &QAction::triggered, this, &VisualCurveNodeTreeView::slotSimplifyCurve);
     connect(onAct_, &QAction::triggered, this, &VisualCurveNodeTreeView::slotSetVisibleOn);
     connect(offAct_, &QAction::triggered, this, &VisualCurveNodeTreeView::slotSetVisibleOff);
     connect(model_, &QStandardItemModel::itemChanged, this, &VisualCurveNodeTreeView::slotItemChanged);
@@ -444,6 +443,9 @@ void VisualCurveNodeTreeView::slotShowContextMenu(const QPoint &p) {
         menu_->addAction(delete_);
         menu_->addAction(createFolder_);
         menu_->addAction(createCurve_);
+        if (folderDataMgr_->isCurve(curve)) {
+            menu_->addAction(simplifyCurve_);
+        }
         menu_->addMenu(visibleMenu_);
     } else {
         visualCurveTreeView_->setCurrentIndex(QModelIndex());
@@ -639,6 +641,37 @@ void VisualCurveNodeTreeView::slotDelete() {
     pushState2UndoStack(fmt::format("delete curves/nodes: '{}'", info));
 }
 
+void VisualCurveNodeTreeView::slotSimplifyCurve() {
+    bool ok{false};
+    double tolerance = QInputDialog::getDouble(this, "Simplify Curve", "Tolerance:", simplifyTolerance_, 0.0, 1000.0, 4, &ok);
+    if (!ok) {
+        return;
+    }
+    simplifyTolerance_ = tolerance;
+
+    std::string info;
+    size_t removed{0};
+    CurveReducer reducer(tolerance);
+    QModelIndexList selectedIndexs = visualCurveTreeView_->selectionModel()->selectedRows();
+    for (auto selected : selectedIndexs) {
+        QStandardItem *item = model_->itemFromIndex(selected);
+        if (item) {
+            std::string curvePath = curveFromItem(item).toStdString();
+            Curve *curve = CurveManager::GetInstance().getCurve(curvePath);
+            if (folderDataMgr_->isCurve(curvePath) && curve) {
+                removed += reducer.reduce(*curve);
+                info += curvePath + ";";
+            }
+        }
+    }
+    if (removed == 0) {
+        return;
+    }
+    VisualCurvePosManager::GetInstance().resetCurrentPointInfo();
+    pushState2UndoStack(fmt::format("simplify curves '{}': {} keys removed", info, removed));
+    Q_EMIT signal::signalProxy::GetInstance().sigRepaintAfterUndoOpreation();
+}
+
 void VisualCurveNodeTreeView::slotItemChanged(QStandardItem *item) {
     std::string curve = item->text().toStdString();
     std::string curvePath = selNode_;
@@ -805,7 +838,7 @@ QString VisualCurveNodeTreeView::curveFromItem(QStandardItem *item) {
 
 void VisualCurveNodeTreeView::pushState2UndoStack(std::string description) {
     raco::core::UndoState undoState;
-    undoState.saveCurrentUndoState();
+    undoState.saveCurrentUndoState(commandInterface_->undoStack().currentUndoState());
     commandInterface_->undoStack().push(description, undoState);
 }
 
@@ -837,8 +870,7 @@ void VisualCurveNodeTreeView::setFolderPath(Folder *folder, std::string path) {
         folderDataMgr_->pathFromCurve(it->curve_, folder, curveName);
         std::string oldCurvePath = path + "|" + it->curve_;
         if (CurveManager::GetInstance().getCurve(oldCurvePath)) {
-            Curve *tempCurve = CurveManager::GetInstance().getCurve(oldCurvePath);
-            tempCurve->setCurveName(curveName);
+            CurveManager::GetInstance().modifyCurveName(oldCurvePath, curveName);
             swapCurve(oldCurvePath, curveName);
         }
     }
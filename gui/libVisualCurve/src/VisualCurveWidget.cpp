@@ -6,6 +6,8 @@
 #include <QMenu>
 #include <QDebug>
 #include "math.h"
+#include <algorithm>
+#include <limits>
 #include "common_editors/Int64Editor.h"
 #include "VisualCurveData/VisualCurvePosManager.h"
 #include "time_axis/TimeAxisScrollArea.h"
@@ -632,7 +634,6 @@ void VisualCurveWidget::createKeyFrame(QString curveName) {
     if (CurveManager::GetInstance().hasCurve(curveName.toStdString())) {
         Curve *curve = CurveManager::GetInstance().getCurve(curveName.toStdString());
         if (curve) {
-            std::list<Point*> pointList = curve->getPointList();
             QList<SKeyPoint> keyPoints;
             VisualCurvePosManager::GetInstance().getKeyPointList(curveName.toStdString(), keyPoints);
 
@@ -646,57 +647,50 @@ void VisualCurveWidget::createKeyFrame(QString curveName) {
                 }
             }
 
-            auto it = pointList.begin();
-            while (it != pointList.end()) {
-                if ((*it)->getKeyFrame() == VisualCurvePosManager::GetInstance().getCurFrame()) {
-                    QPointF pointF;
-                    double value{0.0};
-                    if ((*it)->getDataValue().type() == typeid(double)) {
-                        value = *(*it)->getDataValue()._Cast<double>();
-                    }
-                    keyFrame2PointF(curX, curY, eachFrameWidth, eachValueWidth, (*it)->getKeyFrame(), value, pointF);
-                    SKeyPoint newPoint(pointF.x(), pointF.y(), (*it)->getInterPolationType(), (*it)->getKeyFrame());
-
-                    Point *point = (*it);
-
-                    // get next point
-                    int offsetLastKey{10};
-                    int offsetNextKey{10};
-
-                    int curKeyFrame = (*it)->getKeyFrame();
-                    if (it != pointList.begin()) {
-                        it--;
-                        int lastKey = (*it)->getKeyFrame();
-                        if (curKeyFrame - lastKey < 10) {
-                            offsetLastKey = curKeyFrame - lastKey;
-                            offsetLastKey = offsetLastKey == 0 ? 1 : offsetLastKey;
-                        }
-                        it++;
-                    }
-                    it++;
-                    if (it != pointList.end()) {
-                        int nextKey = (*it)->getKeyFrame();
-                        if (nextKey - curKeyFrame < 10) {
-                            offsetNextKey = nextKey - curKeyFrame;
-                            offsetNextKey = offsetNextKey == 0 ? 1 : offsetNextKey;
-                        }
-                    }
-                    point->setLeftKeyFrame(curKeyFrame - offsetLastKey);
-                    point->setRightKeyFrame(curKeyFrame + offsetNextKey);
-                    point->setLeftData(value);
-                    point->setRightData(value);
-                    newPoint.setLeftPoint(QPointF(pointF.x() - offsetLastKey * eachFrameWidth, pointF.y()));
-                    newPoint.setRightPoint(QPointF(pointF.x() + offsetNextKey * eachFrameWidth, pointF.y()));
-                    if (index != -1) {
-                        VisualCurvePosManager::GetInstance().insertKeyPoint(index, curveName.toStdString(), newPoint);
-                    }
+            auto keyFrames = curve->getKeyFrames();
+            int curKeyFrame = VisualCurvePosManager::GetInstance().getCurFrame();
+            auto it = std::find(keyFrames.begin(), keyFrames.end(), curKeyFrame);
+            if (it == keyFrames.end()) {
+                return;
+            }
+            size_t pointIndex = it - keyFrames.begin();
 
-                    update();
-                    pushState2UndoStack(fmt::format("insert point to '{}', '{}' keyframe", curveName.toStdString(), curKeyFrame));
-                    return;
+            QPointF pointF;
+            double value = curve->getDataValues()[pointIndex];
+            keyFrame2PointF(curX, curY, eachFrameWidth, eachValueWidth, curKeyFrame, value, pointF);
+            SKeyPoint newPoint(pointF.x(), pointF.y(), curve->getInterPolationTypes()[pointIndex], curKeyFrame);
+
+            // get next point
+            int offsetLastKey{10};
+            int offsetNextKey{10};
+
+            if (pointIndex > 0) {
+                int lastKey = keyFrames[pointIndex - 1];
+                if (curKeyFrame - lastKey < 10) {
+                    offsetLastKey = curKeyFrame - lastKey;
+                    offsetLastKey = offsetLastKey == 0 ? 1 : offsetLastKey;
+                }
+            }
+            if (pointIndex + 1 < keyFrames.size()) {
+                int nextKey = keyFrames[pointIndex + 1];
+                if (nextKey - curKeyFrame < 10) {
+                    offsetNextKey = nextKey - curKeyFrame;
+                    offsetNextKey = offsetNextKey == 0 ? 1 : offsetNextKey;
                 }
-                it++;
             }
+            Point *point = curve->getPoint(curKeyFrame);
+            point->setLeftKeyFrame(curKeyFrame - offsetLastKey);
+            point->setRightKeyFrame(curKeyFrame + offsetNextKey);
+            point->setLeftData(value);
+            point->setRightData(value);
+            newPoint.setLeftPoint(QPointF(pointF.x() - offsetLastKey * eachFrameWidth, pointF.y()));
+            newPoint.setRightPoint(QPointF(pointF.x() + offsetNextKey * eachFrameWidth, pointF.y()));
+            if (index != -1) {
+                VisualCurvePosManager::GetInstance().insertKeyPoint(index, curveName.toStdString(), newPoint);
+            }
+
+            update();
+            pushState2UndoStack(fmt::format("insert point to '{}', '{}' keyframe", curveName.toStdString(), curKeyFrame));
         }
     }
 }
@@ -851,7 +845,7 @@ void VisualCurveWidget::slotDeleteKeyFrame() {
     if (CurveManager::GetInstance().getCurve(curCurve)) {
         Curve *curve = CurveManager::GetInstance().getCurve(curCurve);
         curve->takePoint(keyPoint.keyFrame);
-        if (curve->getPointList().empty()) {
+        if (curve->getPointSize() == 0) {
             CurveManager::GetInstance().takeCurve(curCurve);
             Q_EMIT sigDeleteCurve(curCurve);
         }
@@ -934,36 +928,31 @@ void VisualCurveWidget::slotInsertCurve(QString property, QString curveName, QVa
 
     Curve *curve = CurveManager::GetInstance().getCurve(curveName.toStdString());
     if (curve) {
-        std::list<Point*> pointList = curve->getPointList();
+        auto keyFrames = curve->getKeyFrames();
+        auto interPolationTypes = curve->getInterPolationTypes();
+        auto dataValues = curve->getDataValues();
         QList<SKeyPoint> srcPoints;
-        auto it = pointList.begin();
-        while (it != pointList.end()) {
+        srcPoints.reserve(keyFrames.size());
+        for (size_t index = 0; index < keyFrames.size(); index++) {
+            int curKeyFrame = keyFrames[index];
             QPointF pointF;
-            double value{0};
-            if ((*it)->getDataValue().type() == typeid(double)) {
-                value = *(*it)->getDataValue()._Cast<double>();
-            }
-            keyFrame2PointF(curX, curY, eachFrameWidth, eachValueWidth, (*it)->getKeyFrame(), value, pointF);
+            keyFrame2PointF(curX, curY, eachFrameWidth, eachValueWidth, curKeyFrame, dataValues[index], pointF);
 
-            SKeyPoint keyPoint(pointF.x(), pointF.y(), (*it)->getInterPolationType(), (*it)->getKeyFrame());
+            SKeyPoint keyPoint(pointF.x(), pointF.y(), interPolationTypes[index], curKeyFrame);
 
             // get next point
             int offsetLastKey{10};
             int offsetNextKey{10};
 
-            int curKeyFrame = (*it)->getKeyFrame();
-            if (it != pointList.begin()) {
-                it--;
-                int lastKey = (*it)->getKeyFrame();
+            if (index > 0) {
+                int lastKey = keyFrames[index - 1];
                 if (curKeyFrame - lastKey < 10) {
                     offsetLastKey = curKeyFrame - lastKey;
                     offsetLastKey = offsetLastKey == 0 ? 1 : offsetLastKey;
                 }
-                it++;
             }
-            it++;
-            if (it != pointList.end()) {
-                int nextKey = (*it)->getKeyFrame();
+            if (index + 1 < keyFrames.size()) {
+                int nextKey = keyFrames[index + 1];
                 if (nextKey - curKeyFrame < 10) {
                     offsetNextKey = nextKey - curKeyFrame;
                     offsetNextKey = offsetNextKey == 0 ? 1 : offsetNextKey;
@@ -1037,10 +1026,9 @@ void VisualCurveWidget::drawKeyFrame(QPainter &painter) {
     std::string curCurve = VisualCurvePosManager::GetInstance().getCurrentPointInfo().first;
     int index = VisualCurvePosManager::GetInstance().getCurrentPointInfo().second;
     std::string animation = animationDataManager::GetInstance().getActiveAnimationName();
-    std::map < std::string, std::map<std::string, std::string>> curveBindingMap;
-    curveBindingMap = NodeDataManager::GetInstance().getActiveNode()->NodeExtendRef().curveBindingRef().bindingMap();
+    const auto &curveBindingMap = NodeDataManager::GetInstance().getActiveNode()->NodeExtendRef().curveBindingRef().bindingMap();
 
-    auto getProperty = [=](std::string curve)->std::string {
+    auto getProperty = [&](const std::string &curve)->std::string {
         for (const auto &it : curveBindingMap) {
             for (const auto &bindingIt : it.second) {
                 if (bindingIt.second == curve) {
@@ -1071,99 +1059,120 @@ void VisualCurveWidget::drawKeyFrame(QPainter &painter) {
     painter.setBrush(brush);
     painter.save();
 
-    for (const auto &it : VisualCurvePosManager::GetInstance().getKeyPointMap().toStdMap()) {
-        if (VisualCurvePosManager::GetInstance().hasHidenCurve(it.first)) {
+    const QMap<std::string, QList<SKeyPoint>> keyPointMap = VisualCurvePosManager::GetInstance().getKeyPointMap();
+    // forget the paths of removed curves
+    for (auto cacheIt = segmentPathCache_.begin(); cacheIt != segmentPathCache_.end();) {
+        if (!keyPointMap.contains(cacheIt->first)) {
+            cacheIt = segmentPathCache_.erase(cacheIt);
+        } else {
+            ++cacheIt;
+        }
+    }
+
+    MOUSE_PRESS_ACTION pressAction = VisualCurvePosManager::GetInstance().getPressAction();
+    for (auto it = keyPointMap.cbegin(); it != keyPointMap.cend(); ++it) {
+        const std::string &curve = it.key();
+        const QList<SKeyPoint> &points = it.value();
+        if (VisualCurvePosManager::GetInstance().hasHidenCurve(curve) || points.isEmpty()) {
             continue;
         }
+        auto &paths = segmentPathCache_[curve];
+        if (paths.size() > static_cast<size_t>(points.size())) {
+            paths.resize(points.size());
+        }
 
-        QPen pen = painterPen(QString::fromStdString(getProperty(it.first)), 1, 125);
-        painter.setPen(pen);
-        for (int i{0}; i < it.second.size(); ++i) {
-            SKeyPoint firstPoint = it.second.at(i);
+        QString property = QString::fromStdString(getProperty(curve));
+        QPen pen = painterPen(property, 1, 125);
+        QPen curvePen = pen;
+        if ((pressAction == MOUSE_PRESS_KEY || pressAction == MOUSE_PRESS_LEFT_WORKER_KEY || pressAction == MOUSE_PRESS_RIGHT_WORKER_KEY) && curCurve == curve) {
+            curvePen = painterPen(property, 2, 255);
+        }
+        painter.setPen(curvePen);
 
+        // keys are sorted by frame, only the segments between the keys around the visible frames are drawn
+        auto visibleBegin = std::lower_bound(points.cbegin(), points.cend(), 0.0, [](const SKeyPoint &point, double x) {
+            return point.x < x;
+        });
+        auto visibleEnd = std::upper_bound(points.cbegin(), points.cend(), static_cast<double>(width()), [](double x, const SKeyPoint &point) {
+            return x < point.x;
+        });
+        int begin = std::max(static_cast<int>(visibleBegin - points.cbegin()) - 1, 0);
+        int end = std::min(static_cast<int>(visibleEnd - points.cbegin()) + 1, points.size());
+
+        for (int i = begin; i + 1 < end; ++i) {
+            const SKeyPoint &firstPoint = points.at(i);
+            const SKeyPoint &secondPoint = points.at(i + 1);
             QPair<QPointF, QPointF> firstWorkerPoint(firstPoint.leftPoint, firstPoint.rightPoint);
-            MOUSE_PRESS_ACTION pressAction = VisualCurvePosManager::GetInstance().getPressAction();
-            if ((pressAction == MOUSE_PRESS_KEY || pressAction == MOUSE_PRESS_LEFT_WORKER_KEY || pressAction == MOUSE_PRESS_RIGHT_WORKER_KEY) && curCurve == it.first) {
-                QPen tempPen = painterPen(QString::fromStdString(getProperty(it.first)), 2, 255);
-                painter.setPen(tempPen);
+            QPair<QPointF, QPointF> secondWorkerPoint(secondPoint.leftPoint, secondPoint.rightPoint);
+            switch (firstPoint.type) {
+            case EInterPolationType::LINER: {
+                drawLiner(painter, curve, firstPoint, secondPoint);
+                break;
             }
-
-            if (i + 1 < it.second.size()) {
-                SKeyPoint secondPoint = it.second.at(i + 1);
-                QPair<QPointF, QPointF> secondWorkerPoint(secondPoint.leftPoint, secondPoint.rightPoint);
-                switch (firstPoint.type) {
-                case EInterPolationType::LINER: {
-                    drawLiner(painter, it.first, firstPoint, secondPoint);
-                    break;
-                }
-                case EInterPolationType::BESIER_SPLINE: {
-                    drawBezier(painter, it.first, firstPoint, secondPoint, firstWorkerPoint, secondWorkerPoint);
-                    break;
-                }
-                case EInterPolationType::HERMIT_SPLINE: {
-                    drawHermite(painter, it.first, firstPoint, secondPoint, firstWorkerPoint, secondWorkerPoint);
-                    break;
-                }
-                case EInterPolationType::STEP: {
-                    drawStep(painter, it.first, firstPoint, secondPoint);
-                    break;
-                }
-                }
+            case EInterPolationType::BESIER_SPLINE: {
+                drawBezier(painter, curve, i, firstPoint, secondPoint, firstWorkerPoint, secondWorkerPoint);
+                break;
             }
-            if (i == 0) {
-                SKeyPoint tempPoint = firstPoint;
-                tempPoint.setX(0);
-                if (firstPoint.y >= *numHeight) {
-                    drawLiner(painter, it.first, tempPoint, firstPoint);
-                }
+            case EInterPolationType::HERMIT_SPLINE: {
+                drawHermite(painter, curve, i, firstPoint, secondPoint, firstWorkerPoint, secondWorkerPoint);
+                break;
             }
-            if (i == it.second.size() - 1) {
-                SKeyPoint nextPoint(this->width(), firstPoint.y);
-                if (nextPoint.y >= *numHeight) {
-                    drawLiner(painter, it.first, firstPoint, nextPoint);
-                }
+            case EInterPolationType::STEP: {
+                drawStep(painter, curve, firstPoint, secondPoint);
+                break;
             }
-
-            if (i == 0) {
-                // paint worker point
-                painter.setPen(pen);
-                painter.setBrush(brush);
-                painter.save();
-                drawWorkerPoint(painter, firstPoint, firstWorkerPoint, firstPoint, i, it.first);
-            } else {
-                SKeyPoint tempPoint = it.second.at(i - 1);
-                painter.setPen(pen);
-                painter.setBrush(brush);
-                painter.save();
-                drawWorkerPoint(painter, firstPoint, firstWorkerPoint, tempPoint, i, it.first);
             }
         }
 
+        SKeyPoint firstPoint = points.first();
+        if (firstPoint.x > 0 && firstPoint.y >= *numHeight) {
+            SKeyPoint tempPoint = firstPoint;
+            tempPoint.setX(0);
+            drawLiner(painter, curve, tempPoint, firstPoint);
+        }
+        SKeyPoint lastPoint = points.last();
+        if (lastPoint.x < width() && lastPoint.y >= *numHeight) {
+            SKeyPoint nextPoint(this->width(), lastPoint.y);
+            drawLiner(painter, curve, lastPoint, nextPoint);
+        }
+
+        // paint worker point, only the selected key shows its handles
+        if (curCurve == curve && index >= 0 && index < points.size()) {
+            const SKeyPoint &point = points.at(index);
+            QPair<QPointF, QPointF> workerPoint(point.leftPoint, point.rightPoint);
+            painter.setPen(pen);
+            painter.setBrush(brush);
+            painter.save();
+            drawWorkerPoint(painter, point, workerPoint, index == 0 ? point : points.at(index - 1), index, curve);
+        }
+
         painter.setBrush(brush);
         painter.setPen(pen);
         painter.save();
         // paint keyframe
-        for (auto i = 0; i < it.second.size(); i++) {
-            if (it.second.at(i).y < *numHeight) {
+        int keyBegin = static_cast<int>(visibleBegin - points.cbegin());
+        int keyEnd = static_cast<int>(visibleEnd - points.cbegin());
+        for (auto i = keyBegin; i < keyEnd; i++) {
+            if (points.at(i).y < *numHeight) {
                 continue;
             }
-            if (VisualCurvePosManager::GetInstance().getPressAction() == MOUSE_PRESS_KEY && (curCurve == it.first && index == i)) {
+            if (pressAction == MOUSE_PRESS_KEY && (curCurve == curve && index == i)) {
                 auto brush = painter.brush();
                 brush.setColor(QColor(255, 255, 255, 255));
                 painter.setBrush(brush);
-                painter.drawEllipse(QPointF(it.second.at(i).x, it.second.at(i).y) , 3, 3);
+                painter.drawEllipse(QPointF(points.at(i).x, points.at(i).y) , 3, 3);
                 painter.restore();
                 continue;
             }
-            if (VisualCurvePosManager::GetInstance().getKeyBoardType() == MULTI_POINT_MOVE && (curCurve == it.first && VisualCurvePosManager::GetInstance().hasMultiSelPoint(i))) {
+            if (VisualCurvePosManager::GetInstance().getKeyBoardType() == MULTI_POINT_MOVE && (curCurve == curve && VisualCurvePosManager::GetInstance().hasMultiSelPoint(i))) {
                 auto brush = painter.brush();
                 brush.setColor(QColor(200, 200, 0, 255));
                 painter.setBrush(brush);
-                painter.drawEllipse(QPointF(it.second.at(i).x, it.second.at(i).y) , 3, 3);
+                painter.drawEllipse(QPointF(points.at(i).x, points.at(i).y) , 3, 3);
                 painter.restore();
                 continue;
             }
-            painter.drawEllipse(QPointF(it.second.at(i).x, it.second.at(i).y) , 3, 3);
+            painter.drawEllipse(QPointF(points.at(i).x, points.at(i).y) , 3, 3);
         }
     }
     painter.end();
@@ -1186,17 +1195,11 @@ void VisualCurveWidget::drawLiner(QPainter &painter, std::string curve, SKeyPoin
     painter.drawLine(lastPoint.x, lastY, nextPoint.x, nextY);
 }
 
-void VisualCurveWidget::drawBezier(QPainter &painter, std::string curve, SKeyPoint lastPoint, SKeyPoint nextPoint, QPair<QPointF, QPointF> lastWorkerPoint, QPair<QPointF, QPointF> nextWorkerPoint) {
+void VisualCurveWidget::drawBezier(QPainter &painter, std::string curve, int index, SKeyPoint lastPoint, SKeyPoint nextPoint, QPair<QPointF, QPointF> lastWorkerPoint, QPair<QPointF, QPointF> nextWorkerPoint) {
     // beizer curve
     QPointF lastKey(lastPoint.x, lastPoint.y);
     QPointF nextKey(nextPoint.x, nextPoint.y);
 
-    int lastY = lastPoint.y;
-    int nextY = nextPoint.y;
-    if (lastY < *numHeight && nextY < *numHeight) {
-        return;
-    }
-
     // get worker point
     QPointF endWorkerPoint(lastWorkerPoint.second);
     QPointF startWorkerPoint(nextWorkerPoint.first);
@@ -1211,71 +1214,21 @@ void VisualCurveWidget::drawBezier(QPainter &painter, std::string curve, SKeyPoi
         startWorkerPoint.setY(y);
     }
 
-    QList<QPointF> srcPoints, destPoints;
-    srcPoints.push_back(lastKey);
-    srcPoints.push_back(endWorkerPoint);
-    srcPoints.push_back(startWorkerPoint);
-    srcPoints.push_back(nextKey);
-
-    // get bezier points
-    createNBezierCurve(srcPoints, destPoints, 0.001);
-
-    bool hasSecondCurve = false;
-    int beginIndex{0}, endIndex{destPoints.size() - 1};
-    for (auto i = 0; i < destPoints.size(); i++) {
-        if (destPoints.at(i).y() >= *numHeight) {
-            beginIndex = i;
-            break;
-        }
+    // the curve stays inside the hull of its control points
+    if (!isSegmentVisible({lastKey, endWorkerPoint, startWorkerPoint, nextKey})) {
+        return;
     }
 
     // paint bezier curve
     painter.setBrush(QBrush());
-    QPainterPath painterPath;
-    painterPath.moveTo(destPoints.at(beginIndex));
-    for (auto i = beginIndex; i < destPoints.size(); i++) {
-        if (destPoints.at(i).y() >= *numHeight) {
-            painterPath.lineTo(destPoints.at(i));
-        } else {
-            endIndex = i;
-            break;
-        }
-    }
-    painter.drawPath(painterPath);
-
-    // second curve
-    if (endIndex < destPoints.size()) {
-        for (auto i = endIndex; i < destPoints.size(); i++) {
-            if (destPoints.at(i).y() >= *numHeight) {
-                beginIndex = i;
-                hasSecondCurve = true;
-                break;
-            }
-        }
-        if (hasSecondCurve) {
-            QPainterPath painterPath2;
-            painterPath2.moveTo(destPoints.at(beginIndex));
-            for (auto i = beginIndex; i < destPoints.size(); i++) {
-                painterPath2.lineTo(destPoints.at(i));
-            }
-            painter.drawPath(painterPath2);
-        }
-    }
+    drawClippedPath(painter, segmentPath(curve, index, EInterPolationType::BESIER_SPLINE, lastKey, endWorkerPoint, startWorkerPoint, nextKey), lastKey);
 }
 
-void VisualCurveWidget::drawHermite(QPainter &painter, std::string curve, SKeyPoint lastPoint, SKeyPoint nextPoint, QPair<QPointF, QPointF> lastWorkerPoint, QPair<QPointF, QPointF> nextWorkerPoint) {
+void VisualCurveWidget::drawHermite(QPainter &painter, std::string curve, int index, SKeyPoint lastPoint, SKeyPoint nextPoint, QPair<QPointF, QPointF> lastWorkerPoint, QPair<QPointF, QPointF> nextWorkerPoint) {
     // hermite curve
     QPointF lastKey(lastPoint.x, lastPoint.y);
     QPointF nextKey(nextPoint.x, nextPoint.y);
 
-    int lastY = lastPoint.y;
-    int nextY = nextPoint.y;
-    if (lastY < *numHeight && nextY < *numHeight) {
-        return;
-    }
-
-    QPointF offsetKey(nextKey.x() - lastKey.x(), nextKey.y() - lastKey.y());
-
     QPointF endWorkerPoint(lastWorkerPoint.second);
     QPointF startWorkerPoint(nextWorkerPoint.first);
     double lastPointX = nextPoint.x - 3.0 * (nextPoint.x - lastPoint.x);
@@ -1292,62 +1245,87 @@ void VisualCurveWidget::drawHermite(QPainter &painter, std::string curve, SKeyPo
     }
 
     // tangency point
-    QPointF tangPoint1, tangPoint2;
-    tangPoint1.setX(endWorkerPoint.x() - lastKey.x());
-    tangPoint1.setY(endWorkerPoint.y() - lastKey.y());
-    tangPoint2.setX(startWorkerPoint.x() - nextKey.x());
-    tangPoint2.setY(startWorkerPoint.y() - nextKey.y());
-
-    QList<QPointF> srcPoints, destPoints;
-    srcPoints.push_back(lastKey);
-    srcPoints.push_back(nextKey);
-    srcPoints.push_back(tangPoint1);
-    srcPoints.push_back(tangPoint2);
-
-    // get hermite points
-    createHermiteCurve(srcPoints, destPoints, 0.001);
-
-    bool hasSecondCurve = false;
-    int beginIndex{0}, endIndex{destPoints.size() - 1};
-    for (auto i = 0; i < destPoints.size(); i++) {
-        if (destPoints.at(i).y() >= *numHeight) {
-            beginIndex = i;
-            break;
-        }
+    QPointF tangPoint1 = endWorkerPoint - lastKey;
+    QPointF tangPoint2 = startWorkerPoint - nextKey;
+
+    // the same cubic in bezier form, its control points are a third of the tangents away from the keys
+    QPointF firstControl = lastKey + tangPoint1 / 3.0;
+    QPointF secondControl = nextKey - tangPoint2 / 3.0;
+    if (!isSegmentVisible({lastKey, firstControl, secondControl, nextKey})) {
+        return;
     }
 
-    // paint bezier curve
+    // paint hermite curve
     painter.setBrush(QBrush());
-    QPainterPath painterPath;
-    painterPath.moveTo(destPoints.at(beginIndex));
-    for (auto i = beginIndex; i < destPoints.size(); i++) {
-        if (destPoints.at(i).y() >= *numHeight) {
-            painterPath.lineTo(destPoints.at(i));
-        } else {
-            endIndex = i;
-            break;
-        }
+    drawClippedPath(painter, segmentPath(curve, index, EInterPolationType::HERMIT_SPLINE, lastKey, firstControl, secondControl, nextKey), lastKey);
+}
+
+bool VisualCurveWidget::isSegmentVisible(std::initializer_list<QPointF> points) const {
+    double minX{std::numeric_limits<double>::max()}, maxX{std::numeric_limits<double>::lowest()};
+    double minY{std::numeric_limits<double>::max()}, maxY{std::numeric_limits<double>::lowest()};
+    for (const auto &point : points) {
+        minX = std::min(minX, point.x());
+        maxX = std::max(maxX, point.x());
+        minY = std::min(minY, point.y());
+        maxY = std::max(maxY, point.y());
     }
-    painter.drawPath(painterPath);
+    return maxX >= 0 && minX <= width() && maxY >= *numHeight && minY <= height();
+}
 
-    // second curve
-    if (endIndex < destPoints.size()) {
-        for (auto i = endIndex; i < destPoints.size(); i++) {
-            if (destPoints.at(i).y() >= *numHeight) {
-                beginIndex = i;
-                hasSecondCurve = true;
-                break;
-            }
+const QPolygonF &VisualCurveWidget::segmentPath(const std::string &curve, int index, int type, QPointF lastKey, QPointF firstControl, QPointF secondControl, QPointF nextKey) {
+    auto samePoint = [](QPointF left, QPointF right)->bool {
+        return std::abs(left.x() - right.x()) < 1e-3 && std::abs(left.y() - right.y()) < 1e-3;
+    };
+
+    auto &paths = segmentPathCache_[curve];
+    if (paths.size() <= static_cast<size_t>(index)) {
+        paths.resize(index + 1);
+    }
+    // relative to the first key, panning moves the keys but keeps the path
+    SegmentPath &path = paths[index];
+    QPointF control1 = firstControl - lastKey;
+    QPointF control2 = secondControl - lastKey;
+    QPointF next = nextKey - lastKey;
+    if (path.type == type && samePoint(path.firstControl, control1) && samePoint(path.secondControl, control2) && samePoint(path.nextKey, next)) {
+        return path.points;
+    }
+    path.type = type;
+    path.firstControl = control1;
+    path.secondControl = control2;
+    path.nextKey = next;
+
+    // about one sample every two pixels of the control polygon, at most the 1000 samples of the dense sampling
+    double length = calculateTrigLen(control1.x(), control1.y())
+        + calculateTrigLen(control2.x() - control1.x(), control2.y() - control1.y())
+        + calculateTrigLen(next.x() - control2.x(), next.y() - control2.y());
+    int count = qBound(4, qCeil(length / 2.0), 1000);
+    path.points.resize(count + 1);
+    for (int i{0}; i <= count; i++) {
+        double t = static_cast<double>(i) / count;
+        double u = 1.0 - t;
+        path.points[i] = 3.0 * u * u * t * control1 + 3.0 * u * t * t * control2 + t * t * t * next;
+    }
+    return path.points;
+}
+
+void VisualCurveWidget::drawClippedPath(QPainter &painter, const QPolygonF &points, QPointF offset) {
+    // the frame number bar covers the top of the widget, the path is split where it passes below the bar
+    QPainterPath painterPath;
+    bool inside{false};
+    for (const auto &point : points) {
+        QPointF pos = point + offset;
+        if (pos.y() < *numHeight) {
+            inside = false;
+            continue;
         }
-        if (hasSecondCurve) {
-            QPainterPath painterPath2;
-            painterPath2.moveTo(destPoints.at(beginIndex));
-            for (auto i = beginIndex; i < destPoints.size(); i++) {
-                painterPath2.lineTo(destPoints.at(i));
-            }
-            painter.drawPath(painterPath2);
+        if (inside) {
+            painterPath.lineTo(pos);
+        } else {
+            painterPath.moveTo(pos);
+            inside = true;
         }
     }
+    painter.drawPath(painterPath);
 }
 
 void VisualCurveWidget::drawStep(QPainter &painter, std::string curve, SKeyPoint lastPoint, SKeyPoint nextPoint) {
@@ -1576,69 +1554,55 @@ void VisualCurveWidget::updateCurvePoint() {
 
     for (const auto &curve : CurveManager::GetInstance().getCurveList()) {
         if (curve) {
-            std::list<Point*> pointList = curve->getPointList();
+            auto keyFrames = curve->getKeyFrames();
+            auto interPolationTypes = curve->getInterPolationTypes();
+            auto dataValues = curve->getDataValues();
+            auto leftKeyFrames = curve->getLeftKeyFrames();
+            auto leftDataValues = curve->getLeftDataValues();
+            auto rightKeyFrames = curve->getRightKeyFrames();
+            auto rightDataValues = curve->getRightDataValues();
             QList<SKeyPoint> srcPoints;
-            auto it = pointList.begin();
-            while (it != pointList.end()) {
-                int keyFrame = qRound((*it)->getKeyFrame() * curveScale);
-                int offsetFrame = keyFrame - (*it)->getKeyFrame();
+            srcPoints.reserve(keyFrames.size());
+            for (size_t index = 0; index < keyFrames.size(); index++) {
+                int keyFrame = qRound(keyFrames[index] * curveScale);
+                int offsetFrame = keyFrame - keyFrames[index];
+                EInterPolationType type = interPolationTypes[index];
                 QPointF pointF;
-                double value{0};
-                if ((*it)->getDataValue().type() == typeid(double)) {
-                    value = *(*it)->getDataValue()._Cast<double>();
-                }
+                double value = dataValues[index];
                 keyFrame2PointF(curX, curY, eachFrameWidth, eachValueWidth, keyFrame, value, pointF);
-                SKeyPoint keyPoint(pointF.x(), pointF.y(), (*it)->getInterPolationType(), keyFrame);
+                SKeyPoint keyPoint(pointF.x(), pointF.y(), type, keyFrame);
 
-                if ((*it)->getInterPolationType() == EInterPolationType::HERMIT_SPLINE || (*it)->getInterPolationType() == EInterPolationType::BESIER_SPLINE) {
+                if (type == EInterPolationType::HERMIT_SPLINE || type == EInterPolationType::BESIER_SPLINE) {
                     keyPoint.setHandleType(HANDLE_TYPE::HANDLE_VECTOR);
 
-                    double leftKeyFrame = (*it)->getLeftKeyFrame() + offsetFrame;
-                    double rightKeyFrame = (*it)->getRightKeyFrame() + offsetFrame;
+                    double leftKeyFrame = leftKeyFrames[index] + offsetFrame;
+                    double rightKeyFrame = rightKeyFrames[index] + offsetFrame;
 
                     if (leftKeyFrame != INT_MIN && rightKeyFrame != INT_MIN) {
-                        double leftData{0.0};
-                        double rightData{0.0};
-                        if ((*it)->getLeftData().type() == typeid(double)) {
-                            leftData = *(*it)->getLeftData()._Cast<double>();
-                        }
-                        if ((*it)->getRightData().type() == typeid(double)) {
-                            rightData = *(*it)->getRightData()._Cast<double>();
-                        }
-
                         QPointF leftPoint, rightPoint;
-                        keyFrame2PointF(curX, curY, eachFrameWidth, eachValueWidth, leftKeyFrame, leftData, leftPoint);
-                        keyFrame2PointF(curX, curY, eachFrameWidth, eachValueWidth, rightKeyFrame, rightData, rightPoint);
+                        keyFrame2PointF(curX, curY, eachFrameWidth, eachValueWidth, leftKeyFrame, leftDataValues[index], leftPoint);
+                        keyFrame2PointF(curX, curY, eachFrameWidth, eachValueWidth, rightKeyFrame, rightDataValues[index], rightPoint);
 
                         keyPoint.setLeftPoint(leftPoint);
                         keyPoint.setRightPoint(rightPoint);
                         srcPoints.append(keyPoint);
-                        it++;
                         continue;
                     }
-                } else if ((*it)->getInterPolationType() == LINER) {
-                    if (it != pointList.begin()) {
-                        auto itTemp = it;
-                        itTemp--;
-                        if ((*itTemp)->getInterPolationType() == HERMIT_SPLINE || (*itTemp)->getInterPolationType() == EInterPolationType::BESIER_SPLINE) {
-                            double leftKeyFrame = (*it)->getLeftKeyFrame() + offsetFrame;
-                            double rightKeyFrame = (*it)->getKeyFrame() + offsetFrame;
+                } else if (type == LINER) {
+                    if (index > 0) {
+                        EInterPolationType lastType = interPolationTypes[index - 1];
+                        if (lastType == HERMIT_SPLINE || lastType == EInterPolationType::BESIER_SPLINE) {
+                            double leftKeyFrame = leftKeyFrames[index] + offsetFrame;
+                            double rightKeyFrame = keyFrames[index] + offsetFrame;
 
                             if (leftKeyFrame != INT_MIN) {
-                                double leftData{0.0};
-                                double rightData = value;
-                                if ((*it)->getLeftData().type() == typeid(double)) {
-                                    leftData = *(*it)->getLeftData()._Cast<double>();
-                                }
-
                                 QPointF leftPoint, rightPoint;
-                                keyFrame2PointF(curX, curY, eachFrameWidth, eachValueWidth, leftKeyFrame, leftData, leftPoint);
-                                keyFrame2PointF(curX, curY, eachFrameWidth, eachValueWidth, rightKeyFrame, rightData, rightPoint);
+                                keyFrame2PointF(curX, curY, eachFrameWidth, eachValueWidth, leftKeyFrame, leftDataValues[index], leftPoint);
+                                keyFrame2PointF(curX, curY, eachFrameWidth, eachValueWidth, rightKeyFrame, value, rightPoint);
 
                                 keyPoint.setLeftPoint(leftPoint);
                                 keyPoint.setRightPoint(rightPoint);
                                 srcPoints.append(keyPoint);
-                                it++;
                                 continue;
                             }
                         }
@@ -1648,19 +1612,16 @@ void VisualCurveWidget::updateCurvePoint() {
                 int offsetLastKey{10};
                 int offsetNextKey{10};
 
-                int curKeyFrame = qRound((*it)->getKeyFrame() * curveScale);
-                if (it != pointList.begin()) {
-                    it--;
-                    int lastKey = qRound((*it)->getKeyFrame() * curveScale);
+                int curKeyFrame = keyFrame;
+                if (index > 0) {
+                    int lastKey = qRound(keyFrames[index - 1] * curveScale);
                     if (curKeyFrame - lastKey < 10) {
                         offsetLastKey = curKeyFrame - lastKey;
                         offsetLastKey = offsetLastKey == 0 ? 1 : offsetLastKey;
                     }
-                    it++;
                 }
-                it++;
-                if (it != pointList.end()) {
-                    int nextKey = qRound((*it)->getKeyFrame() * curveScale);
+                if (index + 1 < keyFrames.size()) {
+                    int nextKey = qRound(keyFrames[index + 1] * curveScale);
                     if (nextKey - curKeyFrame < 10) {
                         offsetNextKey = nextKey - curKeyFrame;
                         offsetNextKey = offsetNextKey == 0 ? 1 : offsetNextKey;
@@ -1697,20 +1658,18 @@ void VisualCurveWidget::reCaculateCurvePoint(int x, int y, double frameWidth, do
 
     for (const auto &curve : CurveManager::GetInstance().getCurveList()) {
         if (curve) {
-            std::list<Point*> pointList = curve->getPointList();
+            auto keyFrames = curve->getKeyFrames();
+            auto interPolationTypes = curve->getInterPolationTypes();
+            auto dataValues = curve->getDataValues();
             QList<SKeyPoint> srcPoints;
-            int index{0};
-            for (auto point : pointList) {
+            srcPoints.reserve(keyFrames.size());
+            for (size_t index = 0; index < keyFrames.size(); index++) {
                 QPointF pointF;
-                double value{0};
-                if (point->getDataValue().type() == typeid(double)) {
-                    value = *point->getDataValue()._Cast<double>();
-                }
-                keyFrame2PointF(curX, curY, eachFrameWidth, eachValueWidth, point->getKeyFrame(), value, pointF);
-                SKeyPoint newKeyPoint(pointF.x(), pointF.y(), point->getInterPolationType(), point->getKeyFrame());
+                keyFrame2PointF(curX, curY, eachFrameWidth, eachValueWidth, keyFrames[index], dataValues[index], pointF);
+                SKeyPoint newKeyPoint(pointF.x(), pointF.y(), interPolationTypes[index], keyFrames[index]);
 
                 SKeyPoint oldKeyPoint;
-                if (searchKeyPoint(oldKeyPoint, curve->getCurveName(), point->getKeyFrame())) {
+                if (searchKeyPoint(oldKeyPoint, curve->getCurveName(), keyFrames[index])) {
                     int offsetX = pointF.x() - oldKeyPoint.x;
                     int offsetY = pointF.y() - oldKeyPoint.y;
 
@@ -1726,7 +1685,6 @@ void VisualCurveWidget::reCaculateCurvePoint(int x, int y, double frameWidth, do
                     newKeyPoint.setHandleType(oldKeyPoint.handleType_);
                 }
                 srcPoints.append(newKeyPoint);
-                index++;
             }
             tempKeyFrameMap.insert(curve->getCurveName(), srcPoints);
         }
@@ -1951,7 +1909,7 @@ void VisualCurveWidget::pointMove(QMouseEvent *event) {
             break;
         }
         Q_EMIT sigUpdateSelKey();
-        Q_EMIT signalProxy::GetInstance().sigUpdateKeyFram_From_AnimationLogic(VisualCurvePosManager::GetInstance().getCurFrame());
+        Q_EMIT signalProxy::GetInstance().sigUpdateCurveKeyFrame_From_CurveUI(VisualCurvePosManager::GetInstance().getCurrentPointInfo().first, VisualCurvePosManager::GetInstance().getCurFrame());
     } else {
         isPressDragBtn_ = false;
         pressDragBtnMutex_.unlock();
@@ -2974,7 +2932,7 @@ void VisualCurveWidget::updateLeftWorkerPoint(SKeyPoint keyPoint, QPointF leftPo
 
 void VisualCurveWidget::pushState2UndoStack(std::string description) {
     raco::core::UndoState undoState;
-    undoState.saveCurrentUndoState();
+    undoState.saveCurrentUndoState(commandInterface_->undoStack().currentUndoState());
     commandInterface_->undoStack().push(description, undoState);
 }
 